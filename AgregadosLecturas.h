@@ -0,0 +1,149 @@
+/**
+ * @file AgregadosLecturas.h
+ * @brief Agregados incrementales (suma, cuenta, suma de cuadrados) de lecturas
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef AGREGADOSLECTURAS_H
+#define AGREGADOSLECTURAS_H
+
+#include <cmath>
+#include <cstdint>
+#include "KernelsLecturas.h"
+
+/**
+ * @class AgregadosLecturas
+ * @brief Mantiene suma, cuenta y suma de cuadrados al insertar y eliminar
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Las listas lo actualizan en cada inserción y eliminación, de modo que
+ * promedio, varianza y desviación estándar son consultas O(1).
+ */
+template <typename T>
+class AgregadosLecturas {
+public:
+    typedef typename AcumuladorAncho<T>::tipo Acumulador;  ///< Tipo de la suma
+
+private:
+    Acumulador suma;        ///< Suma de las lecturas
+    double sumaCuadrados;   ///< Suma de los cuadrados de las lecturas
+    int64_t cuenta;         ///< Número de lecturas
+
+public:
+    AgregadosLecturas() : suma(0), sumaCuadrados(0.0), cuenta(0) {}
+
+    /**
+     * @brief Constructor con agregados ya calculados (al restaurar de disco)
+     */
+    AgregadosLecturas(Acumulador suma, double sumaCuadrados, int64_t cuenta)
+        : suma(suma), sumaCuadrados(sumaCuadrados), cuenta(cuenta) {}
+
+    /**
+     * @brief Incorpora una lectura
+     * @param valor Lectura agregada
+     */
+    void agregar(T valor) {
+        suma += static_cast<Acumulador>(valor);
+        sumaCuadrados += static_cast<double>(valor) * static_cast<double>(valor);
+        cuenta++;
+    }
+
+    /**
+     * @brief Incorpora n lecturas contiguas
+     * @param valores Arreglo de lecturas
+     * @param n Número de lecturas
+     *
+     * Suma y suma de cuadrados salen de KernelsLecturas (SIMD para float
+     * e int) en lugar de un agregar() por lectura.
+     */
+    void agregarTramo(const T* valores, int n) {
+        suma += KernelsLecturas::sumar(valores, n);
+        sumaCuadrados += KernelsLecturas::sumarCuadrados(valores, n);
+        cuenta += n;
+    }
+
+    /**
+     * @brief Retira una lectura previamente agregada
+     * @param valor Lectura eliminada
+     */
+    void quitar(T valor) {
+        suma -= static_cast<Acumulador>(valor);
+        sumaCuadrados -= static_cast<double>(valor) * static_cast<double>(valor);
+        cuenta--;
+    }
+
+    /**
+     * @brief Incorpora todas las lecturas de otros agregados
+     * @param otros Agregados de otro conjunto de lecturas
+     */
+    void combinar(const AgregadosLecturas& otros) {
+        suma += otros.suma;
+        sumaCuadrados += otros.sumaCuadrados;
+        cuenta += otros.cuenta;
+    }
+
+    /**
+     * @brief Vuelve a cero todos los agregados
+     */
+    void reiniciar() {
+        suma = 0;
+        sumaCuadrados = 0.0;
+        cuenta = 0;
+    }
+
+    /**
+     * @brief Obtiene la suma acumulada
+     * @return Suma de las lecturas
+     */
+    Acumulador obtenerSuma() const { return suma; }
+
+    /**
+     * @brief Obtiene la suma de los cuadrados
+     * @return Suma de los cuadrados de las lecturas
+     */
+    double obtenerSumaCuadrados() const { return sumaCuadrados; }
+
+    /**
+     * @brief Obtiene el número de lecturas
+     * @return Número de lecturas
+     */
+    int64_t obtenerCuenta() const { return cuenta; }
+
+    /**
+     * @brief Promedio en el tipo de las lecturas
+     * @return suma / cuenta convertido a T (0 si no hay lecturas)
+     *
+     * Para enteros conserva la división entera de la versión original.
+     */
+    T promedio() const {
+        if (cuenta == 0) {
+            return T(0);
+        }
+        return static_cast<T>(suma / static_cast<Acumulador>(cuenta));
+    }
+
+    /**
+     * @brief Varianza poblacional de las lecturas
+     * @return Varianza (0 si hay menos de dos lecturas)
+     */
+    double varianza() const {
+        if (cuenta < 2) {
+            return 0.0;
+        }
+        double n = static_cast<double>(cuenta);
+        double media = static_cast<double>(suma) / n;
+        double v = sumaCuadrados / n - media * media;
+        return v > 0.0 ? v : 0.0;  // Evita negativos por redondeo
+    }
+
+    /**
+     * @brief Desviación estándar poblacional
+     * @return Raíz cuadrada de la varianza
+     */
+    double desviacionEstandar() const {
+        return std::sqrt(varianza());
+    }
+};
+
+#endif // AGREGADOSLECTURAS_H
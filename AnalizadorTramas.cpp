@@ -0,0 +1,257 @@
+/**
+ * @file AnalizadorTramas.cpp
+ * @brief Implementación del analizador incremental de tramas
+ */
+
+#include "AnalizadorTramas.h"
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+/// Potencias de 10 exactas en double (10^22 es la mayor representable sin error)
+const double POTENCIAS_DIEZ[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int MAXIMA_POTENCIA_EXACTA = 22;
+const uint64_t MAXIMA_MANTISA_EXACTA = 1ULL << 53;  ///< Enteros exactos en double
+const int MAXIMOS_DIGITOS = 19;  ///< Dígitos que caben en uint64_t sin desbordar
+
+inline bool esDigito(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool esEspacio(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+} // namespace
+
+AnalizadorTramas::AnalizadorTramas()
+    : entrada(nullptr), finEntrada(nullptr), usados(0), descartando(false),
+      tramasValidas(0), lineasIgnoradas(0), lineasDescartadas(0) {
+}
+
+void AnalizadorTramas::alimentar(const char* datos, size_t longitud) {
+    entrada = datos;
+    finEntrada = datos + longitud;
+}
+
+bool AnalizadorTramas::siguiente(LecturaTrama& lectura) {
+    while (entrada < finEntrada) {
+        const char* salto = static_cast<const char*>(
+            memchr(entrada, '\n', static_cast<size_t>(finEntrada - entrada)));
+
+        if (salto == nullptr) {
+            // Trama partida: se guarda el fragmento hasta el próximo bloque
+            int longitud = static_cast<int>(finEntrada - entrada);
+            if (!descartando) {
+                if (usados + longitud > CAPACIDAD_TRAMA) {
+                    usados = 0;
+                    descartando = true;
+                    lineasDescartadas++;
+                } else {
+                    memcpy(pendiente + usados, entrada, static_cast<size_t>(longitud));
+                    usados += longitud;
+                }
+            }
+            entrada = finEntrada;
+            return false;
+        }
+
+        const char* inicio = entrada;
+        const char* fin = salto;
+        entrada = salto + 1;
+
+        if (descartando) {
+            descartando = false;  // Termina la línea demasiado larga
+            continue;
+        }
+
+        if (usados > 0) {
+            // Completa la trama empezada en un bloque anterior
+            int longitud = static_cast<int>(fin - inicio);
+            if (usados + longitud > CAPACIDAD_TRAMA) {
+                usados = 0;
+                lineasDescartadas++;
+                continue;
+            }
+            memcpy(pendiente + usados, inicio, static_cast<size_t>(longitud));
+            inicio = pendiente;
+            fin = pendiente + usados + longitud;
+            usados = 0;
+        }
+
+        if (interpretarLinea(inicio, fin, lectura)) {
+            tramasValidas++;
+            return true;
+        }
+        lineasIgnoradas++;
+    }
+    return false;
+}
+
+void AnalizadorTramas::reiniciar() {
+    entrada = finEntrada = nullptr;
+    usados = 0;
+    descartando = false;
+}
+
+unsigned long AnalizadorTramas::obtenerTramasValidas() const {
+    return tramasValidas;
+}
+
+unsigned long AnalizadorTramas::obtenerLineasIgnoradas() const {
+    return lineasIgnoradas;
+}
+
+unsigned long AnalizadorTramas::obtenerLineasDescartadas() const {
+    return lineasDescartadas;
+}
+
+bool AnalizadorTramas::interpretarLinea(const char* inicio, const char* fin,
+                                        LecturaTrama& lectura) {
+    // Quita el '\r' de Serial.println y espacios finales
+    while (fin > inicio && esEspacio(fin[-1])) {
+        fin--;
+    }
+    if (fin - inicio < 3 || inicio[1] != ':') {
+        return false;
+    }
+
+    char tipo = inicio[0];
+    if (tipo >= 'a' && tipo <= 'z') {
+        tipo = static_cast<char>(tipo - 'a' + 'A');
+    }
+    if (tipo < 'A' || tipo > 'Z') {
+        return false;
+    }
+
+    // El valor debe ocupar el resto de la línea ("T:25.4x" no es trama)
+    if (convertirNumero(inicio + 2, fin, lectura.real, lectura.entero) != fin) {
+        return false;
+    }
+    lectura.tipo = tipo;
+    return true;
+}
+
+const char* AnalizadorTramas::convertirNumero(const char* inicio, const char* fin,
+                                              float& real, int& entero) {
+    real = 0.0f;
+    entero = 0;
+
+    const char* p = inicio;
+    while (p < fin && esEspacio(*p)) {
+        p++;
+    }
+
+    bool negativo = false;
+    if (p < fin && (*p == '+' || *p == '-')) {
+        negativo = *p == '-';
+        p++;
+    }
+
+    // Mantisa decimal: hasta 19 dígitos significativos en uint64_t
+    uint64_t mantisa = 0;
+    int digitos = 0;
+    int exponente = 0;
+    int64_t parteEntera = 0;
+    bool hayDigitos = false;
+
+    while (p < fin && esDigito(*p)) {
+        int d = *p - '0';
+        if (digitos < MAXIMOS_DIGITOS) {
+            mantisa = mantisa * 10 + static_cast<uint64_t>(d);
+            if (mantisa != 0) {
+                digitos++;
+            }
+        } else {
+            exponente++;  // Dígito entero que no cabe: solo escala
+        }
+        if (parteEntera <= INT_MAX) {
+            parteEntera = parteEntera * 10 + d;
+        }
+        hayDigitos = true;
+        p++;
+    }
+
+    if (p < fin && *p == '.') {
+        const char* decimales = p + 1;
+        const char* q = decimales;
+        while (q < fin && esDigito(*q)) {
+            if (digitos < MAXIMOS_DIGITOS) {
+                mantisa = mantisa * 10 + static_cast<uint64_t>(*q - '0');
+                if (mantisa != 0) {
+                    digitos++;
+                }
+                exponente--;
+            }
+            q++;
+        }
+        if (hayDigitos || q > decimales) {
+            hayDigitos = true;
+            p = q;
+        }
+    }
+
+    if (!hayDigitos) {
+        return inicio;
+    }
+
+    // Exponente opcional; "1e" o "1e+" dejan el número en "1"
+    if (p < fin && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool exponenteNegativo = false;
+        if (q < fin && (*q == '+' || *q == '-')) {
+            exponenteNegativo = *q == '-';
+            q++;
+        }
+        if (q < fin && esDigito(*q)) {
+            int valorExponente = 0;
+            while (q < fin && esDigito(*q)) {
+                if (valorExponente < 10000) {
+                    valorExponente = valorExponente * 10 + (*q - '0');
+                }
+                q++;
+            }
+            exponente += exponenteNegativo ? -valorExponente : valorExponente;
+            p = q;
+        }
+    }
+
+    // Camino rápido: mantisa y potencia exactas en double dan un único redondeo
+    double valor;
+    if (mantisa == 0) {
+        valor = 0.0;
+    } else if (mantisa <= MAXIMA_MANTISA_EXACTA
+               && exponente >= -MAXIMA_POTENCIA_EXACTA && exponente <= MAXIMA_POTENCIA_EXACTA) {
+        valor = exponente < 0
+            ? static_cast<double>(mantisa) / POTENCIAS_DIEZ[-exponente]
+            : static_cast<double>(mantisa) * POTENCIAS_DIEZ[exponente];
+    } else {
+        valor = static_cast<double>(mantisa) * std::pow(10.0, exponente);
+    }
+    real = static_cast<float>(negativo ? -valor : valor);
+
+    if (negativo) {
+        entero = parteEntera > static_cast<int64_t>(INT_MAX) + 1
+            ? INT_MIN : static_cast<int>(-parteEntera);
+    } else {
+        entero = parteEntera > INT_MAX ? INT_MAX : static_cast<int>(parteEntera);
+    }
+    return p;
+}
+
+const char* AnalizadorTramas::convertirReal(const char* inicio, const char* fin, float& valor) {
+    int entero;
+    return convertirNumero(inicio, fin, valor, entero);
+}
+
+const char* AnalizadorTramas::convertirEntero(const char* inicio, const char* fin, int& valor) {
+    float real;
+    return convertirNumero(inicio, fin, real, valor);
+}
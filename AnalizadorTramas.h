@@ -0,0 +1,150 @@
+/**
+ * @file AnalizadorTramas.h
+ * @brief Analizador incremental de tramas "TIPO:VALOR\n" sin reservas de memoria
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef ANALIZADORTRAMAS_H
+#define ANALIZADORTRAMAS_H
+
+#include <cstddef>
+
+/**
+ * @brief Lectura tipada extraída de una trama
+ *
+ * El valor se convierte una sola vez y se guarda en las dos formas que
+ * usan los sensores: real (temperatura) y entero truncado (presión,
+ * vibración), igual que atof/atoi sobre el mismo texto.
+ */
+struct LecturaTrama {
+    char tipo;    ///< Letra de tipo en mayúscula ('T', 'P', 'V', ...)
+    float real;   ///< Valor como número real
+    int entero;   ///< Parte entera del valor (truncada, como atoi)
+
+    LecturaTrama() : tipo('\0'), real(0.0f), entero(0) {}
+};
+
+/**
+ * @class AnalizadorTramas
+ * @brief Extrae lecturas de un flujo de bytes crudo del puerto serial
+ *
+ * Se alimenta con lo que devuelva cada read() del puerto, sin importar
+ * dónde corten los bytes, y entrega las tramas completas ya convertidas:
+ *
+ *     analizador.alimentar(bytes, n);
+ *     while (analizador.siguiente(lectura)) { ... }
+ *
+ * Las tramas que caen enteras dentro de un bloque se interpretan en el
+ * propio buffer de entrada, sin copias. Solo el fragmento final sin '\n'
+ * se guarda en un buffer interno fijo hasta la siguiente lectura. Las
+ * líneas que no son tramas (encabezados, "OK:...") se cuentan y se saltan;
+ * las que exceden CAPACIDAD_TRAMA se descartan hasta el siguiente '\n'.
+ *
+ * La conversión numérica no depende del locale ni reserva memoria, al
+ * estilo de std::from_chars (no disponible en C++11).
+ */
+class AnalizadorTramas {
+public:
+    static const int CAPACIDAD_TRAMA = 64;  ///< Bytes máximos de una trama partida
+
+private:
+    const char* entrada;      ///< Próximo byte sin analizar del bloque actual
+    const char* finEntrada;   ///< Fin del bloque actual
+    char pendiente[CAPACIDAD_TRAMA];  ///< Trama empezada en un bloque anterior
+    int usados;               ///< Bytes válidos en pendiente
+    bool descartando;         ///< Saltando una línea demasiado larga
+    unsigned long tramasValidas;      ///< Tramas entregadas
+    unsigned long lineasIgnoradas;    ///< Líneas que no eran tramas
+    unsigned long lineasDescartadas;  ///< Líneas demasiado largas
+
+    /**
+     * @brief Interpreta una línea completa (sin '\n') como trama
+     * @param inicio Primer byte de la línea
+     * @param fin Fin de la línea
+     * @param lectura Destino de la lectura
+     * @return true si la línea tiene el formato "L:número"
+     */
+    static bool interpretarLinea(const char* inicio, const char* fin, LecturaTrama& lectura);
+
+    /**
+     * @brief Convierte un número decimal en sus formas real y entera
+     * @return Puntero tras el último carácter convertido (inicio si no hay número)
+     */
+    static const char* convertirNumero(const char* inicio, const char* fin,
+                                       float& real, int& entero);
+
+public:
+    /**
+     * @brief Constructor (sin datos pendientes)
+     */
+    AnalizadorTramas();
+
+    /**
+     * @brief Entrega un nuevo bloque de bytes al analizador
+     * @param datos Bytes recibidos (no se copian)
+     * @param longitud Número de bytes
+     *
+     * El bloque debe seguir siendo válido hasta que siguiente() devuelva
+     * false; solo entonces puede reutilizarse el buffer para otra lectura.
+     */
+    void alimentar(const char* datos, size_t longitud);
+
+    /**
+     * @brief Obtiene la siguiente trama completa del bloque actual
+     * @param lectura Destino de la lectura
+     * @return true si se extrajo una trama; false si hay que alimentar más bytes
+     */
+    bool siguiente(LecturaTrama& lectura);
+
+    /**
+     * @brief Descarta el bloque actual y cualquier trama a medias
+     */
+    void reiniciar();
+
+    /**
+     * @brief Obtiene el número de tramas entregadas
+     * @return Contador de tramas válidas
+     */
+    unsigned long obtenerTramasValidas() const;
+
+    /**
+     * @brief Obtiene el número de líneas que no eran tramas
+     * @return Contador de líneas ignoradas
+     */
+    unsigned long obtenerLineasIgnoradas() const;
+
+    /**
+     * @brief Obtiene el número de líneas descartadas por exceso de longitud
+     * @return Contador de líneas descartadas
+     */
+    unsigned long obtenerLineasDescartadas() const;
+
+    /**
+     * @brief Convierte texto a float sin depender del locale
+     * @param inicio Primer carácter (se saltan espacios iniciales)
+     * @param fin Fin del texto
+     * @param valor Resultado (0 si no hay número)
+     * @return Puntero tras el número, o inicio si no había ninguno
+     *
+     * Acepta signo, parte entera, parte decimal y exponente ("-1.5e3").
+     */
+    static const char* convertirReal(const char* inicio, const char* fin, float& valor);
+
+    /**
+     * @brief Convierte texto a int sin depender del locale
+     * @param inicio Primer carácter (se saltan espacios iniciales)
+     * @param fin Fin del texto
+     * @param valor Resultado truncado y saturado al rango de int
+     * @return Puntero tras el número, o inicio si no había ninguno
+     *
+     * Igual que atoi, "25.7" produce 25.
+     */
+    static const char* convertirEntero(const char* inicio, const char* fin, int& valor);
+
+private:
+    AnalizadorTramas(const AnalizadorTramas&);
+    AnalizadorTramas& operator=(const AnalizadorTramas&);
+};
+
+#endif // ANALIZADORTRAMAS_H
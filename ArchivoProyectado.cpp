@@ -0,0 +1,84 @@
+/**
+ * @file ArchivoProyectado.cpp
+ * @brief Implementación de la proyección de archivos en memoria
+ */
+
+#include "ArchivoProyectado.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+ArchivoProyectado::ArchivoProyectado() : datos(nullptr), longitud(0), proyectado(false) {
+}
+
+ArchivoProyectado::~ArchivoProyectado() {
+    cerrar();
+}
+
+ArchivoProyectado::Estado ArchivoProyectado::abrir(const char* ruta) {
+    cerrar();
+#ifndef _WIN32
+    int descriptor = open(ruta, O_RDONLY);
+    if (descriptor < 0) {
+        return NO_EXISTE;
+    }
+    struct stat estado;
+    if (fstat(descriptor, &estado) != 0) {
+        close(descriptor);
+        return ERROR;
+    }
+    longitud = static_cast<size_t>(estado.st_size);
+    if (longitud > 0) {
+        void* proyeccion = mmap(nullptr, longitud, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (proyeccion == MAP_FAILED) {
+            close(descriptor);
+            longitud = 0;
+            return ERROR;
+        }
+        madvise(proyeccion, longitud, MADV_SEQUENTIAL);
+        datos = static_cast<const char*>(proyeccion);
+        proyectado = true;
+    }
+    close(descriptor);
+#else
+    std::ifstream entrada(ruta, std::ios::binary | std::ios::ate);
+    if (!entrada) {
+        return NO_EXISTE;
+    }
+    longitud = static_cast<size_t>(entrada.tellg());
+    if (longitud > 0) {
+        char* copia = new char[longitud];
+        entrada.seekg(0);
+        entrada.read(copia, longitud);
+        if (!entrada) {
+            delete[] copia;
+            longitud = 0;
+            return ERROR;
+        }
+        datos = copia;
+    }
+#endif
+    return ABIERTO;
+}
+
+void ArchivoProyectado::cerrar() {
+    if (datos != nullptr) {
+#ifndef _WIN32
+        if (proyectado) {
+            munmap(const_cast<char*>(datos), longitud);
+        }
+#endif
+        if (!proyectado) {
+            delete[] datos;
+        }
+    }
+    datos = nullptr;
+    longitud = 0;
+    proyectado = false;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ArchivoProyectado.h
+ * @brief Archivo de solo lectura proyectado en memoria (mmap)
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef ARCHIVOPROYECTADO_H
+#define ARCHIVOPROYECTADO_H
+
+#include <cstddef>
+
+/**
+ * @class ArchivoProyectado
+ * @brief Da acceso a todo el contenido de un archivo como un arreglo de bytes
+ *
+ * En POSIX proyecta el archivo con mmap (lectura secuencial anunciada con
+ * madvise), de modo que se lee directamente de la caché de páginas sin
+ * copiarlo. En Windows lo lee entero en memoria. La proyección se libera
+ * con el objeto.
+ */
+class ArchivoProyectado {
+private:
+    const char* datos;   ///< Contenido (nullptr si no se abrió o está vacío)
+    size_t longitud;     ///< Bytes del archivo
+    bool proyectado;     ///< true si datos viene de mmap, false si de new[]
+
+public:
+    /**
+     * @brief Resultado de abrir()
+     */
+    enum Estado {
+        ABIERTO   = 0,  ///< Contenido disponible (puede estar vacío)
+        NO_EXISTE = 1,  ///< No hay archivo en la ruta
+        ERROR     = 2   ///< Existe pero no se pudo leer
+    };
+
+    ArchivoProyectado();
+
+    /**
+     * @brief Destructor - Libera la proyección
+     */
+    ~ArchivoProyectado();
+
+    /**
+     * @brief Proyecta el archivo indicado (libera el anterior, si lo hay)
+     * @param ruta Archivo a leer
+     */
+    Estado abrir(const char* ruta);
+
+    /**
+     * @brief Libera la proyección
+     */
+    void cerrar();
+
+    const char* obtenerDatos() const { return datos; }
+    size_t obtenerLongitud() const { return longitud; }
+
+    ArchivoProyectado(const ArchivoProyectado&) = delete;
+    ArchivoProyectado& operator=(const ArchivoProyectado&) = delete;
+};
+
+#endif // ARCHIVOPROYECTADO_H
@@ -4,32 +4,43 @@
  */
 
 #include "ArduinoSimulador.h"
+#include "Log.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
-#include <cstring>
 #include <cstdio>
+#include <iomanip>
 
 ArduinoSimulador::ArduinoSimulador() 
-    : conectado(false), contadorLecturas(0) {
+    : conectado(false), contadorLecturas(0), modoReal(false), hayLecturaAdelantada(false) {
     // Inicializa el generador de números aleatorios
     srand(static_cast<unsigned int>(time(nullptr)));
 }
 
-bool ArduinoSimulador::conectar(const char* puerto) {
-    std::cout << "\n[Arduino] Intentando conectar al puerto: " << puerto << "...\n";
-    std::cout << "[Arduino] Configurando baudrate: 9600...\n";
-    std::cout << "[Arduino] Estableciendo timeout: 1000ms...\n";
-    
-    // Simulamos un delay de conexión
-    for (int i = 0; i < 3; i++) {
-        std::cout << "." << std::flush;
+bool ArduinoSimulador::conectar(const char* puerto, int baudios) {
+    std::cout << "\n[Arduino] Intentando conectar al puerto: "
+              << (puerto != nullptr ? puerto : "(ninguno)") << "...\n";
+    std::cout << "[Arduino] Configurando baudrate: " << baudios << "...\n";
+    std::cout << "[Arduino] Estableciendo timeout: " << ESPERA_MS << "ms...\n";
+
+    // Una velocidad mal escrita no debe acabar en datos simulados sin aviso
+    if (puerto != nullptr && !PuertoSerial::velocidadSoportada(baudios)) {
+        std::cout << "[Arduino] ✗ Velocidad no soportada: " << baudios
+                  << " baudios (use 9600, 19200, 38400, 57600 o 115200).\n\n";
+        return false;
     }
-    std::cout << "\n";
     
+    modoReal = puerto != nullptr && this->puerto.abrir(puerto, baudios);
+    analizador.reiniciar();
+    hayLecturaAdelantada = false;
     conectado = true;
-    std::cout << "[Arduino] ✓ Conexión establecida exitosamente!\n";
-    std::cout << "[Arduino] Dispositivo listo para enviar datos.\n\n";
+
+    if (modoReal) {
+        std::cout << "[Arduino] ✓ Conexión establecida exitosamente!\n";
+        std::cout << "[Arduino] Dispositivo listo para enviar datos.\n\n";
+    } else {
+        std::cout << "[Arduino] ⚠ Puerto no disponible: se usarán datos simulados.\n\n";
+    }
     
     return true;
 }
@@ -37,21 +48,80 @@ bool ArduinoSimulador::conectar(const char* puerto) {
 void ArduinoSimulador::desconectar() {
     if (conectado) {
         std::cout << "\n[Arduino] Cerrando conexión serial...\n";
+        puerto.cerrar();
+        analizador.reiniciar();
+        hayLecturaAdelantada = false;
+        modoReal = false;
         conectado = false;
         std::cout << "[Arduino] Desconectado.\n";
     }
 }
 
 bool ArduinoSimulador::hayDatosDisponibles() {
-    // En un sistema real, verificaríamos el buffer serial
-    // Simulamos que siempre hay datos disponibles cuando está conectado
+    if (modoReal) {
+        if (hayLecturaAdelantada) {
+            return true;
+        }
+        // Extrae la trama ahora (sin esperar) y la guarda para la próxima lectura
+        hayLecturaAdelantada = siguienteTramaReal(lecturaAdelantada, 0);
+        return hayLecturaAdelantada;
+    }
+    // En simulación siempre hay datos disponibles cuando está conectado
     return conectado;
 }
 
+bool ArduinoSimulador::siguienteTramaReal(LecturaTrama& lectura, int esperaMs) {
+    if (hayLecturaAdelantada) {
+        lectura = lecturaAdelantada;
+        hayLecturaAdelantada = false;
+        return true;
+    }
+
+    // El analizador agota el bloque anterior antes de pedir otro al puerto
+    while (!analizador.siguiente(lectura)) {
+        int leidos = puerto.leer(recibidos, TAMANO_LECTURA, esperaMs);
+        if (leidos < 0) {
+            LOG_AVISO("[Arduino] El puerto serial se cerró.\n");
+            puerto.cerrar();
+            analizador.reiniciar();
+            modoReal = false;
+            conectado = false;
+            return false;
+        }
+        if (leidos == 0) {
+            return false;  // Sin tramas dentro del tiempo de espera
+        }
+        analizador.alimentar(recibidos, static_cast<size_t>(leidos));
+    }
+    return true;
+}
+
+bool ArduinoSimulador::leerTramaReal(LecturaTrama& lectura, char tipo) {
+    char buscado = (tipo >= 'a' && tipo <= 'z') ? static_cast<char>(tipo - 'a' + 'A') : tipo;
+
+    // Se descartan tramas hasta dar con una del tipo pedido
+    for (int intentos = 0; intentos < 32; intentos++) {
+        if (!siguienteTramaReal(lectura, ESPERA_MS)) {
+            return false;
+        }
+        if (buscado == TIPO_CUALQUIERA || lectura.tipo == buscado) {
+            contadorLecturas++;
+            return true;
+        }
+        LOG_TRAZA("[Arduino] Trama de tipo " << lectura.tipo << " ignorada.\n");
+    }
+    return false;
+}
+
 float ArduinoSimulador::leerTemperatura() {
     if (!conectado) {
         return 0.0f;
     }
+
+    if (modoReal) {
+        LecturaTrama lectura;
+        return leerTramaReal(lectura, 'T') ? lectura.real : 0.0f;
+    }
     
     // Simula lecturas de temperatura entre 15°C y 35°C
     float temperatura = 15.0f + (rand() % 2001) / 100.0f;  // 15.0 a 35.0
@@ -64,6 +134,11 @@ int ArduinoSimulador::leerPresion() {
     if (!conectado) {
         return 0;
     }
+
+    if (modoReal) {
+        LecturaTrama lectura;
+        return leerTramaReal(lectura, 'P') ? lectura.entero : 0;
+    }
     
     // Simula lecturas de presión entre 95 kPa y 105 kPa
     int presion = 95 + (rand() % 11);  // 95 a 105
@@ -76,6 +151,11 @@ int ArduinoSimulador::leerVibracion() {
     if (!conectado) {
         return 0;
     }
+
+    if (modoReal) {
+        LecturaTrama lectura;
+        return leerTramaReal(lectura, 'V') ? lectura.entero : 0;
+    }
     
     // Simula lecturas de vibración entre 0 y 100
     int vibracion = rand() % 101;  // 0 a 100
@@ -88,37 +168,71 @@ bool ArduinoSimulador::estaConectado() const {
     return conectado;
 }
 
-bool ArduinoSimulador::recibirPaquete(char* buffer, char tipo) {
+bool ArduinoSimulador::esModoReal() const {
+    return modoReal;
+}
+
+bool ArduinoSimulador::recibirLectura(char tipo, LecturaTrama& lectura) {
     if (!conectado) {
         return false;
     }
-    
-    // Simula recepción de un paquete de datos
-    switch (tipo) {
-        case 'T':
-        case 't': {
-            float temp = leerTemperatura();
-            sprintf(buffer, "T:%.2f", temp);
-            std::cout << "[Arduino→PC] Paquete recibido: " << buffer << "\n";
-            break;
+
+    if (modoReal) {
+        if (!leerTramaReal(lectura, tipo)) {
+            return false;
         }
-        case 'P':
-        case 'p': {
-            int pres = leerPresion();
-            sprintf(buffer, "P:%d", pres);
-            std::cout << "[Arduino→PC] Paquete recibido: " << buffer << "\n";
-            break;
+    } else {
+        // Sin filtro de tipo, el simulador alterna sensores como un Arduino real
+        if (tipo == TIPO_CUALQUIERA) {
+            static const char TIPOS_SIMULADOS[] = { 'T', 'P', 'V' };
+            tipo = TIPOS_SIMULADOS[rand() % 3];
         }
-        case 'V':
-        case 'v': {
-            int vib = leerVibracion();
-            sprintf(buffer, "V:%d", vib);
-            std::cout << "[Arduino→PC] Paquete recibido: " << buffer << "\n";
-            break;
+
+        // Simula la lectura directamente en su tipo, sin pasar por texto
+        switch (tipo) {
+            case 'T':
+            case 't':
+                lectura.tipo = 'T';
+                lectura.real = leerTemperatura();
+                lectura.entero = static_cast<int>(lectura.real);
+                break;
+            case 'P':
+            case 'p':
+                lectura.tipo = 'P';
+                lectura.entero = leerPresion();
+                lectura.real = static_cast<float>(lectura.entero);
+                break;
+            case 'V':
+            case 'v':
+                lectura.tipo = 'V';
+                lectura.entero = leerVibracion();
+                lectura.real = static_cast<float>(lectura.entero);
+                break;
+            default:
+                return false;
         }
-        default:
-            return false;
     }
-    
+
+    if (lectura.tipo == 'T') {
+        LOG_TRAZA("[Arduino→PC] Paquete recibido: T:"
+                  << std::fixed << std::setprecision(2) << lectura.real << "\n");
+    } else {
+        LOG_TRAZA("[Arduino→PC] Paquete recibido: " << lectura.tipo << ":"
+                  << lectura.entero << "\n");
+    }
+    return true;
+}
+
+bool ArduinoSimulador::recibirPaquete(char* buffer, char tipo) {
+    LecturaTrama lectura;
+    if (!recibirLectura(tipo, lectura)) {
+        return false;
+    }
+
+    if (lectura.tipo == 'T') {
+        snprintf(buffer, TAMANO_PAQUETE, "T:%.2f", lectura.real);
+    } else {
+        snprintf(buffer, TAMANO_PAQUETE, "%c:%d", lectura.tipo, lectura.entero);
+    }
     return true;
 }
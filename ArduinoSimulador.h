@@ -8,18 +8,61 @@
 #ifndef ARDUINOSIMULADOR_H
 #define ARDUINOSIMULADOR_H
 
+#include "AnalizadorTramas.h"
+#include "PuertoSerial.h"
+
 /**
  * @class ArduinoSimulador
- * @brief Simula la captura de señales desde un dispositivo Arduino
+ * @brief Captura señales desde un Arduino real o simulado
  * 
- * En un sistema real, esta clase se conectaría al puerto serial
- * (COM1, /dev/ttyUSB0, etc.) y leería datos del Arduino.
- * En esta simulación, generamos datos aleatorios.
+ * conectar() intenta abrir el puerto serial indicado (/dev/ttyUSB0,
+ * /dev/ttyACM0, o el esclavo de un pseudo-terminal). Si lo consigue,
+ * las lecturas salen de las tramas "TIPO:VALOR" que envía el sketch
+ * arduino_sensor_example.ino; si no, se generan datos aleatorios como
+ * en la simulación original. La interfaz es la misma en ambos modos.
+ *
+ * En modo real los bytes del puerto pasan por un AnalizadorTramas, que
+ * entrega lecturas ya convertidas: recibirLectura() no formatea ni
+ * vuelve a interpretar texto.
  */
 class ArduinoSimulador {
+public:
+    static const int TAMANO_PAQUETE = 64;  ///< Bytes mínimos del buffer de recibirPaquete()
+    static const int ESPERA_MS = 1000;     ///< Tiempo máximo de espera por trama
+    static const int TAMANO_LECTURA = 256; ///< Bytes pedidos al puerto por lectura
+    static const char TIPO_CUALQUIERA = '*';  ///< Acepta la siguiente trama de cualquier tipo
+
 private:
-    bool conectado;     ///< Estado de la conexión simulada
-    int contadorLecturas; ///< Contador de lecturas simuladas
+    bool conectado;     ///< Estado de la conexión
+    int contadorLecturas; ///< Contador de lecturas recibidas
+    bool modoReal;      ///< true si las lecturas vienen de un puerto serial
+    PuertoSerial puerto;  ///< Puerto serial del modo real
+    AnalizadorTramas analizador;          ///< Ensambla tramas de los bytes recibidos
+    char recibidos[TAMANO_LECTURA];       ///< Último bloque leído del puerto
+    LecturaTrama lecturaAdelantada;       ///< Trama ya extraída por hayDatosDisponibles()
+    bool hayLecturaAdelantada;            ///< true si lecturaAdelantada está pendiente
+
+    /**
+     * @brief Obtiene la siguiente trama del puerto, de cualquier tipo
+     * @param lectura Destino de la lectura
+     * @param esperaMs Tiempo máximo de espera por bloque de bytes
+     * @return true si se obtuvo una trama
+     *
+     * Si el puerto se cierra, vuelve al estado desconectado.
+     */
+    bool siguienteTramaReal(LecturaTrama& lectura, int esperaMs);
+
+    /**
+     * @brief Lee del puerto la siguiente trama del tipo pedido
+     * @param lectura Destino de la lectura
+     * @param tipo Tipo de sensor buscado
+     * @return true si llegó una trama de ese tipo antes de ESPERA_MS
+     *
+     * Las líneas que no son tramas (encabezados, respuestas "OK:...")
+     * las descarta el analizador; las tramas de otros tipos, esta función
+     * (salvo con TIPO_CUALQUIERA).
+     */
+    bool leerTramaReal(LecturaTrama& lectura, char tipo);
 
 public:
     /**
@@ -28,11 +71,13 @@ public:
     ArduinoSimulador();
 
     /**
-     * @brief Simula la conexión al puerto serial
+     * @brief Conecta al puerto serial, o a la simulación si no está disponible
      * @param puerto Nombre del puerto (ej: "COM3", "/dev/ttyUSB0")
-     * @return true si la conexión fue exitosa
+     * @param baudios Velocidad del puerto (9600, 19200, 38400, 57600 o 115200)
+     * @return true si la conexión fue exitosa (también en modo simulado);
+     *         false si se pidió un puerto con una velocidad no soportada
      */
-    bool conectar(const char* puerto);
+    bool conectar(const char* puerto, int baudios = 9600);
 
     /**
      * @brief Desconecta del puerto serial
@@ -70,13 +115,32 @@ public:
     bool estaConectado() const;
 
     /**
-     * @brief Simula recepción de un paquete de datos
-     * @param buffer Buffer donde se almacenarán los datos
+     * @brief Indica si las lecturas provienen de un puerto serial real
+     * @return true en modo real, false en modo simulado
+     */
+    bool esModoReal() const;
+
+    /**
+     * @brief Recibe una lectura ya convertida (del puerto o simulada)
+     * @param tipo Tipo de sensor ('T'=Temp, 'P'=Presion, 'V'=Vibración),
+     *        o TIPO_CUALQUIERA para la siguiente trama sea del tipo que sea
+     * @param lectura Destino de la lectura
+     * @return true si se recibió correctamente
+     *
+     * Es el camino de captura: no pasa por texto intermedio.
+     */
+    bool recibirLectura(char tipo, LecturaTrama& lectura);
+
+    /**
+     * @brief Recibe un paquete de datos (del puerto o simulado)
+     * @param buffer Buffer donde se almacenarán los datos (TAMANO_PAQUETE bytes)
      * @param tipo Tipo de sensor ('T'=Temp, 'P'=Presion, 'V'=Vibración)
      * @return true si se recibió correctamente
      * 
      * Formato del paquete: "TIPO:VALOR"
-     * Ejemplo: "T:25.4" o "P:101"
+     * Ejemplo: "T:25.40" o "P:101"
+     *
+     * Formatea en texto el resultado de recibirLectura().
      */
     bool recibirPaquete(char* buffer, char tipo);
 };
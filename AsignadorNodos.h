@@ -0,0 +1,224 @@
+/**
+ * @file AsignadorNodos.h
+ * @brief Asignadores de nodos para las listas enlazadas (arena y heap)
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * Las listas reservan sus nodos a través de un asignador en lugar de usar
+ * new/delete directamente. El asignador por defecto es una arena por lista:
+ * reserva bloques (slabs) de nodos contiguos, entrega nodos avanzando un
+ * puntero y recicla los nodos eliminados en una lista libre.
+ */
+
+#ifndef ASIGNADORNODOS_H
+#define ASIGNADORNODOS_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Contadores de actividad de un asignador
+ */
+struct EstadisticasAsignador {
+    size_t reservasSistema;   ///< Llamadas a operator new realizadas
+    size_t nodosEntregados;   ///< Nodos entregados a la lista
+    size_t nodosDevueltos;    ///< Nodos devueltos por la lista
+    size_t bytesReservados;   ///< Bytes actualmente pedidos al sistema
+
+    EstadisticasAsignador()
+        : reservasSistema(0), nodosEntregados(0), nodosDevueltos(0), bytesReservados(0) {}
+};
+
+/**
+ * @class AsignadorHeap
+ * @brief Asignador trivial: un new/delete por nodo
+ * @tparam N Tipo de nodo
+ *
+ * Se conserva como referencia para comparar contra la arena.
+ */
+template <typename N>
+class AsignadorHeap {
+private:
+    EstadisticasAsignador estadisticas;  ///< Contadores de actividad
+
+public:
+    /// La lista debe devolver cada nodo individualmente
+    static const bool liberaEnBloque = false;
+
+    AsignadorHeap() {}
+
+    /**
+     * @brief Reserva memoria para un nodo
+     * @return Memoria sin construir del tamaño de N
+     */
+    void* reservar() {
+        estadisticas.reservasSistema++;
+        estadisticas.nodosEntregados++;
+        estadisticas.bytesReservados += sizeof(N);
+        return ::operator new(sizeof(N));
+    }
+
+    /**
+     * @brief Devuelve la memoria de un nodo ya destruido
+     * @param p Memoria obtenida con reservar()
+     */
+    void liberar(void* p) {
+        estadisticas.nodosDevueltos++;
+        estadisticas.bytesReservados -= sizeof(N);
+        ::operator delete(p);
+    }
+
+    /**
+     * @brief Sin efecto: cada nodo ya se devolvió con liberar()
+     */
+    void liberarTodo() {}
+
+    /**
+     * @brief Obtiene los contadores de actividad
+     * @return Referencia a las estadísticas
+     */
+    const EstadisticasAsignador& obtenerEstadisticas() const { return estadisticas; }
+
+private:
+    AsignadorHeap(const AsignadorHeap&);
+    AsignadorHeap& operator=(const AsignadorHeap&);
+};
+
+/**
+ * @class AsignadorArena
+ * @brief Arena de bloques con lista libre para nodos de un mismo tipo
+ * @tparam N Tipo de nodo
+ *
+ * - reservar(): toma un nodo de la lista libre o avanza un puntero dentro
+ *   del bloque actual; solo pide memoria al sistema al agotar el bloque.
+ * - liberar(): encadena el hueco en la lista libre (O(1), sin free).
+ * - liberarTodo(): devuelve todos los bloques de una vez.
+ *
+ * Los bloques crecen de forma geométrica (32, 64, ... hasta 4096 nodos)
+ * para no desperdiciar memoria en sensores con pocas lecturas.
+ */
+template <typename N>
+class AsignadorArena {
+private:
+    /**
+     * @brief Hueco de un bloque: un nodo o un enlace de la lista libre
+     */
+    union Hueco {
+        typename std::aligned_storage<sizeof(N), alignof(N)>::type almacen;
+        Hueco* siguienteLibre;
+    };
+
+    /**
+     * @brief Cabecera de bloque; los huecos van a continuación
+     */
+    struct Bloque {
+        Bloque* anterior;   ///< Bloque reservado previamente
+        size_t capacidad;   ///< Número de huecos del bloque
+    };
+
+    static const size_t CAPACIDAD_INICIAL = 32;    ///< Huecos del primer bloque
+    static const size_t CAPACIDAD_MAXIMA = 4096;   ///< Tope de huecos por bloque
+
+    Bloque* bloques;        ///< Último bloque reservado (lista de bloques)
+    Hueco* siguiente;       ///< Próximo hueco sin usar del bloque actual
+    Hueco* fin;             ///< Fin del bloque actual
+    Hueco* libres;          ///< Lista libre de huecos devueltos
+    size_t proximaCapacidad;  ///< Capacidad del siguiente bloque
+    EstadisticasAsignador estadisticas;  ///< Contadores de actividad
+
+    /**
+     * @brief Desplazamiento de los huecos respecto al inicio del bloque
+     */
+    static size_t desplazamientoHuecos() {
+        return (sizeof(Bloque) + alignof(Hueco) - 1) / alignof(Hueco) * alignof(Hueco);
+    }
+
+    void nuevoBloque() {
+        size_t capacidad = proximaCapacidad;
+        size_t bytes = desplazamientoHuecos() + capacidad * sizeof(Hueco);
+        char* memoria = static_cast<char*>(::operator new(bytes));
+
+        Bloque* bloque = reinterpret_cast<Bloque*>(memoria);
+        bloque->anterior = bloques;
+        bloque->capacidad = capacidad;
+        bloques = bloque;
+
+        siguiente = reinterpret_cast<Hueco*>(memoria + desplazamientoHuecos());
+        fin = siguiente + capacidad;
+
+        estadisticas.reservasSistema++;
+        estadisticas.bytesReservados += bytes;
+        if (proximaCapacidad < CAPACIDAD_MAXIMA) {
+            proximaCapacidad *= 2;
+        }
+    }
+
+public:
+    /// La lista puede soltar todos sus nodos con liberarTodo()
+    static const bool liberaEnBloque = true;
+
+    AsignadorArena()
+        : bloques(nullptr), siguiente(nullptr), fin(nullptr), libres(nullptr),
+          proximaCapacidad(CAPACIDAD_INICIAL) {}
+
+    ~AsignadorArena() {
+        liberarTodo();
+    }
+
+    /**
+     * @brief Reserva memoria para un nodo
+     * @return Memoria sin construir del tamaño de N
+     */
+    void* reservar() {
+        estadisticas.nodosEntregados++;
+        if (libres != nullptr) {
+            Hueco* hueco = libres;
+            libres = libres->siguienteLibre;
+            return hueco;
+        }
+        if (siguiente == fin) {
+            nuevoBloque();
+        }
+        return siguiente++;
+    }
+
+    /**
+     * @brief Devuelve un nodo ya destruido a la lista libre
+     * @param p Memoria obtenida con reservar()
+     */
+    void liberar(void* p) {
+        estadisticas.nodosDevueltos++;
+        Hueco* hueco = static_cast<Hueco*>(p);
+        hueco->siguienteLibre = libres;
+        libres = hueco;
+    }
+
+    /**
+     * @brief Libera todos los bloques de la arena
+     *
+     * Los nodos deben estar ya destruidos (o ser trivialmente destructibles).
+     */
+    void liberarTodo() {
+        while (bloques != nullptr) {
+            Bloque* anterior = bloques->anterior;
+            ::operator delete(bloques);
+            bloques = anterior;
+        }
+        siguiente = fin = libres = nullptr;
+        proximaCapacidad = CAPACIDAD_INICIAL;
+        estadisticas.bytesReservados = 0;
+    }
+
+    /**
+     * @brief Obtiene los contadores de actividad
+     * @return Referencia a las estadísticas
+     */
+    const EstadisticasAsignador& obtenerEstadisticas() const { return estadisticas; }
+
+private:
+    AsignadorArena(const AsignadorArena&);
+    AsignadorArena& operator=(const AsignadorArena&);
+};
+
+#endif // ASIGNADORNODOS_H
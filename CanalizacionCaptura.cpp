@@ -0,0 +1,188 @@
+/**
+ * @file CanalizacionCaptura.cpp
+ * @brief Implementación de la captura lector/proceso
+ */
+
+#include "CanalizacionCaptura.h"
+#include "ArduinoSimulador.h"
+#include "ListaGestion.h"
+#include "Log.h"
+#include "RitmoCaptura.h"
+#include <chrono>
+
+namespace {
+
+/// Esperas activas (yield) del hilo de proceso antes de empezar a dormir
+const int VUELTAS_SIN_DORMIR = 1024;
+
+} // namespace
+
+CanalizacionCaptura::CanalizacionCaptura(ListaGestion& lista, ArduinoSimulador& arduino)
+    : lista(lista), arduino(arduino), activa(false), lectorTerminado(true),
+      frecuencia(0.0), maxLecturas(0),
+      recibidas(0), descartadas(0), profundidadMaxima(0),
+      procesadas(0), sinDestino(0), latenciaTotalNs(0), latenciaMaximaNs(0) {
+    for (int i = 0; i < 26; i++) {
+        rutas[i] = nullptr;
+    }
+}
+
+CanalizacionCaptura::~CanalizacionCaptura() {
+    detener();
+}
+
+int64_t CanalizacionCaptura::ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool CanalizacionCaptura::iniciar(double lecturasPorSegundo, unsigned long cantidad) {
+    if (estaActiva()) {
+        return false;
+    }
+
+    // Las rutas se resuelven aquí: el hilo de proceso no recorre la lista
+    for (int i = 0; i < 26; i++) {
+        rutas[i] = lista.buscarPorTipo(static_cast<char>('A' + i));
+    }
+
+    frecuencia = lecturasPorSegundo;
+    maxLecturas = cantidad;
+    recibidas = 0;
+    descartadas = 0;
+    profundidadMaxima = 0;
+    procesadas = 0;
+    sinDestino = 0;
+    latenciaTotalNs = 0;
+    latenciaMaximaNs = 0;
+
+    activa = true;
+    lectorTerminado = false;
+    hiloProceso = std::thread(&CanalizacionCaptura::bucleProceso, this);
+    hiloLector = std::thread(&CanalizacionCaptura::bucleLector, this);
+    LOG_INFO("[Canalización] Captura iniciada (cola de " << CAPACIDAD_COLA << " lecturas).\n");
+    return true;
+}
+
+void CanalizacionCaptura::esperar() {
+    if (hiloLector.joinable()) {
+        hiloLector.join();
+    }
+    if (hiloProceso.joinable()) {
+        hiloProceso.join();
+    }
+}
+
+void CanalizacionCaptura::detener() {
+    activa = false;
+    esperar();
+}
+
+bool CanalizacionCaptura::estaActiva() const {
+    return hiloLector.joinable() || hiloProceso.joinable();
+}
+
+void CanalizacionCaptura::bucleLector() {
+    RitmoCaptura ritmo(frecuencia);
+    ritmo.iniciar();
+
+    while (activa.load(std::memory_order_relaxed)) {
+        unsigned long llevadas = recibidas.load(std::memory_order_relaxed);
+        if (maxLecturas != 0 && llevadas >= maxLecturas) {
+            break;
+        }
+
+        LecturaEnCola elemento;
+        if (!arduino.recibirLectura(ArduinoSimulador::TIPO_CUALQUIERA, elemento.lectura)) {
+            if (!arduino.estaConectado()) {
+                break;  // El puerto se cerró: no llegarán más lecturas
+            }
+            continue;   // Sin trama dentro del tiempo de espera
+        }
+        elemento.recibidaNs = ahoraNs();
+        recibidas.store(llevadas + 1, std::memory_order_relaxed);
+
+        // Con la cola llena se cede el procesador una vez al hilo de
+        // proceso (necesario con un solo núcleo) antes de descartar
+        bool encolada = cola.intentarEncolar(elemento);
+        if (!encolada) {
+            std::this_thread::yield();
+            encolada = cola.intentarEncolar(elemento);
+        }
+        if (!encolada) {
+            descartadas.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            size_t profundidad = cola.obtenerProfundidad();
+            if (profundidad > profundidadMaxima.load(std::memory_order_relaxed)) {
+                profundidadMaxima.store(profundidad, std::memory_order_relaxed);
+            }
+        }
+
+        ritmo.esperarSiguiente();
+    }
+
+    lectorTerminado.store(true, std::memory_order_release);
+}
+
+void CanalizacionCaptura::bucleProceso() {
+    LecturaEnCola elemento;
+    int vueltasVacia = 0;
+
+    while (true) {
+        if (cola.intentarDesencolar(elemento)) {
+            despachar(elemento);
+            vueltasVacia = 0;
+            continue;
+        }
+
+        // Cola vacía: si el lector ya terminó, solo queda lo que entró antes
+        if (lectorTerminado.load(std::memory_order_acquire)) {
+            while (cola.intentarDesencolar(elemento)) {
+                despachar(elemento);
+            }
+            break;
+        }
+
+        // Espera breve: mientras llegan lecturas seguidas se cede el
+        // procesador sin dormir; tras un rato sin datos, se duerme
+        if (++vueltasVacia < VUELTAS_SIN_DORMIR) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+void CanalizacionCaptura::despachar(const LecturaEnCola& elemento) {
+    char tipo = elemento.lectura.tipo;
+    SensorBase* sensor = (tipo >= 'A' && tipo <= 'Z') ? rutas[tipo - 'A'] : nullptr;
+    if (sensor == nullptr) {
+        sinDestino.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sensor->registrarLecturaTrama(elemento.lectura);
+
+    int64_t latencia = ahoraNs() - elemento.recibidaNs;
+    latenciaTotalNs.fetch_add(latencia, std::memory_order_relaxed);
+    if (latencia > latenciaMaximaNs.load(std::memory_order_relaxed)) {
+        latenciaMaximaNs.store(latencia, std::memory_order_relaxed);
+    }
+    procesadas.fetch_add(1, std::memory_order_relaxed);
+}
+
+EstadisticasCanalizacion CanalizacionCaptura::obtenerEstadisticas() const {
+    EstadisticasCanalizacion estadisticas;
+    estadisticas.recibidas = recibidas.load(std::memory_order_relaxed);
+    estadisticas.procesadas = procesadas.load(std::memory_order_relaxed);
+    estadisticas.descartadas = descartadas.load(std::memory_order_relaxed);
+    estadisticas.sinDestino = sinDestino.load(std::memory_order_relaxed);
+    estadisticas.profundidad = cola.obtenerProfundidad();
+    estadisticas.profundidadMaxima = profundidadMaxima.load(std::memory_order_relaxed);
+    if (estadisticas.procesadas > 0) {
+        estadisticas.latenciaMediaUs = latenciaTotalNs.load(std::memory_order_relaxed)
+            / 1000.0 / static_cast<double>(estadisticas.procesadas);
+    }
+    estadisticas.latenciaMaximaUs = latenciaMaximaNs.load(std::memory_order_relaxed) / 1000.0;
+    return estadisticas;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file CanalizacionCaptura.h
+ * @brief Captura en dos hilos: lector del Arduino y despachador a sensores
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef CANALIZACIONCAPTURA_H
+#define CANALIZACIONCAPTURA_H
+
+#include "AnalizadorTramas.h"
+#include "ColaSPSC.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+class ArduinoSimulador;
+class ListaGestion;
+class SensorBase;
+
+/**
+ * @brief Contadores de una captura en curso o terminada
+ */
+struct EstadisticasCanalizacion {
+    unsigned long recibidas;     ///< Lecturas obtenidas del Arduino
+    unsigned long procesadas;    ///< Lecturas entregadas a un sensor
+    unsigned long descartadas;   ///< Lecturas perdidas por cola llena
+    unsigned long sinDestino;    ///< Lecturas de un tipo sin sensor asociado
+    size_t profundidad;          ///< Lecturas en cola ahora mismo
+    size_t profundidadMaxima;    ///< Mayor ocupación observada de la cola
+    double latenciaMediaUs;      ///< Media de recepción → registro (µs)
+    double latenciaMaximaUs;     ///< Máximo de recepción → registro (µs)
+
+    EstadisticasCanalizacion()
+        : recibidas(0), procesadas(0), descartadas(0), sinDestino(0),
+          profundidad(0), profundidadMaxima(0), latenciaMediaUs(0.0), latenciaMaximaUs(0.0) {}
+};
+
+/**
+ * @class CanalizacionCaptura
+ * @brief Separa la E/S del Arduino del registro de lecturas en los sensores
+ *
+ * - Hilo lector: pide lecturas al ArduinoSimulador (puerto real o
+ *   simulado) al ritmo indicado y las encola con su instante de llegada.
+ * - Hilo de proceso: desencola y entrega cada lectura al sensor de
+ *   ListaGestion cuyo tipo (obtenerTipo()) es el de la trama.
+ *
+ * Entre ambos hay una ColaSPSC sin bloqueos: una espera del puerto no
+ * detiene el procesamiento y un sensor lento no retrasa la lectura. Si la
+ * cola se llena, la lectura se descarta y se cuenta, en lugar de frenar
+ * al lector.
+ *
+ * Mientras la captura está activa, otro hilo puede procesar, imprimir o
+ * registrar sensores en la lista: cada sensor protege su historial. Las
+ * rutas por tipo se fijan en iniciar(), así que un sensor registrado
+ * durante la captura no recibe lecturas hasta la siguiente.
+ */
+class CanalizacionCaptura {
+public:
+    static const size_t CAPACIDAD_COLA = 1024;  ///< Lecturas en vuelo como máximo
+
+private:
+    /**
+     * @brief Lectura en tránsito entre los dos hilos
+     */
+    struct LecturaEnCola {
+        LecturaTrama lectura;   ///< Valor ya convertido
+        int64_t recibidaNs;     ///< Instante de llegada (steady_clock, ns)
+
+        LecturaEnCola() : recibidaNs(0) {}
+    };
+
+    ListaGestion& lista;          ///< Sensores destino
+    ArduinoSimulador& arduino;    ///< Fuente de lecturas
+    SensorBase* rutas[26];        ///< Sensor por letra de tipo ('A'..'Z')
+    ColaSPSC<LecturaEnCola, CAPACIDAD_COLA> cola;  ///< Lector → proceso
+
+    std::thread hiloLector;       ///< Hilo que lee del Arduino
+    std::thread hiloProceso;      ///< Hilo que registra en los sensores
+    std::atomic<bool> activa;     ///< false para pedir al lector que pare
+    std::atomic<bool> lectorTerminado;  ///< El lector ya no encolará más
+
+    double frecuencia;            ///< Lecturas por segundo (0 = sin pausa)
+    unsigned long maxLecturas;    ///< Lecturas a capturar (0 = hasta detener())
+
+    // Contadores: cada uno lo escribe un solo hilo
+    std::atomic<unsigned long> recibidas;
+    std::atomic<unsigned long> descartadas;
+    std::atomic<size_t> profundidadMaxima;
+    std::atomic<unsigned long> procesadas;
+    std::atomic<unsigned long> sinDestino;
+    std::atomic<int64_t> latenciaTotalNs;
+    std::atomic<int64_t> latenciaMaximaNs;
+
+    /**
+     * @brief Cuerpo del hilo lector
+     */
+    void bucleLector();
+
+    /**
+     * @brief Cuerpo del hilo de proceso
+     */
+    void bucleProceso();
+
+    /**
+     * @brief Entrega una lectura a su sensor y anota la latencia
+     * @param elemento Lectura desencolada
+     */
+    void despachar(const LecturaEnCola& elemento);
+
+    /**
+     * @brief Instante actual del reloj monotónico en nanosegundos
+     */
+    static int64_t ahoraNs();
+
+public:
+    /**
+     * @brief Constructor (sin hilos en marcha)
+     * @param lista Sensores que recibirán las lecturas
+     * @param arduino Fuente de lecturas, ya conectada
+     */
+    CanalizacionCaptura(ListaGestion& lista, ArduinoSimulador& arduino);
+
+    /**
+     * @brief Destructor - Detiene la captura si sigue activa
+     */
+    ~CanalizacionCaptura();
+
+    /**
+     * @brief Resuelve las rutas por tipo y arranca los dos hilos
+     * @param lecturasPorSegundo Ritmo del lector (0 = máximo rendimiento)
+     * @param cantidad Lecturas a capturar (0 = hasta detener())
+     * @return false si ya había una captura en marcha
+     */
+    bool iniciar(double lecturasPorSegundo, unsigned long cantidad);
+
+    /**
+     * @brief Espera a que el lector termine y a que se vacíe la cola
+     */
+    void esperar();
+
+    /**
+     * @brief Pide al lector que pare y espera a que se vacíe la cola
+     */
+    void detener();
+
+    /**
+     * @brief Indica si los hilos siguen en marcha
+     * @return true entre iniciar() y esperar()/detener()
+     */
+    bool estaActiva() const;
+
+    /**
+     * @brief Obtiene una instantánea de los contadores
+     * @return Contadores (se puede llamar desde cualquier hilo)
+     */
+    EstadisticasCanalizacion obtenerEstadisticas() const;
+
+private:
+    CanalizacionCaptura(const CanalizacionCaptura&);
+    CanalizacionCaptura& operator=(const CanalizacionCaptura&);
+};
+
+#endif // CANALIZACIONCAPTURA_H
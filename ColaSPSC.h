@@ -0,0 +1,110 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular sin bloqueos para un productor y un consumidor
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef COLASPSC_H
+#define COLASPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class ColaSPSC
+ * @brief Buffer circular de capacidad fija entre exactamente dos hilos
+ * @tparam T Tipo de los elementos (copiable y con constructor por defecto)
+ * @tparam N Capacidad (potencia de dos)
+ *
+ * Un único hilo productor llama a intentarEncolar() y un único hilo
+ * consumidor a intentarDesencolar(). Cada índice lo escribe un solo hilo,
+ * así que basta con cargas acquire y almacenamientos release: no hay
+ * mutex ni operaciones read-modify-write. Los índices crecen sin límite y
+ * se reducen con la máscara N - 1.
+ *
+ * Los índices de cada lado van en líneas de caché separadas para que el
+ * productor y el consumidor no se invaliden mutuamente (false sharing).
+ * Cada lado guarda además la última posición conocida del otro y solo la
+ * vuelve a leer cuando la cola parece llena o vacía.
+ */
+template <typename T, size_t N>
+class ColaSPSC {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "La capacidad debe ser potencia de dos");
+
+private:
+    static const size_t LINEA_CACHE = 64;  ///< Bytes de una línea de caché típica
+
+    // --- Lado del consumidor ---
+    std::atomic<size_t> cabeza;       ///< Próxima posición a leer
+    size_t colaConocida;              ///< Copia local de cola (solo consumidor)
+    char rellenoConsumidor[LINEA_CACHE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    // --- Lado del productor ---
+    std::atomic<size_t> cola;         ///< Próxima posición a escribir
+    size_t cabezaConocida;            ///< Copia local de cabeza (solo productor)
+    char rellenoProductor[LINEA_CACHE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    T datos[N];  ///< Almacenamiento circular
+
+public:
+    ColaSPSC() : cabeza(0), colaConocida(0), cola(0), cabezaConocida(0) {}
+
+    /**
+     * @brief Encola un elemento (solo desde el hilo productor)
+     * @param valor Elemento a copiar en la cola
+     * @return false si la cola está llena (el elemento no se encola)
+     */
+    bool intentarEncolar(const T& valor) {
+        size_t posicion = cola.load(std::memory_order_relaxed);
+        if (posicion - cabezaConocida == N) {
+            cabezaConocida = cabeza.load(std::memory_order_acquire);
+            if (posicion - cabezaConocida == N) {
+                return false;
+            }
+        }
+        datos[posicion & (N - 1)] = valor;
+        cola.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Desencola un elemento (solo desde el hilo consumidor)
+     * @param valor Destino del elemento
+     * @return false si la cola está vacía
+     */
+    bool intentarDesencolar(T& valor) {
+        size_t posicion = cabeza.load(std::memory_order_relaxed);
+        if (posicion == colaConocida) {
+            colaConocida = cola.load(std::memory_order_acquire);
+            if (posicion == colaConocida) {
+                return false;
+            }
+        }
+        valor = datos[posicion & (N - 1)];
+        cabeza.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Número aproximado de elementos en cola (desde cualquier hilo)
+     * @return Elementos encolados y aún no consumidos
+     */
+    size_t obtenerProfundidad() const {
+        size_t leida = cabeza.load(std::memory_order_acquire);
+        size_t escrita = cola.load(std::memory_order_acquire);
+        return escrita >= leida ? escrita - leida : 0;
+    }
+
+    /**
+     * @brief Capacidad de la cola
+     * @return N
+     */
+    static size_t obtenerCapacidad() { return N; }
+
+private:
+    ColaSPSC(const ColaSPSC&);
+    ColaSPSC& operator=(const ColaSPSC&);
+};
+
+#endif // COLASPSC_H
@@ -0,0 +1,516 @@
+/**
+ * @file DiarioLecturas.cpp
+ * @brief Implementación del registro de escritura anticipada de lecturas
+ */
+
+#include "DiarioLecturas.h"
+#include "ArchivoProyectado.h"
+#include "InstanteLectura.h"
+#include "ListaGestion.h"
+#include "Log.h"
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+/// Firma al principio de todo diario
+const char FIRMA[8] = {'I', 'O', 'T', 'W', 'A', 'L', '0', '1'};
+
+/// Marca para detectar un diario escrito con otro orden de bytes
+const uint32_t MARCA_ORDEN = 0x01020304u;
+
+const size_t BYTES_CABECERA = sizeof(FIRMA) + sizeof(uint32_t);
+const size_t BYTES_LECTURA = 1 + 8 + 8 + 8 + 4 + 4;   ///< Registro 'L' completo
+const size_t BYTES_SENSOR_FIJOS = 1 + 8 + 1 + 1 + 4;  ///< Registro 'S' sin el nombre
+
+/**
+ * @brief FNV-1a de 32 bits (comprobación de cada registro)
+ */
+uint32_t comprobacion(const char* datos, size_t n) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        hash ^= static_cast<unsigned char>(datos[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename V>
+char* poner(char* destino, V valor) {
+    memcpy(destino, &valor, sizeof(V));
+    return destino + sizeof(V);
+}
+
+template <typename V>
+V tomar(const char* origen) {
+    V valor;
+    memcpy(&valor, origen, sizeof(V));
+    return valor;
+}
+
+/**
+ * @brief Fuerza a disco lo ya escrito con fflush
+ */
+bool sincronizarDescriptor(FILE* archivo) {
+#ifndef _WIN32
+    return fsync(fileno(archivo)) == 0;
+#else
+    return _commit(_fileno(archivo)) == 0;
+#endif
+}
+
+/**
+ * @brief Recorta un archivo a sus primeros longitud bytes
+ */
+bool truncarArchivo(const std::string& ruta, size_t longitud) {
+#ifndef _WIN32
+    return truncate(ruta.c_str(), static_cast<off_t>(longitud)) == 0;
+#else
+    int descriptor = _open(ruta.c_str(), _O_RDWR | _O_BINARY);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool correcto = _chsize_s(descriptor, static_cast<__int64>(longitud)) == 0;
+    _close(descriptor);
+    return correcto;
+#endif
+}
+
+/**
+ * @brief Sensor del diario ya resuelto en la lista
+ */
+struct SensorReproducido {
+    uint64_t id;
+    SensorBase* sensor;  ///< nullptr si sus lecturas se descartan
+};
+
+} // namespace
+
+const size_t DiarioLecturas::UMBRAL_VOLCADO;
+const size_t DiarioLecturas::LIMITE_PENDIENTE;
+
+DiarioLecturas::DiarioLecturas(const char* ruta, int64_t latenciaMs)
+    : ruta(ruta), rutaAnterior(std::string(ruta) + ".anterior"),
+      latenciaMs(latenciaMs > 0 ? latenciaMs : 0), desfase(desfaseRelojSistemaMs()),
+      archivo(nullptr), pendiente(nullptr), usados(0), capacidad(0),
+      enVuelo(nullptr), capacidadEnVuelo(0), anotados(0), durables(0),
+      sincronizaciones(0), solicitudes(0), terminar(false), abierto(false),
+      sensores(nullptr), numSensores(0), capacidadSensores(0) {
+}
+
+DiarioLecturas::~DiarioLecturas() {
+    cerrar();
+    delete[] pendiente;
+    delete[] enVuelo;
+    delete[] sensores;
+}
+
+char* DiarioLecturas::reservar(size_t n) {
+    if (usados + n > capacidad) {
+        size_t nuevaCapacidad = capacidad > 0 ? capacidad * 2 : 64 * 1024;
+        while (nuevaCapacidad < usados + n) {
+            nuevaCapacidad *= 2;
+        }
+        char* nuevo = new char[nuevaCapacidad];
+        if (usados > 0) {
+            memcpy(nuevo, pendiente, usados);
+        }
+        delete[] pendiente;
+        pendiente = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+    char* destino = pendiente + usados;
+    usados += n;
+    anotados += n;
+    return destino;
+}
+
+void DiarioLecturas::anotarRegistroSensor(const SensorAnotado& sensor) {
+    size_t largo = strlen(sensor.nombre);
+    char* registro = reservar(BYTES_SENSOR_FIJOS + largo);
+    char* cursor = poner<char>(registro, 'S');
+    cursor = poner<uint64_t>(cursor, sensor.id);
+    cursor = poner<char>(cursor, sensor.tipo);
+    cursor = poner<uint8_t>(cursor, static_cast<uint8_t>(largo));
+    memcpy(cursor, sensor.nombre, largo);
+    cursor += largo;
+    poner<uint32_t>(cursor, comprobacion(registro, cursor - registro));
+}
+
+void DiarioLecturas::registrarSensor(uint64_t id, char tipo, const char* nombre) {
+    std::lock_guard<std::mutex> guarda(cerrojo);
+    int indice = 0;
+    while (indice < numSensores && sensores[indice].id != id) {
+        indice++;
+    }
+    if (indice == numSensores) {
+        if (numSensores == capacidadSensores) {
+            capacidadSensores = capacidadSensores > 0 ? capacidadSensores * 2 : 16;
+            SensorAnotado* nuevos = new SensorAnotado[capacidadSensores];
+            for (int i = 0; i < numSensores; i++) {
+                nuevos[i] = sensores[i];
+            }
+            delete[] sensores;
+            sensores = nuevos;
+        }
+        sensores[numSensores].id = id;
+        sensores[numSensores].tipo = tipo;
+        strncpy(sensores[numSensores].nombre, nombre, 49);
+        sensores[numSensores].nombre[49] = '\0';
+        numSensores++;
+    }
+    if (abierto) {
+        bool estabaVacio = usados == 0;
+        anotarRegistroSensor(sensores[indice]);
+        if (estabaVacio) {
+            hayPendientes.notify_one();
+        }
+    }
+}
+
+void DiarioLecturas::anotarValores(uint64_t id, uint64_t primera, int64_t instante,
+                                   const char* valores, int cantidad) {
+    std::unique_lock<std::mutex> guarda(cerrojo);
+    if (!abierto || cantidad <= 0) {
+        return;
+    }
+    // Si el disco no da abasto, el sensor espera en lugar de crecer sin fin
+    hayVolcado.wait(guarda, [this] { return usados < LIMITE_PENDIENTE || !abierto; });
+    if (!abierto) {
+        return;
+    }
+
+    bool estabaVacio = usados == 0;
+    int64_t horaUnix = instante + desfase;
+    char* registro = reservar(BYTES_LECTURA * static_cast<size_t>(cantidad));
+    for (int i = 0; i < cantidad; i++) {
+        char* cursor = poner<char>(registro, 'L');
+        cursor = poner<uint64_t>(cursor, id);
+        cursor = poner<uint64_t>(cursor, primera + static_cast<uint64_t>(i));
+        cursor = poner<int64_t>(cursor, horaUnix);
+        memcpy(cursor, valores + 4 * i, 4);
+        cursor += 4;
+        poner<uint32_t>(cursor, comprobacion(registro, cursor - registro));
+        registro += BYTES_LECTURA;
+    }
+    if (estabaVacio || usados >= UMBRAL_VOLCADO) {
+        hayPendientes.notify_one();
+    }
+}
+
+void DiarioLecturas::volcarPendientes() {
+    size_t bytes;
+    uint64_t hasta;
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        std::swap(pendiente, enVuelo);
+        std::swap(capacidad, capacidadEnVuelo);
+        bytes = usados;
+        usados = 0;
+        hasta = anotados;
+    }
+
+    if (bytes > 0) {
+        bool correcto = archivo != nullptr && fwrite(enVuelo, 1, bytes, archivo) == bytes
+                        && fflush(archivo) == 0 && sincronizarDescriptor(archivo);
+        if (!correcto) {
+            LOG_ERROR("[Diario] Error al escribir " << ruta << ": lecturas no durables.\n");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        durables = hasta;
+        if (bytes > 0) {
+            sincronizaciones++;
+        }
+    }
+    hayVolcado.notify_all();
+}
+
+void DiarioLecturas::bucleVolcador() {
+    std::unique_lock<std::mutex> guarda(cerrojo);
+    while (true) {
+        hayPendientes.wait(guarda, [this] { return terminar || solicitudes > 0 || usados > 0; });
+        if (terminar && usados == 0) {
+            break;
+        }
+        // Commit agrupado: las lecturas que lleguen durante latenciaMs
+        // comparten el fsync de la primera
+        hayPendientes.wait_for(guarda, std::chrono::milliseconds(latenciaMs), [this] {
+            return terminar || solicitudes > 0 || usados >= UMBRAL_VOLCADO;
+        });
+        guarda.unlock();
+        {
+            std::lock_guard<std::mutex> guardaArchivo(cerrojoArchivo);
+            volcarPendientes();
+        }
+        guarda.lock();
+    }
+}
+
+bool DiarioLecturas::abrirArchivo() {
+    archivo = fopen(ruta.c_str(), "ab");
+    if (archivo == nullptr) {
+        return false;
+    }
+    fseek(archivo, 0, SEEK_END);
+    if (ftell(archivo) == 0) {
+        fwrite(FIRMA, 1, sizeof(FIRMA), archivo);
+        fwrite(&MARCA_ORDEN, sizeof(MARCA_ORDEN), 1, archivo);
+        if (fflush(archivo) != 0 || !sincronizarDescriptor(archivo)) {
+            fclose(archivo);
+            archivo = nullptr;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DiarioLecturas::abrir() {
+    std::lock_guard<std::mutex> guardaArchivo(cerrojoArchivo);
+    std::lock_guard<std::mutex> guarda(cerrojo);
+    if (abierto) {
+        return true;
+    }
+    if (!abrirArchivo()) {
+        LOG_AVISO("[Diario] No se pudo abrir " << ruta << ".\n");
+        return false;
+    }
+    // Los sensores conectados antes de abrir se registran ahora
+    for (int i = 0; i < numSensores; i++) {
+        anotarRegistroSensor(sensores[i]);
+    }
+    terminar = false;
+    abierto = true;
+    volcador = std::thread(&DiarioLecturas::bucleVolcador, this);
+    LOG_INFO("[Diario] Anotando lecturas en " << ruta << " (commit cada "
+             << latenciaMs << " ms como máximo).\n");
+    return true;
+}
+
+void DiarioLecturas::cerrar() {
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        if (!volcador.joinable()) {
+            return;
+        }
+        terminar = true;
+    }
+    hayPendientes.notify_one();
+    volcador.join();
+
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        abierto = false;
+    }
+    hayVolcado.notify_all();
+    std::lock_guard<std::mutex> guardaArchivo(cerrojoArchivo);
+    volcarPendientes();
+    if (archivo != nullptr) {
+        fclose(archivo);
+        archivo = nullptr;
+    }
+}
+
+void DiarioLecturas::sincronizar() {
+    std::unique_lock<std::mutex> guarda(cerrojo);
+    if (!abierto) {
+        return;
+    }
+    uint64_t objetivo = anotados;
+    solicitudes++;
+    hayPendientes.notify_one();
+    hayVolcado.wait(guarda, [&] { return durables >= objetivo || !abierto; });
+    solicitudes--;
+}
+
+bool DiarioLecturas::rotar() {
+    std::lock_guard<std::mutex> guardaArchivo(cerrojoArchivo);
+    if (archivo == nullptr) {
+        return false;
+    }
+    FILE* anterior = fopen(rutaAnterior.c_str(), "rb");
+    if (anterior != nullptr) {
+        fclose(anterior);
+        return false;
+    }
+
+    // Lo anotado hasta aquí se queda en el archivo actual; el nuevo
+    // empieza por el registro de cada sensor
+    size_t bytes;
+    uint64_t hasta;
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        std::swap(pendiente, enVuelo);
+        std::swap(capacidad, capacidadEnVuelo);
+        bytes = usados;
+        usados = 0;
+        hasta = anotados;
+        for (int i = 0; i < numSensores; i++) {
+            anotarRegistroSensor(sensores[i]);
+        }
+    }
+    bool correcto = (bytes == 0 || fwrite(enVuelo, 1, bytes, archivo) == bytes)
+                    && fflush(archivo) == 0 && sincronizarDescriptor(archivo);
+    fclose(archivo);
+    correcto = correcto && std::rename(ruta.c_str(), rutaAnterior.c_str()) == 0;
+    if (!abrirArchivo()) {
+        LOG_ERROR("[Diario] No se pudo reabrir " << ruta << ": lecturas no durables.\n");
+    }
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        durables = hasta;
+    }
+    hayVolcado.notify_all();
+    hayPendientes.notify_one();
+    if (!correcto) {
+        LOG_AVISO("[Diario] No se pudo rotar " << ruta << ".\n");
+    }
+    return correcto;
+}
+
+void DiarioLecturas::descartarAnterior() {
+    std::lock_guard<std::mutex> guardaArchivo(cerrojoArchivo);
+    std::remove(rutaAnterior.c_str());
+}
+
+uint64_t DiarioLecturas::obtenerSincronizaciones() {
+    std::lock_guard<std::mutex> guarda(cerrojo);
+    return sincronizaciones;
+}
+
+uint64_t DiarioLecturas::obtenerBytesAnotados() {
+    std::lock_guard<std::mutex> guarda(cerrojo);
+    return anotados;
+}
+
+int64_t DiarioLecturas::reproducir(ListaGestion& lista) {
+    int64_t reaplicadas = 0;
+    if (!reproducirArchivo(rutaAnterior, lista, reaplicadas, false) ||
+        !reproducirArchivo(ruta, lista, reaplicadas, true)) {
+        LOG_AVISO("[Diario] " << ruta << " no es un diario válido.\n");
+        return -1;
+    }
+    if (reaplicadas > 0) {
+        LOG_INFO("[Diario] " << reaplicadas << " lecturas recuperadas de " << ruta << ".\n");
+    }
+    return reaplicadas;
+}
+
+bool DiarioLecturas::reproducirArchivo(const std::string& rutaArchivo, ListaGestion& lista,
+                                       int64_t& reaplicadas, bool truncar) {
+    ArchivoProyectado proyeccion;
+    ArchivoProyectado::Estado estado = proyeccion.abrir(rutaArchivo.c_str());
+    if (estado == ArchivoProyectado::NO_EXISTE) {
+        return true;
+    }
+    if (estado != ArchivoProyectado::ABIERTO) {
+        return false;
+    }
+    const char* datos = proyeccion.obtenerDatos();
+    size_t longitud = proyeccion.obtenerLongitud();
+    if (longitud < BYTES_CABECERA) {
+        // Cabecera a medio escribir: el diario no llegó a tener lecturas
+        proyeccion.cerrar();
+        return !truncar || truncarArchivo(rutaArchivo, 0);
+    }
+    if (memcmp(datos, FIRMA, sizeof(FIRMA)) != 0 ||
+        tomar<uint32_t>(datos + sizeof(FIRMA)) != MARCA_ORDEN) {
+        return false;
+    }
+
+    SensorReproducido* vistos = nullptr;
+    int numVistos = 0;
+    int capacidadVistos = 0;
+    int ultimo = -1;  // Las lecturas de un sensor suelen venir seguidas
+
+    size_t posicion = BYTES_CABECERA;
+    while (posicion < longitud) {
+        const char* registro = datos + posicion;
+        size_t restantes = longitud - posicion;
+        size_t largoRegistro;
+        if (registro[0] == 'L') {
+            largoRegistro = BYTES_LECTURA;
+        } else if (registro[0] == 'S' && restantes >= 1 + 8 + 1 + 1) {
+            largoRegistro = BYTES_SENSOR_FIJOS + static_cast<uint8_t>(registro[10]);
+        } else {
+            break;
+        }
+        if (restantes < largoRegistro ||
+            comprobacion(registro, largoRegistro - 4) != tomar<uint32_t>(registro + largoRegistro - 4)) {
+            break;
+        }
+
+        uint64_t id = tomar<uint64_t>(registro + 1);
+        if (ultimo < 0 || vistos[ultimo].id != id) {
+            ultimo = 0;
+            while (ultimo < numVistos && vistos[ultimo].id != id) {
+                ultimo++;
+            }
+            if (ultimo == numVistos) {
+                ultimo = -1;
+            }
+        }
+
+        if (registro[0] == 'S') {
+            char tipo = registro[9];
+            char nombre[50];
+            size_t largoNombre = static_cast<uint8_t>(registro[10]);
+            if (largoNombre > 49) {
+                largoNombre = 49;
+            }
+            memcpy(nombre, registro + 11, largoNombre);
+            nombre[largoNombre] = '\0';
+
+            SensorBase* sensor = lista.buscarSensor(nombre);
+            if (sensor == nullptr) {
+                sensor = SensorBase::crearDeTipo(tipo, nombre);
+                if (sensor != nullptr) {
+                    lista.insertarSensor(sensor);
+                }
+            } else if (sensor->obtenerTipo() != tipo) {
+                LOG_AVISO("[Diario] " << nombre << " cambió de tipo; se omiten sus lecturas.\n");
+                sensor = nullptr;
+            }
+            if (ultimo < 0) {
+                if (numVistos == capacidadVistos) {
+                    capacidadVistos = capacidadVistos > 0 ? capacidadVistos * 2 : 16;
+                    SensorReproducido* nuevos = new SensorReproducido[capacidadVistos];
+                    for (int i = 0; i < numVistos; i++) {
+                        nuevos[i] = vistos[i];
+                    }
+                    delete[] vistos;
+                    vistos = nuevos;
+                }
+                ultimo = numVistos++;
+                vistos[ultimo].id = id;
+            }
+            vistos[ultimo].sensor = sensor;
+        } else if (ultimo >= 0 && vistos[ultimo].sensor != nullptr) {
+            uint64_t numero = tomar<uint64_t>(registro + 9);
+            int64_t instante = tomar<int64_t>(registro + 17) - desfase;
+            if (vistos[ultimo].sensor->reproducirLectura(numero, instante,
+                                                         tomar<uint32_t>(registro + 25))) {
+                reaplicadas++;
+            }
+        }
+        posicion += largoRegistro;
+    }
+    delete[] vistos;
+
+    if (posicion < longitud && truncar) {
+        LOG_AVISO("[Diario] " << (longitud - posicion) << " bytes finales de " << rutaArchivo
+                  << " incompletos; se descartan.\n");
+        proyeccion.cerrar();
+        return truncarArchivo(rutaArchivo, posicion);
+    }
+    return true;
+}
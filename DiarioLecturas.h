@@ -0,0 +1,223 @@
+/**
+ * @file DiarioLecturas.h
+ * @brief Registro de escritura anticipada (WAL) de las lecturas, con commit agrupado
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef DIARIOLECTURAS_H
+#define DIARIOLECTURAS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class ListaGestion;
+
+/**
+ * @class DiarioLecturas
+ * @brief Archivo de solo anexado con cada lectura aceptada por los sensores
+ *
+ * Cada sensor conectado (SensorBase::conectarDiario) anota aquí sus
+ * lecturas al registrarlas: identificador del sensor (hash del nombre),
+ * número de secuencia, hora Unix en ms y valor. Los registros se acumulan
+ * en memoria y un hilo volcador los escribe y hace fsync en grupo: una
+ * sola sincronización cubre todo lo anotado durante latenciaMs (o antes,
+ * si el buffer supera UMBRAL_VOLCADO). Así el coste de fsync se reparte
+ * entre todas las lecturas del intervalo y la captura no espera al disco;
+ * a cambio, una caída puede perder como mucho los últimos latenciaMs.
+ * sincronizar() espera a que todo lo anotado esté en disco.
+ *
+ * Archivo: "IOTWAL01" + uint32 0x01020304, seguido de registros
+ *
+ *     'S' | uint64 id | tipo | uint8 largo | nombre | uint32 comprobación
+ *     'L' | uint64 id | uint64 número | int64 hora Unix | 4 bytes de valor | uint32 comprobación
+ *
+ * (comprobación = FNV-1a de 32 bits del registro). El registro 'S' de un
+ * sensor precede a sus lecturas y permite recrearlo al recuperarse.
+ *
+ * reproducir() recorre el diario al arrancar y reaplica a cada sensor las
+ * lecturas con número mayor que su secuencia (las que no recogió una
+ * instantánea), creando los sensores que falten. Un registro incompleto o
+ * con comprobación errónea marca el final (escritura interrumpida por la
+ * caída) y el archivo se trunca ahí antes de seguir anexando.
+ *
+ * Con InstantaneaGestion: antes de guardar, rotar() cierra el archivo
+ * como "ruta.anterior" y empieza uno nuevo; tras guardar, todo lo del
+ * anterior está en la instantánea y descartarAnterior() lo borra. El
+ * diario guarda lecturas, no lo que procesarLectura() elimina después.
+ */
+class DiarioLecturas {
+private:
+    /**
+     * @brief Sensor registrado (para repetir su registro 'S' al rotar)
+     */
+    struct SensorAnotado {
+        uint64_t id;
+        char tipo;
+        char nombre[50];
+    };
+
+    std::string ruta;            ///< Archivo del diario
+    std::string rutaAnterior;    ///< Archivo rotado pendiente de instantánea
+    int64_t latenciaMs;          ///< Espera máxima de una lectura antes de su fsync
+    int64_t desfase;             ///< Hora Unix - reloj monotónico, fijado al crear el diario
+    FILE* archivo;               ///< Abierto para anexar (lo protege cerrojoArchivo)
+
+    std::mutex cerrojo;          ///< Protege buffers, contadores y sensores
+    std::condition_variable hayPendientes;   ///< Despierta al volcador
+    std::condition_variable hayVolcado;      ///< Avisa de un fsync terminado
+    char* pendiente;             ///< Registros anotados sin escribir
+    size_t usados;               ///< Bytes válidos en pendiente
+    size_t capacidad;            ///< Tamaño de pendiente
+    char* enVuelo;               ///< Buffer que escribe el volcador
+    size_t capacidadEnVuelo;     ///< Tamaño de enVuelo
+    uint64_t anotados;           ///< Bytes anotados desde la apertura
+    uint64_t durables;           ///< Bytes anotados ya sincronizados a disco
+    uint64_t sincronizaciones;   ///< fsync realizados
+    int solicitudes;             ///< Llamadas a sincronizar() esperando
+    bool terminar;               ///< Pide al volcador que salga
+    bool abierto;                ///< Se aceptan anotaciones (entre abrir() y cerrar())
+
+    SensorAnotado* sensores;     ///< Sensores registrados
+    int numSensores;
+    int capacidadSensores;
+
+    std::mutex cerrojoArchivo;   ///< Serializa escritura, fsync y rotación
+    std::thread volcador;        ///< Hilo del commit agrupado
+
+    /**
+     * @brief Reserva n bytes al final de pendiente (con cerrojo tomado)
+     * @return Dirección donde escribir los n bytes
+     */
+    char* reservar(size_t n);
+
+    /**
+     * @brief Anota n lecturas de 4 bytes
+     */
+    void anotarValores(uint64_t id, uint64_t primera, int64_t instante,
+                       const char* valores, int cantidad);
+
+    /**
+     * @brief Añade el registro 'S' de un sensor a pendiente (con cerrojo tomado)
+     */
+    void anotarRegistroSensor(const SensorAnotado& sensor);
+
+    /**
+     * @brief Escribe y sincroniza lo pendiente (con cerrojoArchivo tomado)
+     */
+    void volcarPendientes();
+
+    /**
+     * @brief Cuerpo del hilo volcador
+     */
+    void bucleVolcador();
+
+    /**
+     * @brief Reaplica un archivo de diario
+     * @param rutaArchivo Archivo a recorrer
+     * @param lista Lista donde buscar y crear sensores
+     * @param reaplicadas Suma las lecturas reaplicadas
+     * @param truncar true para recortar el archivo tras el último registro válido
+     * @return false si el archivo existe pero no es un diario
+     */
+    bool reproducirArchivo(const std::string& rutaArchivo, ListaGestion& lista,
+                           int64_t& reaplicadas, bool truncar);
+
+    /**
+     * @brief Abre ruta para anexar y escribe la cabecera si está vacío
+     */
+    bool abrirArchivo();
+
+public:
+    static const size_t UMBRAL_VOLCADO = 256 * 1024;    ///< Pendiente que adelanta el volcado
+    static const size_t LIMITE_PENDIENTE = 16 * 1024 * 1024;  ///< Pendiente que frena a los sensores
+
+    /**
+     * @brief Constructor
+     * @param ruta Archivo del diario
+     * @param latenciaMs Espera máxima antes del fsync de una lectura (>= 0)
+     */
+    DiarioLecturas(const char* ruta, int64_t latenciaMs = 10);
+
+    /**
+     * @brief Destructor - Vuelca lo pendiente y cierra
+     */
+    ~DiarioLecturas();
+
+    /**
+     * @brief Recupera las lecturas del diario tras una caída
+     * @param lista Sensores ya restaurados (p. ej. desde una instantánea)
+     * @return Lecturas reaplicadas o -1 si el archivo no es un diario válido
+     *
+     * Debe llamarse antes de abrir() y antes de conectar los sensores.
+     * Los sensores que solo aparecen en el diario se crean con retención
+     * por defecto.
+     */
+    int64_t reproducir(ListaGestion& lista);
+
+    /**
+     * @brief Abre el diario para anexar e inicia el volcador
+     * @return false si no se pudo abrir el archivo
+     */
+    bool abrir();
+
+    /**
+     * @brief Vuelca lo pendiente, detiene el volcador y cierra el archivo
+     */
+    void cerrar();
+
+    /**
+     * @brief Anota el registro 'S' de un sensor (lo llama SensorBase::conectarDiario)
+     */
+    void registrarSensor(uint64_t id, char tipo, const char* nombre);
+
+    /**
+     * @brief Anota lecturas consecutivas de un sensor
+     * @param id Identificador del sensor (hash del nombre)
+     * @param primera Número de secuencia de la primera lectura
+     * @param instante Instante de llegada (reloj monotónico, ms)
+     * @param valores Lecturas (float o int)
+     * @param cantidad Número de lecturas
+     */
+    template <typename T>
+    void anotarLecturas(uint64_t id, uint64_t primera, int64_t instante,
+                        const T* valores, int cantidad) {
+        static_assert(sizeof(T) == 4, "el diario guarda valores de 4 bytes");
+        anotarValores(id, primera, instante, reinterpret_cast<const char*>(valores), cantidad);
+    }
+
+    /**
+     * @brief Espera a que todo lo anotado hasta ahora esté en disco
+     */
+    void sincronizar();
+
+    /**
+     * @brief Pasa el archivo actual a "ruta.anterior" y empieza uno nuevo
+     * @return false si ya había un anterior (se conserva y no se rota)
+     */
+    bool rotar();
+
+    /**
+     * @brief Borra "ruta.anterior" (tras guardar una instantánea)
+     */
+    void descartarAnterior();
+
+    /**
+     * @brief Número de fsync realizados desde la apertura
+     */
+    uint64_t obtenerSincronizaciones();
+
+    /**
+     * @brief Bytes anotados desde la apertura
+     */
+    uint64_t obtenerBytesAnotados();
+
+    DiarioLecturas(const DiarioLecturas&) = delete;
+    DiarioLecturas& operator=(const DiarioLecturas&) = delete;
+};
+
+#endif // DIARIOLECTURAS_H
@@ -0,0 +1,271 @@
+/**
+ * @file FormatoInstantanea.h
+ * @brief Codificación binaria del estado de un sensor para InstantaneaGestion
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef FORMATOINSTANTANEA_H
+#define FORMATOINSTANTANEA_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include "HistorialSensor.h"
+#include "InstanteLectura.h"
+#include "NivelesResumen.h"
+
+/**
+ * @class LectorInstantanea
+ * @brief Lee campos de un registro en memoria comprobando sus límites
+ *
+ * Los campos se copian con memcpy, así que el registro no necesita estar
+ * alineado (puede apuntar directamente al archivo proyectado con mmap).
+ */
+class LectorInstantanea {
+private:
+    const char* posicion;  ///< Próximo byte sin leer
+    const char* fin;       ///< Fin del registro
+
+public:
+    LectorInstantanea(const char* datos, const char* fin) : posicion(datos), fin(fin) {}
+
+    /**
+     * @brief Lee un campo de tamaño fijo
+     * @return false si el registro no tiene bytes suficientes
+     */
+    template <typename V>
+    bool leer(V& valor) {
+        if (static_cast<size_t>(fin - posicion) < sizeof(V)) {
+            return false;
+        }
+        memcpy(&valor, posicion, sizeof(V));
+        posicion += sizeof(V);
+        return true;
+    }
+
+    /**
+     * @brief Avanza sobre n bytes y devuelve su comienzo
+     * @return nullptr si el registro no tiene n bytes más
+     */
+    const char* tomar(uint64_t n) {
+        if (static_cast<uint64_t>(fin - posicion) < n) {
+            return nullptr;
+        }
+        const char* inicio = posicion;
+        posicion += n;
+        return inicio;
+    }
+
+    /**
+     * @brief Bytes aún sin leer
+     */
+    uint64_t restantes() const { return static_cast<uint64_t>(fin - posicion); }
+
+    /**
+     * @brief Indica si se leyó el registro completo
+     */
+    bool alFinal() const { return posicion == fin; }
+};
+
+/**
+ * @class FormatoInstantanea
+ * @brief Escritura y lectura del cuerpo del registro de un sensor
+ *
+ * Cuerpo (valores en el orden de bytes de la máquina):
+ *
+ *     uint64 secuencia       lecturas aceptadas (numeración del diario)
+ *     uint8  modo            SIN_LIMITE, ACOTADO o COMPRIMIDO
+ *     int32  maxLecturas     retención del modo ACOTADO
+ *     int64  ventanaMs       ídem
+ *     uint64 n               lecturas del historial
+ *     T      valores[n]      en orden de llegada
+ *     int64  instantes[n]    hora Unix en ms
+ *     uint32 m, m × intervalo por minuto
+ *     uint32 h, h × intervalo por hora
+ *
+ * intervalo = { int64 inicio (hora Unix), suma (int64 o double),
+ * double sumaCuadrados, int64 cuenta, T minimo, T maximo }.
+ *
+ * Valores e instantes van en columnas: la carga copia tramos de
+ * TRAMO_CARGA lecturas y los inserta con insertarTramo() un bloque cada
+ * vez. Los instantes se guardan en hora Unix porque el reloj monotónico
+ * vuelve a empezar con cada arranque del equipo.
+ */
+class FormatoInstantanea {
+public:
+    /**
+     * @brief Historial activo del sensor
+     */
+    enum ModoHistorial {
+        SIN_LIMITE = 0,  ///< ListaSensorDesenrollada
+        ACOTADO    = 1,  ///< HistorialCircular
+        COMPRIMIDO = 2   ///< HistorialComprimido
+    };
+
+    static const int TRAMO_CARGA = 1024;  ///< Lecturas copiadas por paso
+
+    /**
+     * @brief Escribe un campo de tamaño fijo
+     */
+    template <typename V>
+    static void escribir(std::ostream& salida, const V& valor) {
+        salida.write(reinterpret_cast<const char*>(&valor), sizeof(V));
+    }
+
+    /**
+     * @brief Escribe el cuerpo completo de un sensor
+     * @param secuencia Lecturas aceptadas por el sensor
+     * @param historial Historial del sensor en su modo vigente
+     * @param resumen Niveles de resumen del sensor
+     *
+     * El sensor debe tener tomado su cerrojo de historial.
+     */
+    template <typename T>
+    static void escribirSensor(std::ostream& salida, uint64_t secuencia, const HistorialSensor<T>& historial,
+                               const NivelesResumen<T>& resumen) {
+        int64_t desfase = desfaseRelojSistemaMs();
+        const HistorialCircular<T>* ventana = historial.obtenerVentana();
+        escribir<uint64_t>(salida, secuencia);
+        if (ventana != nullptr) {
+            escribir<uint8_t>(salida, ACOTADO);
+            escribir<int32_t>(salida, ventana->obtenerCapacidad());
+            escribir<int64_t>(salida, ventana->obtenerVentanaMs());
+        } else {
+            escribir<uint8_t>(salida, historial.estaComprimido() ? COMPRIMIDO : SIN_LIMITE);
+            escribir<int32_t>(salida, 0);
+            escribir<int64_t>(salida, 0);
+        }
+        escribirLecturas<T>(salida, historial, desfase);
+        escribirSerie(salida, resumen.obtenerMinutos(), desfase);
+        escribirSerie(salida, resumen.obtenerHoras(), desfase);
+    }
+
+    /**
+     * @brief Lee la secuencia, el modo de historial y su retención
+     * @return false si faltan bytes o el modo no es válido
+     */
+    static bool leerConfiguracion(LectorInstantanea& lector, uint64_t& secuencia, uint8_t& modo,
+                                  int32_t& maxLecturas, int64_t& ventanaMs) {
+        if (!lector.leer(secuencia) || !lector.leer(modo) || !lector.leer(maxLecturas) || !lector.leer(ventanaMs)) {
+            return false;
+        }
+        return modo == SIN_LIMITE || modo == COMPRIMIDO || (modo == ACOTADO && maxLecturas > 0);
+    }
+
+    /**
+     * @brief Lee las lecturas y las inserta en un historial
+     * @param destino Historial con insertarTramo(valores, instantes, n)
+     * @return false si el registro está truncado
+     */
+    template <typename T, typename Historial>
+    static bool leerLecturas(LectorInstantanea& lector, Historial& destino) {
+        uint64_t cantidad;
+        if (!lector.leer(cantidad) ||
+            cantidad > lector.restantes() / (sizeof(T) + sizeof(int64_t))) {
+            return false;
+        }
+        const char* valores = lector.tomar(cantidad * sizeof(T));
+        const char* instantes = lector.tomar(cantidad * sizeof(int64_t));
+
+        int64_t desfase = desfaseRelojSistemaMs();
+        T tramoValores[TRAMO_CARGA];
+        int64_t tramoInstantes[TRAMO_CARGA];
+        for (uint64_t hechas = 0; hechas < cantidad;) {
+            int n = cantidad - hechas < static_cast<uint64_t>(TRAMO_CARGA)
+                        ? static_cast<int>(cantidad - hechas) : TRAMO_CARGA;
+            memcpy(tramoValores, valores + hechas * sizeof(T), n * sizeof(T));
+            memcpy(tramoInstantes, instantes + hechas * sizeof(int64_t), n * sizeof(int64_t));
+            for (int i = 0; i < n; i++) {
+                tramoInstantes[i] -= desfase;
+            }
+            destino.insertarTramo(tramoValores, tramoInstantes, n);
+            hechas += n;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lee los dos niveles de resumen
+     * @return false si el registro está truncado
+     */
+    template <typename T>
+    static bool leerResumen(LectorInstantanea& lector, NivelesResumen<T>& resumen) {
+        int64_t desfase = desfaseRelojSistemaMs();
+        for (int nivel = 0; nivel < 2; nivel++) {
+            uint32_t cantidad;
+            if (!lector.leer(cantidad)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < cantidad; i++) {
+                ResumenIntervalo<T> intervalo;
+                typename AgregadosLecturas<T>::Acumulador suma;
+                double sumaCuadrados;
+                int64_t cuenta;
+                if (!lector.leer(intervalo.inicioMs) || !lector.leer(suma) ||
+                    !lector.leer(sumaCuadrados) || !lector.leer(cuenta) ||
+                    !lector.leer(intervalo.minimo) || !lector.leer(intervalo.maximo)) {
+                    return false;
+                }
+                intervalo.inicioMs -= desfase;
+                intervalo.agregados = AgregadosLecturas<T>(suma, sumaCuadrados, cuenta);
+                if (nivel == 0) {
+                    resumen.restaurarMinuto(intervalo);
+                } else {
+                    resumen.restaurarHora(intervalo);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    /**
+     * @brief Escribe n, la columna de valores y la de instantes
+     */
+    template <typename T, typename Historial>
+    static void escribirLecturas(std::ostream& salida, const Historial& historial, int64_t desfase) {
+        escribir<uint64_t>(salida, static_cast<uint64_t>(historial.obtenerTamano()));
+
+        T valores[TRAMO_CARGA];
+        int usados = 0;
+        historial.recorrer([&](T valor) {
+            valores[usados++] = valor;
+            if (usados == TRAMO_CARGA) {
+                salida.write(reinterpret_cast<const char*>(valores), usados * sizeof(T));
+                usados = 0;
+            }
+        });
+        salida.write(reinterpret_cast<const char*>(valores), usados * sizeof(T));
+
+        int64_t instantes[TRAMO_CARGA];
+        usados = 0;
+        historial.recorrerConInstante([&](T, int64_t instante) {
+            instantes[usados++] = instante + desfase;
+            if (usados == TRAMO_CARGA) {
+                salida.write(reinterpret_cast<const char*>(instantes), usados * sizeof(int64_t));
+                usados = 0;
+            }
+        });
+        salida.write(reinterpret_cast<const char*>(instantes), usados * sizeof(int64_t));
+    }
+
+    /**
+     * @brief Escribe un nivel de resumen, del intervalo más antiguo al más reciente
+     */
+    template <typename T>
+    static void escribirSerie(std::ostream& salida, const SerieResumen<T>& serie, int64_t desfase) {
+        escribir<uint32_t>(salida, static_cast<uint32_t>(serie.obtenerTamano()));
+        for (int i = 0; i < serie.obtenerTamano(); i++) {
+            const ResumenIntervalo<T>& intervalo = serie.obtener(i);
+            escribir<int64_t>(salida, intervalo.inicioMs + desfase);
+            escribir(salida, intervalo.agregados.obtenerSuma());
+            escribir<double>(salida, intervalo.agregados.obtenerSumaCuadrados());
+            escribir<int64_t>(salida, intervalo.agregados.obtenerCuenta());
+            escribir<T>(salida, intervalo.minimo);
+            escribir<T>(salida, intervalo.maximo);
+        }
+    }
+};
+
+#endif // FORMATOINSTANTANEA_H
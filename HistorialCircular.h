@@ -0,0 +1,526 @@
+/**
+ * @file HistorialCircular.h
+ * @brief Historial acotado de lecturas sobre un buffer circular
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef HISTORIALCIRCULAR_H
+#define HISTORIALCIRCULAR_H
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include "AgregadosLecturas.h"
+#include "InstanteLectura.h"
+
+/**
+ * @class HistorialCircular
+ * @brief Guarda las últimas lecturas de un sensor con memoria fija
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Retención por cantidad: el buffer tiene capacidad fija y, lleno, cada
+ * lectura nueva sustituye a la más antigua. Retención por tiempo
+ * (opcional): las lecturas con más de ventanaMs milisegundos se retiran
+ * al insertar o al llamar a descartarAntiguas(). La memoria por sensor
+ * queda acotada por la capacidad, sin importar el tiempo en marcha.
+ *
+ * Suma, cuenta y suma de cuadrados se actualizan al entrar y al salir
+ * cada lectura, así que el promedio es de ventana deslizante y O(1). Para
+ * que el error de redondeo de tantas sumas y restas no se acumule, los
+ * agregados se recalculan desde cero tras cada "vuelta" completa de
+ * retiradas (coste amortizado O(1)). El recálculo, el mínimo y los
+ * promedios por intervalo recorren el buffer en tramos contiguos con
+ * KernelsLecturas (SIMD).
+ *
+ * Ofrece la misma interfaz de consulta que ListaSensorDesenrollada<T>,
+ * incluidas las consultas por intervalo de tiempo: los instantes no
+ * decrecen, así que el inicio del intervalo se busca en O(log n).
+ */
+template <typename T>
+class HistorialCircular {
+private:
+    T* datos;             ///< Lecturas, en orden circular desde inicio
+    int64_t* instantes;   ///< Instante de llegada de cada lectura (ms)
+    int capacidad;        ///< Máximo de lecturas retenidas
+    int inicio;           ///< Posición de la lectura más antigua
+    int tamano;           ///< Lecturas retenidas
+    int64_t ventanaMs;    ///< Antigüedad máxima (0 = sin límite de tiempo)
+    int retiradasSinRecalcular;      ///< Retiradas desde el último recálculo
+    AgregadosLecturas<T> agregados;  ///< Suma, cuenta y suma de cuadrados
+
+    /**
+     * @brief Posición física de la i-ésima lectura más antigua
+     */
+    int posicion(int i) const {
+        int p = inicio + i;
+        return p >= capacidad ? p - capacidad : p;
+    }
+
+    /**
+     * @brief Retira la lectura más antigua
+     */
+    void retirarPrimera();
+
+    /**
+     * @brief Índice lógico de la primera lectura no anterior a un instante
+     */
+    int primeraDesde(int64_t instanteMs) const;
+
+    /**
+     * @brief Recalcula los agregados recorriendo las lecturas retenidas
+     */
+    void recalcularAgregados();
+
+    /**
+     * @brief Entrega las lecturas lógicas [desde, hasta) como tramos contiguos
+     * @param funcion Invocable con argumentos (const T* datos, int n)
+     *
+     * El buffer circular las reparte en uno o dos tramos (antes y después
+     * de dar la vuelta), que se procesan con KernelsLecturas.
+     */
+    template <typename Funcion>
+    void recorrerTramos(int desde, int hasta, Funcion funcion) const {
+        if (hasta <= desde) {
+            return;
+        }
+        int p = posicion(desde);
+        int seguidas = capacidad - p;
+        if (hasta - desde <= seguidas) {
+            funcion(datos + p, hasta - desde);
+        } else {
+            funcion(datos + p, seguidas);
+            funcion(datos, hasta - desde - seguidas);
+        }
+    }
+
+    /**
+     * @brief Índice lógico de la primera aparición del mínimo (tamano > 0)
+     */
+    int indiceDelMinimo() const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacidad Máximo de lecturas retenidas (al menos 1)
+     * @param ventanaMs Antigüedad máxima en milisegundos (0 = sin límite)
+     */
+    explicit HistorialCircular(int capacidad, int64_t ventanaMs = 0);
+
+    /**
+     * @brief Destructor - Libera el buffer
+     */
+    ~HistorialCircular();
+
+    /**
+     * @brief Inserta una lectura con el instante actual (instanteActualMs())
+     * @param valor Valor a insertar
+     */
+    void insertarAlFinal(T valor);
+
+    /**
+     * @brief Inserta una lectura con un instante dado
+     * @param valor Valor a insertar
+     * @param instanteMs Instante de llegada; si es anterior al de la última
+     *        lectura se usa el de esta, para conservar el orden temporal
+     *
+     * Con el buffer lleno se retira la lectura más antigua; después se
+     * aplica la ventana de tiempo respecto a instanteMs.
+     */
+    void insertarAlFinal(T valor, int64_t instanteMs);
+
+    /**
+     * @brief Inserta un lote de lecturas con el instante actual
+     * @param valores Arreglo de lecturas, en orden de llegada
+     * @param cantidad Número de lecturas
+     *
+     * Si el lote supera la capacidad, solo se copian las últimas.
+     */
+    void insertarLote(const T* valores, int cantidad);
+
+    /**
+     * @brief Inserta un lote de lecturas llegadas en un mismo instante
+     * @param valores Arreglo de lecturas, en orden de llegada
+     * @param cantidad Número de lecturas
+     * @param instanteMs Instante de llegada del lote (ms)
+     */
+    void insertarLote(const T* valores, int cantidad, int64_t instanteMs);
+
+    /**
+     * @brief Inserta lecturas con su propio instante de llegada
+     * @param valores Arreglo de lecturas, en orden de llegada
+     * @param instantes Instante de cada lectura (ms)
+     * @param cantidad Número de lecturas
+     */
+    void insertarTramo(const T* valores, const int64_t* instantes, int cantidad) {
+        for (int i = 0; i < cantidad; i++) {
+            insertarAlFinal(valores[i], instantes[i]);
+        }
+    }
+
+    /**
+     * @brief Retira las lecturas que ya salieron de la ventana de tiempo
+     * @param ahora Instante de referencia en milisegundos
+     * @return Número de lecturas retiradas
+     */
+    int descartarAntiguas(int64_t ahora);
+
+    /**
+     * @brief Aplica una función a cada lectura, de la más antigua a la más nueva
+     * @param funcion Invocable con un argumento T
+     */
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const {
+        for (int i = 0; i < tamano; i++) {
+            funcion(datos[posicion(i)]);
+        }
+    }
+
+    /**
+     * @brief Aplica una función a cada lectura con su instante de llegada
+     * @param funcion Invocable con argumentos (T valor, int64_t instanteMs)
+     */
+    template <typename Funcion>
+    void recorrerConInstante(Funcion funcion) const {
+        for (int i = 0; i < tamano; i++) {
+            int p = posicion(i);
+            funcion(datos[p], instantes[p]);
+        }
+    }
+
+    /**
+     * @brief Aplica una función a las lecturas llegadas en [desdeMs, hastaMs)
+     * @param desdeMs Inicio del intervalo (incluido)
+     * @param hastaMs Fin del intervalo (excluido)
+     * @param funcion Invocable con un argumento T
+     */
+    template <typename Funcion>
+    void recorrerRango(int64_t desdeMs, int64_t hastaMs, Funcion funcion) const {
+        for (int i = primeraDesde(desdeMs); i < tamano; i++) {
+            int p = posicion(i);
+            if (instantes[p] >= hastaMs) {
+                return;
+            }
+            funcion(datos[p]);
+        }
+    }
+
+    /**
+     * @brief Cuenta las lecturas llegadas en [desdeMs, hastaMs), en O(log n)
+     */
+    int contarEnRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    /**
+     * @brief Promedio de las lecturas llegadas en [desdeMs, hastaMs)
+     * @return Promedio como tipo T (0 si no hay ninguna)
+     */
+    T calcularPromedioRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    /**
+     * @brief Promedio de la ventana, en O(1)
+     * @return Promedio como tipo T (0 si está vacío)
+     */
+    T calcularPromedio() const;
+
+    /**
+     * @brief Varianza poblacional de la ventana, en O(1)
+     * @return Varianza (0 con menos de dos lecturas)
+     */
+    double calcularVarianza() const;
+
+    /**
+     * @brief Desviación estándar poblacional de la ventana, en O(1)
+     * @return Desviación estándar
+     */
+    double calcularDesviacionEstandar() const;
+
+    /**
+     * @brief Encuentra el valor mínimo de la ventana
+     * @return Valor mínimo (el más antiguo ante empates)
+     */
+    T encontrarMinimo() const;
+
+    /**
+     * @brief Elimina la lectura con el valor mínimo
+     * @return Valor eliminado
+     *
+     * O(capacidad): el mínimo se busca con KernelsLecturas y las lecturas
+     * posteriores se desplazan una posición.
+     */
+    T eliminarMinimo();
+
+    /**
+     * @brief Obtiene el número de lecturas retenidas
+     */
+    int obtenerTamano() const;
+
+    /**
+     * @brief Obtiene el máximo de lecturas retenidas
+     */
+    int obtenerCapacidad() const;
+
+    /**
+     * @brief Obtiene la antigüedad máxima de las lecturas
+     * @return Milisegundos (0 = sin límite de tiempo)
+     */
+    int64_t obtenerVentanaMs() const;
+
+    /**
+     * @brief Verifica si no hay lecturas retenidas
+     */
+    bool estaVacia() const;
+
+    /**
+     * @brief Imprime las lecturas, de la más antigua a la más nueva
+     */
+    void imprimir() const;
+
+    /**
+     * @brief Descarta todas las lecturas (la memoria se conserva)
+     */
+    void limpiar();
+
+private:
+    HistorialCircular(const HistorialCircular&);
+    HistorialCircular& operator=(const HistorialCircular&);
+};
+
+// ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
+
+template <typename T>
+HistorialCircular<T>::HistorialCircular(int capacidad, int64_t ventanaMs)
+    : datos(nullptr), instantes(nullptr), capacidad(capacidad > 0 ? capacidad : 1),
+      inicio(0), tamano(0), ventanaMs(ventanaMs > 0 ? ventanaMs : 0),
+      retiradasSinRecalcular(0) {
+    datos = new T[this->capacidad];
+    instantes = new int64_t[this->capacidad];
+}
+
+template <typename T>
+HistorialCircular<T>::~HistorialCircular() {
+    delete[] datos;
+    delete[] instantes;
+}
+
+template <typename T>
+void HistorialCircular<T>::retirarPrimera() {
+    agregados.quitar(datos[inicio]);
+    inicio = posicion(1);
+    tamano--;
+
+    if (++retiradasSinRecalcular >= capacidad) {
+        recalcularAgregados();
+    }
+}
+
+template <typename T>
+void HistorialCircular<T>::recalcularAgregados() {
+    agregados.reiniciar();
+    recorrerTramos(0, tamano, [this](const T* tramo, int n) { agregados.agregarTramo(tramo, n); });
+    retiradasSinRecalcular = 0;
+}
+
+template <typename T>
+int HistorialCircular<T>::primeraDesde(int64_t instanteMs) const {
+    int bajo = 0;
+    int alto = tamano;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        if (instantes[posicion(medio)] < instanteMs) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    return bajo;
+}
+
+template <typename T>
+void HistorialCircular<T>::insertarAlFinal(T valor) {
+    insertarAlFinal(valor, instanteActualMs());
+}
+
+template <typename T>
+void HistorialCircular<T>::insertarAlFinal(T valor, int64_t instanteMs) {
+    if (tamano > 0 && instanteMs < instantes[posicion(tamano - 1)]) {
+        instanteMs = instantes[posicion(tamano - 1)];
+    }
+    if (tamano == capacidad) {
+        retirarPrimera();
+    }
+
+    int p = posicion(tamano);
+    datos[p] = valor;
+    instantes[p] = instanteMs;
+    tamano++;
+    agregados.agregar(valor);
+
+    descartarAntiguas(instanteMs);
+}
+
+template <typename T>
+void HistorialCircular<T>::insertarLote(const T* valores, int cantidad) {
+    insertarLote(valores, cantidad, instanteActualMs());
+}
+
+template <typename T>
+void HistorialCircular<T>::insertarLote(const T* valores, int cantidad, int64_t instanteMs) {
+    // Lo que no cabe se sustituiría dentro del mismo lote: se omite
+    if (cantidad > capacidad) {
+        valores += cantidad - capacidad;
+        cantidad = capacidad;
+    }
+
+    int64_t ahora = instanteMs;
+    if (tamano > 0 && ahora < instantes[posicion(tamano - 1)]) {
+        ahora = instantes[posicion(tamano - 1)];
+    }
+    for (int i = 0; i < cantidad; i++) {
+        if (tamano == capacidad) {
+            retirarPrimera();
+        }
+        int p = posicion(tamano);
+        datos[p] = valores[i];
+        instantes[p] = ahora;
+        tamano++;
+        agregados.agregar(valores[i]);
+    }
+
+    descartarAntiguas(ahora);
+}
+
+template <typename T>
+int HistorialCircular<T>::descartarAntiguas(int64_t ahora) {
+    if (ventanaMs == 0) {
+        return 0;
+    }
+
+    int retiradas = 0;
+    while (tamano > 0 && ahora - instantes[inicio] > ventanaMs) {
+        retirarPrimera();
+        retiradas++;
+    }
+    return retiradas;
+}
+
+template <typename T>
+int HistorialCircular<T>::contarEnRango(int64_t desdeMs, int64_t hastaMs) const {
+    if (hastaMs <= desdeMs) {
+        return 0;
+    }
+    return primeraDesde(hastaMs) - primeraDesde(desdeMs);
+}
+
+template <typename T>
+T HistorialCircular<T>::calcularPromedioRango(int64_t desdeMs, int64_t hastaMs) const {
+    AgregadosLecturas<T> agregadosRango;
+    recorrerTramos(primeraDesde(desdeMs), primeraDesde(hastaMs),
+                   [&agregadosRango](const T* tramo, int n) { agregadosRango.agregarTramo(tramo, n); });
+    return agregadosRango.promedio();
+}
+
+template <typename T>
+T HistorialCircular<T>::calcularPromedio() const {
+    return agregados.promedio();
+}
+
+template <typename T>
+double HistorialCircular<T>::calcularVarianza() const {
+    return agregados.varianza();
+}
+
+template <typename T>
+double HistorialCircular<T>::calcularDesviacionEstandar() const {
+    return agregados.desviacionEstandar();
+}
+
+template <typename T>
+T HistorialCircular<T>::encontrarMinimo() const {
+    if (tamano == 0) {
+        throw std::runtime_error("Lista vacía - no se puede encontrar mínimo");
+    }
+
+    return datos[posicion(indiceDelMinimo())];
+}
+
+template <typename T>
+int HistorialCircular<T>::indiceDelMinimo() const {
+    int indice = -1;
+    int desplazamiento = 0;
+    recorrerTramos(0, tamano, [&](const T* tramo, int n) {
+        int candidato = desplazamiento + KernelsLecturas::indiceMinimo(tramo, n);
+        T actual = indice < 0 ? T() : datos[posicion(indice)];
+        // Un tramo todo NaN no debe tapar el mínimo de los siguientes
+        if (indice < 0 || datos[posicion(candidato)] < actual || actual != actual) {
+            indice = candidato;
+        }
+        desplazamiento += n;
+    });
+    return indice;
+}
+
+template <typename T>
+T HistorialCircular<T>::eliminarMinimo() {
+    if (tamano == 0) {
+        throw std::runtime_error("Lista vacía - no se puede eliminar mínimo");
+    }
+
+    int indiceMinimo = indiceDelMinimo();
+    T minimo = datos[posicion(indiceMinimo)];
+
+    // Cierra el hueco desplazando las lecturas posteriores
+    for (int i = indiceMinimo; i < tamano - 1; i++) {
+        int destino = posicion(i);
+        int origen = posicion(i + 1);
+        datos[destino] = datos[origen];
+        instantes[destino] = instantes[origen];
+    }
+    tamano--;
+    agregados.quitar(minimo);
+    if (++retiradasSinRecalcular >= capacidad) {
+        recalcularAgregados();
+    }
+    return minimo;
+}
+
+template <typename T>
+int HistorialCircular<T>::obtenerTamano() const {
+    return tamano;
+}
+
+template <typename T>
+int HistorialCircular<T>::obtenerCapacidad() const {
+    return capacidad;
+}
+
+template <typename T>
+int64_t HistorialCircular<T>::obtenerVentanaMs() const {
+    return ventanaMs;
+}
+
+template <typename T>
+bool HistorialCircular<T>::estaVacia() const {
+    return tamano == 0;
+}
+
+template <typename T>
+void HistorialCircular<T>::imprimir() const {
+    std::cout << "[";
+    for (int i = 0; i < tamano; i++) {
+        std::cout << datos[posicion(i)];
+        if (i + 1 < tamano) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << "]\n";
+}
+
+template <typename T>
+void HistorialCircular<T>::limpiar() {
+    inicio = 0;
+    tamano = 0;
+    retiradasSinRecalcular = 0;
+    agregados.reiniciar();
+}
+
+#endif // HISTORIALCIRCULAR_H
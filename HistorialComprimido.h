@@ -0,0 +1,766 @@
+/**
+ * @file HistorialComprimido.h
+ * @brief Historial de lecturas comprimido en bloques de bytes (estilo Gorilla)
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef HISTORIALCOMPRIMIDO_H
+#define HISTORIALCOMPRIMIDO_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include "AgregadosLecturas.h"
+#include "InstanteLectura.h"
+
+/**
+ * @class EscritorBits
+ * @brief Añade bits (del más significativo al menos) a un buffer que crece
+ */
+class EscritorBits {
+private:
+    uint8_t* bytes;     ///< Buffer propio
+    int capacidad;      ///< Bytes reservados
+    int64_t bitsUsados; ///< Bits escritos
+
+    void asegurar(int64_t bits) {
+        int necesarios = static_cast<int>((bits + 7) / 8);
+        if (necesarios <= capacidad) {
+            return;
+        }
+        int nueva = capacidad == 0 ? 64 : capacidad * 2;
+        while (nueva < necesarios) {
+            nueva *= 2;
+        }
+        uint8_t* nuevos = new uint8_t[nueva];
+        if (capacidad > 0) {
+            memcpy(nuevos, bytes, capacidad);
+        }
+        memset(nuevos + capacidad, 0, nueva - capacidad);
+        delete[] bytes;
+        bytes = nuevos;
+        capacidad = nueva;
+    }
+
+public:
+    EscritorBits() : bytes(nullptr), capacidad(0), bitsUsados(0) {}
+    ~EscritorBits() { delete[] bytes; }
+
+    /**
+     * @brief Escribe los n bits bajos de valor (n <= 64)
+     */
+    void escribir(uint64_t valor, int n) {
+        asegurar(bitsUsados + n);
+        for (int i = n - 1; i >= 0; i--) {
+            if ((valor >> i) & 1u) {
+                bytes[bitsUsados >> 3] |= static_cast<uint8_t>(0x80u >> (bitsUsados & 7));
+            }
+            bitsUsados++;
+        }
+    }
+
+    /**
+     * @brief Escribe un entero sin signo en grupos de 7 bits (varint)
+     */
+    void escribirVarint(uint64_t valor) {
+        while (valor >= 0x80u) {
+            escribir((valor & 0x7Fu) | 0x80u, 8);
+            valor >>= 7;
+        }
+        escribir(valor, 8);
+    }
+
+    /**
+     * @brief Vacía el buffer (conserva la memoria)
+     */
+    void reiniciar() {
+        if (capacidad > 0) {
+            memset(bytes, 0, capacidad);
+        }
+        bitsUsados = 0;
+    }
+
+    /**
+     * @brief Ajusta la memoria reservada a los bytes usados
+     */
+    void recortar() {
+        int usados = obtenerBytesUsados();
+        if (usados == capacidad) {
+            return;
+        }
+        uint8_t* justos = usados > 0 ? new uint8_t[usados] : nullptr;
+        if (usados > 0) {
+            memcpy(justos, bytes, usados);
+        }
+        delete[] bytes;
+        bytes = justos;
+        capacidad = usados;
+    }
+
+    const uint8_t* obtenerBytes() const { return bytes; }
+    int obtenerBytesUsados() const { return static_cast<int>((bitsUsados + 7) / 8); }
+    int obtenerCapacidad() const { return capacidad; }
+
+private:
+    EscritorBits(const EscritorBits&);
+    EscritorBits& operator=(const EscritorBits&);
+};
+
+/**
+ * @class LectorBits
+ * @brief Lee en orden los bits escritos por EscritorBits
+ */
+class LectorBits {
+private:
+    const uint8_t* bytes;  ///< Buffer leído (no propio)
+    int64_t posicion;      ///< Próximo bit a leer
+
+public:
+    explicit LectorBits(const uint8_t* bytes) : bytes(bytes), posicion(0) {}
+
+    /**
+     * @brief Lee n bits (n <= 64) como entero sin signo
+     */
+    uint64_t leer(int n) {
+        uint64_t valor = 0;
+        for (int i = 0; i < n; i++) {
+            valor = (valor << 1) | ((bytes[posicion >> 3] >> (7 - (posicion & 7))) & 1u);
+            posicion++;
+        }
+        return valor;
+    }
+
+    /**
+     * @brief Lee un entero escrito con escribirVarint()
+     */
+    uint64_t leerVarint() {
+        uint64_t valor = 0;
+        int desplazamiento = 0;
+        while (true) {
+            uint64_t grupo = leer(8);
+            valor |= (grupo & 0x7Fu) << desplazamiento;
+            if ((grupo & 0x80u) == 0) {
+                return valor;
+            }
+            desplazamiento += 7;
+        }
+    }
+};
+
+/**
+ * @brief Zigzag: enteros con signo pequeños → enteros sin signo pequeños
+ */
+inline uint64_t codificarZigzag(int64_t valor) {
+    return (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63);
+}
+
+/**
+ * @brief Inversa de codificarZigzag()
+ */
+inline int64_t decodificarZigzag(uint64_t valor) {
+    return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1u);
+}
+
+/**
+ * @brief Codificación de los valores de un tipo de lectura
+ * @tparam T Tipo de dato de las lecturas (especializado para float e int)
+ *
+ * Cada especialización define un Estado (lo que el siguiente valor
+ * necesita del anterior) y las funciones para el primer valor del bloque
+ * y para los siguientes.
+ */
+template <typename T>
+struct CodecHistorial;
+
+/**
+ * @brief float: XOR con el valor anterior (Gorilla)
+ *
+ * - XOR = 0 (valor repetido): bit '0'.
+ * - Si los bits significativos caben en la ventana del XOR anterior:
+ *   '10' y esos bits.
+ * - Si no: '11', 5 bits de ceros iniciales, 5 bits de longitud - 1 y los
+ *   bits significativos.
+ * Las lecturas que cambian poco comparten signo, exponente y los bits
+ * altos de la mantisa, así que el XOR tiene muchos ceros a la izquierda.
+ */
+template <>
+struct CodecHistorial<float> {
+    struct Estado {
+        uint32_t anterior;  ///< Bits del valor anterior
+        int ceros;          ///< Ceros iniciales de la ventana vigente
+        int longitud;       ///< Bits significativos de la ventana vigente
+
+        Estado() : anterior(0), ceros(0), longitud(0) {}
+    };
+
+    static uint32_t aBits(float valor) {
+        uint32_t bits;
+        memcpy(&bits, &valor, sizeof(bits));
+        return bits;
+    }
+
+    static float deBits(uint32_t bits) {
+        float valor;
+        memcpy(&valor, &bits, sizeof(valor));
+        return valor;
+    }
+
+    static int cerosIniciales(uint32_t x) {
+        int n = 0;
+        while (n < 32 && (x & (0x80000000u >> n)) == 0) {
+            n++;
+        }
+        return n;
+    }
+
+    static int cerosFinales(uint32_t x) {
+        int n = 0;
+        while (n < 32 && (x & (1u << n)) == 0) {
+            n++;
+        }
+        return n;
+    }
+
+    static void escribirPrimero(EscritorBits& escritor, Estado& estado, float valor) {
+        estado = Estado();
+        estado.anterior = aBits(valor);
+        escritor.escribir(estado.anterior, 32);
+    }
+
+    static void escribir(EscritorBits& escritor, Estado& estado, float valor) {
+        uint32_t bits = aBits(valor);
+        uint32_t x = bits ^ estado.anterior;
+        estado.anterior = bits;
+        if (x == 0) {
+            escritor.escribir(0, 1);
+            return;
+        }
+
+        int ceros = cerosIniciales(x);
+        int finales = cerosFinales(x);
+        if (ceros > 31) {
+            ceros = 31;  // Cabe en 5 bits
+        }
+        if (estado.longitud > 0 && ceros >= estado.ceros &&
+            finales >= 32 - estado.ceros - estado.longitud) {
+            escritor.escribir(2, 2);  // '10'
+            escritor.escribir(x >> (32 - estado.ceros - estado.longitud), estado.longitud);
+            return;
+        }
+
+        int longitud = 32 - ceros - finales;
+        escritor.escribir(3, 2);  // '11'
+        escritor.escribir(static_cast<uint64_t>(ceros), 5);
+        escritor.escribir(static_cast<uint64_t>(longitud - 1), 5);
+        escritor.escribir(x >> finales, longitud);
+        estado.ceros = ceros;
+        estado.longitud = longitud;
+    }
+
+    static float leerPrimero(LectorBits& lector, Estado& estado) {
+        estado = Estado();
+        estado.anterior = static_cast<uint32_t>(lector.leer(32));
+        return deBits(estado.anterior);
+    }
+
+    static float leer(LectorBits& lector, Estado& estado) {
+        if (lector.leer(1) == 0) {
+            return deBits(estado.anterior);
+        }
+        if (lector.leer(1) == 1) {
+            estado.ceros = static_cast<int>(lector.leer(5));
+            estado.longitud = static_cast<int>(lector.leer(5)) + 1;
+        }
+        uint32_t significativos = static_cast<uint32_t>(lector.leer(estado.longitud));
+        uint32_t x = significativos << (32 - estado.ceros - estado.longitud);
+        estado.anterior ^= x;
+        return deBits(estado.anterior);
+    }
+};
+
+/**
+ * @brief int: diferencia con el valor anterior, en zigzag y varint
+ *
+ * Un valor repetido cuesta el bit '0'; si no, '1' y la diferencia. Una
+ * presión que se mueve en una banda estrecha cuesta poco más de un byte
+ * por lectura en lugar de cuatro.
+ */
+template <>
+struct CodecHistorial<int> {
+    struct Estado {
+        int64_t anterior;  ///< Valor anterior
+
+        Estado() : anterior(0) {}
+    };
+
+    static void escribirPrimero(EscritorBits& escritor, Estado& estado, int valor) {
+        estado.anterior = valor;
+        escritor.escribirVarint(codificarZigzag(valor));
+    }
+
+    static void escribir(EscritorBits& escritor, Estado& estado, int valor) {
+        int64_t diferencia = static_cast<int64_t>(valor) - estado.anterior;
+        if (diferencia == 0) {
+            escritor.escribir(0, 1);
+            return;
+        }
+        escritor.escribir(1, 1);
+        escritor.escribirVarint(codificarZigzag(diferencia));
+        estado.anterior = valor;
+    }
+
+    static int leerPrimero(LectorBits& lector, Estado& estado) {
+        estado.anterior = decodificarZigzag(lector.leerVarint());
+        return static_cast<int>(estado.anterior);
+    }
+
+    static int leer(LectorBits& lector, Estado& estado) {
+        if (lector.leer(1) == 1) {
+            estado.anterior += decodificarZigzag(lector.leerVarint());
+        }
+        return static_cast<int>(estado.anterior);
+    }
+};
+
+/**
+ * @brief Bloque comprimido de hasta LECTURAS_POR_BLOQUE lecturas
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Por lectura se escriben su instante y su valor, intercalados:
+ * - Instante: el primero en 64 bits; los demás como diferencia de la
+ *   diferencia anterior (delta-of-delta): '0' si el ritmo no cambió, o
+ *   '1' y la variación en zigzag + varint.
+ * - Valor: según CodecHistorial<T>.
+ * Cuenta, mínimo, máximo e instantes extremos se guardan fuera del flujo
+ * para poder saltar bloques sin descomprimirlos.
+ */
+template <typename T>
+struct BloqueComprimido {
+    EscritorBits flujo;              ///< Bits del bloque
+    int cuenta;                      ///< Lecturas del bloque
+    T minimo;                        ///< Menor lectura del bloque
+    T maximo;                        ///< Mayor lectura del bloque
+    int64_t instantePrimero;         ///< Llegada de la primera lectura (ms)
+    int64_t instanteUltimo;          ///< Llegada de la última lectura (ms)
+    int64_t deltaAnterior;           ///< Última diferencia de instantes
+    typename CodecHistorial<T>::Estado estadoValor;  ///< Estado del codificador
+    BloqueComprimido<T>* siguiente;  ///< Siguiente bloque
+
+    BloqueComprimido()
+        : cuenta(0), minimo(T()), maximo(T()), instantePrimero(0), instanteUltimo(0),
+          deltaAnterior(0), siguiente(nullptr) {}
+
+    /**
+     * @brief Añade una lectura al final del flujo
+     */
+    void agregar(T valor, int64_t instanteMs) {
+        if (cuenta == 0) {
+            flujo.escribir(static_cast<uint64_t>(instanteMs), 64);
+            CodecHistorial<T>::escribirPrimero(flujo, estadoValor, valor);
+            instantePrimero = instanteMs;
+            deltaAnterior = 0;
+            minimo = valor;
+            maximo = valor;
+        } else {
+            int64_t delta = instanteMs - instanteUltimo;
+            int64_t variacion = delta - deltaAnterior;
+            if (variacion == 0) {
+                flujo.escribir(0, 1);
+            } else {
+                flujo.escribir(1, 1);
+                flujo.escribirVarint(codificarZigzag(variacion));
+            }
+            deltaAnterior = delta;
+            CodecHistorial<T>::escribir(flujo, estadoValor, valor);
+            if (valor < minimo) {
+                minimo = valor;
+            }
+            if (maximo < valor) {
+                maximo = valor;
+            }
+        }
+        instanteUltimo = instanteMs;
+        cuenta++;
+    }
+
+    /**
+     * @brief Descomprime el bloque llamando a funcion(valor, instante)
+     */
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const {
+        if (cuenta == 0) {
+            return;
+        }
+        LectorBits lector(flujo.obtenerBytes());
+        typename CodecHistorial<T>::Estado estado;
+        int64_t instante = static_cast<int64_t>(lector.leer(64));
+        int64_t delta = 0;
+        funcion(CodecHistorial<T>::leerPrimero(lector, estado), instante);
+        for (int i = 1; i < cuenta; i++) {
+            if (lector.leer(1) == 1) {
+                delta += decodificarZigzag(lector.leerVarint());
+            }
+            instante += delta;
+            funcion(CodecHistorial<T>::leer(lector, estado), instante);
+        }
+    }
+
+    /**
+     * @brief Vacía el bloque para volver a escribirlo
+     */
+    void reiniciar() {
+        flujo.reiniciar();
+        cuenta = 0;
+    }
+
+    /**
+     * @brief Bytes que ocupa el bloque (estructura y flujo reservado)
+     */
+    size_t obtenerBytes() const {
+        return sizeof(*this) + static_cast<size_t>(flujo.obtenerCapacidad());
+    }
+};
+
+/**
+ * @class HistorialComprimido
+ * @brief Historial ilimitado que guarda las lecturas comprimidas
+ * @tparam T Tipo de dato de las lecturas (float o int)
+ *
+ * Las lecturas se añaden al bloque abierto (el último); al llenarse, su
+ * flujo se recorta a los bytes usados y se abre otro. Los agregados se
+ * mantienen al insertar y eliminar (promedio y desviación en O(1)); el
+ * mínimo usa el mínimo de cada bloque, y los recorridos descomprimen en
+ * flujo, sin materializar las lecturas.
+ *
+ * eliminarMinimo() descomprime solo el bloque que contiene el mínimo,
+ * quita la lectura y vuelve a comprimirlo: O(bloques + LECTURAS_POR_BLOQUE).
+ *
+ * Ofrece la misma interfaz de consulta que ListaSensorDesenrollada<T>.
+ */
+template <typename T>
+class HistorialComprimido {
+public:
+    static const int LECTURAS_POR_BLOQUE = 1024;  ///< Lecturas por bloque
+    typedef BloqueComprimido<T> Bloque;           ///< Tipo de nodo
+
+private:
+    Bloque* cabeza;   ///< Bloque más antiguo
+    Bloque* cola;     ///< Bloque abierto
+    int tamano;       ///< Lecturas guardadas
+    int numBloques;   ///< Bloques enlazados
+    AgregadosLecturas<T> agregados;  ///< Suma, cuenta y suma de cuadrados
+
+    /**
+     * @brief Bloque con el menor mínimo (el más antiguo ante empates)
+     * @param anterior Bloque previo al devuelto (nullptr si es la cabeza)
+     */
+    Bloque* bloqueDelMinimo(Bloque*& anterior) const;
+
+public:
+    HistorialComprimido() : cabeza(nullptr), cola(nullptr), tamano(0), numBloques(0) {}
+
+    /**
+     * @brief Destructor - Libera todos los bloques
+     */
+    ~HistorialComprimido() { limpiar(); }
+
+    /**
+     * @brief Inserta una lectura con el instante actual
+     */
+    void insertarAlFinal(T valor) { insertarAlFinal(valor, instanteActualMs()); }
+
+    /**
+     * @brief Inserta una lectura con su instante de llegada
+     * @param valor Valor a insertar
+     * @param instanteMs Instante; si es anterior a la última lectura se usa el de esta
+     */
+    void insertarAlFinal(T valor, int64_t instanteMs);
+
+    /**
+     * @brief Inserta un lote de lecturas llegadas en un mismo instante
+     */
+    void insertarLote(const T* valores, int cantidad, int64_t instanteMs) {
+        for (int i = 0; i < cantidad; i++) {
+            insertarAlFinal(valores[i], instanteMs);
+        }
+    }
+
+    /**
+     * @brief Inserta un lote de lecturas con el instante actual
+     */
+    void insertarLote(const T* valores, int cantidad) {
+        insertarLote(valores, cantidad, instanteActualMs());
+    }
+
+    /**
+     * @brief Inserta lecturas con su propio instante de llegada
+     */
+    void insertarTramo(const T* valores, const int64_t* instantes, int cantidad) {
+        for (int i = 0; i < cantidad; i++) {
+            insertarAlFinal(valores[i], instantes[i]);
+        }
+    }
+
+    /**
+     * @brief Aplica una función a cada lectura, en orden de llegada
+     * @param funcion Invocable con un argumento T
+     */
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const {
+        for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            actual->recorrer([&funcion](T valor, int64_t) { funcion(valor); });
+        }
+    }
+
+    /**
+     * @brief Aplica una función a cada lectura con su instante de llegada
+     * @param funcion Invocable con argumentos (T valor, int64_t instanteMs)
+     */
+    template <typename Funcion>
+    void recorrerConInstante(Funcion funcion) const {
+        for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            actual->recorrer(funcion);
+        }
+    }
+
+    /**
+     * @brief Aplica una función a las lecturas llegadas en [desdeMs, hastaMs)
+     *
+     * Los bloques que quedan fuera del intervalo se saltan sin descomprimir.
+     */
+    template <typename Funcion>
+    void recorrerRango(int64_t desdeMs, int64_t hastaMs, Funcion funcion) const {
+        for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            if (actual->instanteUltimo < desdeMs) {
+                continue;
+            }
+            if (actual->instantePrimero >= hastaMs) {
+                return;
+            }
+            actual->recorrer([&](T valor, int64_t instante) {
+                if (instante >= desdeMs && instante < hastaMs) {
+                    funcion(valor);
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Cuenta las lecturas llegadas en [desdeMs, hastaMs)
+     */
+    int contarEnRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    /**
+     * @brief Promedio de las lecturas llegadas en [desdeMs, hastaMs)
+     */
+    T calcularPromedioRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    T calcularPromedio() const { return agregados.promedio(); }
+    double calcularVarianza() const { return agregados.varianza(); }
+    double calcularDesviacionEstandar() const { return agregados.desviacionEstandar(); }
+
+    /**
+     * @brief Valor mínimo, a partir del mínimo de cada bloque
+     */
+    T encontrarMinimo() const;
+
+    /**
+     * @brief Elimina la lectura con el valor mínimo (la más antigua ante empates)
+     * @return Valor eliminado
+     */
+    T eliminarMinimo();
+
+    int obtenerTamano() const { return tamano; }
+    int obtenerNumeroBloques() const { return numBloques; }
+    bool estaVacia() const { return tamano == 0; }
+
+    /**
+     * @brief Memoria ocupada por los bloques
+     * @return Bytes de estructuras y flujos
+     */
+    size_t obtenerBytes() const;
+
+    /**
+     * @brief Imprime todas las lecturas, en orden de llegada
+     */
+    void imprimir() const;
+
+    /**
+     * @brief Libera todos los bloques
+     */
+    void limpiar();
+
+private:
+    HistorialComprimido(const HistorialComprimido&);
+    HistorialComprimido& operator=(const HistorialComprimido&);
+};
+
+// ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
+
+template <typename T>
+void HistorialComprimido<T>::insertarAlFinal(T valor, int64_t instanteMs) {
+    if (cola != nullptr && instanteMs < cola->instanteUltimo) {
+        instanteMs = cola->instanteUltimo;
+    }
+
+    if (cola == nullptr || cola->cuenta == LECTURAS_POR_BLOQUE) {
+        Bloque* nuevo = new Bloque;
+        if (cola == nullptr) {
+            cabeza = nuevo;
+        } else {
+            cola->flujo.recortar();  // El bloque lleno ya no crece
+            cola->siguiente = nuevo;
+        }
+        cola = nuevo;
+        numBloques++;
+    }
+
+    cola->agregar(valor, instanteMs);
+    tamano++;
+    agregados.agregar(valor);
+}
+
+template <typename T>
+int HistorialComprimido<T>::contarEnRango(int64_t desdeMs, int64_t hastaMs) const {
+    int cuenta = 0;
+    for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        if (actual->instanteUltimo < desdeMs) {
+            continue;
+        }
+        if (actual->instantePrimero >= hastaMs) {
+            break;
+        }
+        if (actual->instantePrimero >= desdeMs && actual->instanteUltimo < hastaMs) {
+            cuenta += actual->cuenta;  // Bloque entero dentro: sin descomprimir
+            continue;
+        }
+        actual->recorrer([&](T, int64_t instante) {
+            if (instante >= desdeMs && instante < hastaMs) {
+                cuenta++;
+            }
+        });
+    }
+    return cuenta;
+}
+
+template <typename T>
+T HistorialComprimido<T>::calcularPromedioRango(int64_t desdeMs, int64_t hastaMs) const {
+    AgregadosLecturas<T> agregadosRango;
+    recorrerRango(desdeMs, hastaMs, [&agregadosRango](T valor) { agregadosRango.agregar(valor); });
+    return agregadosRango.promedio();
+}
+
+template <typename T>
+typename HistorialComprimido<T>::Bloque*
+HistorialComprimido<T>::bloqueDelMinimo(Bloque*& anterior) const {
+    Bloque* mejor = cabeza;
+    anterior = nullptr;
+    Bloque* previo = cabeza;
+    for (Bloque* actual = cabeza->siguiente; actual != nullptr; actual = actual->siguiente) {
+        if (actual->minimo < mejor->minimo) {
+            mejor = actual;
+            anterior = previo;
+        }
+        previo = actual;
+    }
+    return mejor;
+}
+
+template <typename T>
+T HistorialComprimido<T>::encontrarMinimo() const {
+    if (cabeza == nullptr) {
+        throw std::runtime_error("Lista vacía - no se puede encontrar mínimo");
+    }
+    Bloque* anterior;
+    return bloqueDelMinimo(anterior)->minimo;
+}
+
+template <typename T>
+T HistorialComprimido<T>::eliminarMinimo() {
+    if (cabeza == nullptr) {
+        throw std::runtime_error("Lista vacía - no se puede eliminar mínimo");
+    }
+
+    Bloque* anterior;
+    Bloque* bloque = bloqueDelMinimo(anterior);
+    T minimo = bloque->minimo;
+
+    // Descomprime el bloque, salta la primera aparición del mínimo y lo
+    // vuelve a comprimir
+    T valores[LECTURAS_POR_BLOQUE];
+    int64_t instantes[LECTURAS_POR_BLOQUE];
+    int n = 0;
+    bloque->recorrer([&](T valor, int64_t instante) {
+        valores[n] = valor;
+        instantes[n] = instante;
+        n++;
+    });
+
+    bloque->reiniciar();
+    bool quitado = false;
+    for (int i = 0; i < n; i++) {
+        if (!quitado && !(minimo < valores[i]) && !(valores[i] < minimo)) {
+            quitado = true;
+            continue;
+        }
+        bloque->agregar(valores[i], instantes[i]);
+    }
+    tamano--;
+    agregados.quitar(minimo);
+
+    if (bloque->cuenta == 0) {
+        if (anterior == nullptr) {
+            cabeza = bloque->siguiente;
+        } else {
+            anterior->siguiente = bloque->siguiente;
+        }
+        if (bloque == cola) {
+            cola = anterior;
+        }
+        delete bloque;
+        numBloques--;
+    } else if (bloque != cola) {
+        bloque->flujo.recortar();
+    }
+    return minimo;
+}
+
+template <typename T>
+size_t HistorialComprimido<T>::obtenerBytes() const {
+    size_t total = 0;
+    for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        total += actual->obtenerBytes();
+    }
+    return total;
+}
+
+template <typename T>
+void HistorialComprimido<T>::imprimir() const {
+    std::cout << "[";
+    bool primero = true;
+    recorrer([&primero](T valor) {
+        if (!primero) {
+            std::cout << ", ";
+        }
+        std::cout << valor;
+        primero = false;
+    });
+    std::cout << "]\n";
+}
+
+template <typename T>
+void HistorialComprimido<T>::limpiar() {
+    while (cabeza != nullptr) {
+        Bloque* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        delete temp;
+    }
+    cola = nullptr;
+    tamano = 0;
+    numBloques = 0;
+    agregados.reiniciar();
+}
+
+#endif // HISTORIALCOMPRIMIDO_H
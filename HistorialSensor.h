@@ -0,0 +1,285 @@
+/**
+ * @file HistorialSensor.h
+ * @brief Historial de un sensor en cualquiera de sus modos de almacenamiento
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef HISTORIALSENSOR_H
+#define HISTORIALSENSOR_H
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include "HistorialCircular.h"
+#include "HistorialComprimido.h"
+#include "ListaSensorDesenrollada.h"
+
+/**
+ * @class HistorialSensor
+ * @brief Reúne los tres modos de historial y elige el vigente en un solo sitio
+ * @tparam T Tipo de las lecturas (float, int)
+ *
+ * Un sensor guarda sus lecturas en bloques sin límite, en una ventana
+ * acotada (HistorialCircular) o comprimidas (HistorialComprimido). Las
+ * tres estructuras ofrecen las mismas operaciones, así que el sensor no
+ * pregunta por el modo: pasa la operación a aplicar(), que es el único
+ * lugar donde se decide sobre qué estructura se ejecuta. Un modo nuevo
+ * solo exige tocar aplicar(), acotar()/comprimir() y describir().
+ *
+ * No es segura para hilos: el sensor la protege con su cerrojo de historial.
+ */
+template <typename T>
+class HistorialSensor {
+private:
+    ListaSensorDesenrollada<T> bloques;  ///< Historial sin límite (si no hay otro modo)
+    HistorialCircular<T>* ventana;       ///< Historial acotado (nullptr = sin límite)
+    HistorialComprimido<T>* comprimido;  ///< Historial comprimido (nullptr = sin comprimir)
+
+    /// Inserta una lectura en el historial vigente
+    struct InsertarLectura {
+        T valor;
+        int64_t instante;
+        InsertarLectura(T valor, int64_t instante) : valor(valor), instante(instante) {}
+        template <typename Historial>
+        void operator()(Historial& historial) const { historial.insertarAlFinal(valor, instante); }
+    };
+
+    /// Inserta un lote con un mismo instante en el historial vigente
+    struct InsertarLote {
+        const T* valores;
+        int cantidad;
+        int64_t instante;
+        InsertarLote(const T* valores, int cantidad, int64_t instante)
+            : valores(valores), cantidad(cantidad), instante(instante) {}
+        template <typename Historial>
+        void operator()(Historial& historial) const { historial.insertarLote(valores, cantidad, instante); }
+    };
+
+    /// Inserta un tramo con su instante por lectura en el historial vigente
+    struct InsertarTramo {
+        const T* valores;
+        const int64_t* instantes;
+        int cantidad;
+        InsertarTramo(const T* valores, const int64_t* instantes, int cantidad)
+            : valores(valores), instantes(instantes), cantidad(cantidad) {}
+        template <typename Historial>
+        void operator()(Historial& historial) const { historial.insertarTramo(valores, instantes, cantidad); }
+    };
+
+    /// Recorre el historial vigente en orden de llegada
+    template <typename Funcion>
+    struct Recorrer {
+        Funcion& funcion;
+        explicit Recorrer(Funcion& funcion) : funcion(funcion) {}
+        template <typename Historial>
+        void operator()(const Historial& historial) const { historial.recorrer(funcion); }
+    };
+
+    /// Recorre el historial vigente con el instante de cada lectura
+    template <typename Funcion>
+    struct RecorrerConInstante {
+        Funcion& funcion;
+        explicit RecorrerConInstante(Funcion& funcion) : funcion(funcion) {}
+        template <typename Historial>
+        void operator()(const Historial& historial) const { historial.recorrerConInstante(funcion); }
+    };
+
+    /// Número de lecturas del historial vigente
+    struct Tamano {
+        int& tamano;
+        explicit Tamano(int& tamano) : tamano(tamano) {}
+        template <typename Historial>
+        void operator()(const Historial& historial) const { tamano = historial.obtenerTamano(); }
+    };
+
+    /**
+     * @brief Pasa las lecturas del historial vigente a otro, en orden y con su instante
+     *
+     * El origen queda vacío.
+     */
+    template <typename Destino>
+    struct TrasladarA {
+        Destino& destino;
+        explicit TrasladarA(Destino& destino) : destino(destino) {}
+        template <typename Origen>
+        void operator()(Origen& origen) const {
+            Destino& hacia = destino;
+            origen.recorrerConInstante([&hacia](T valor, int64_t instante) {
+                hacia.insertarAlFinal(valor, instante);
+            });
+            origen.limpiar();
+        }
+    };
+
+    // No copiable: es dueña de la ventana y del historial comprimido
+    HistorialSensor(const HistorialSensor&);
+    HistorialSensor& operator=(const HistorialSensor&);
+
+public:
+    HistorialSensor() : ventana(nullptr), comprimido(nullptr) {}
+
+    ~HistorialSensor() {
+        delete ventana;
+        delete comprimido;
+    }
+
+    /**
+     * @brief Ejecuta una operación sobre el historial vigente
+     * @param funcion Objeto invocable con cualquiera de los tres historiales
+     */
+    template <typename Funcion>
+    void aplicar(Funcion&& funcion) {
+        if (ventana != nullptr) {
+            funcion(*ventana);
+        } else if (comprimido != nullptr) {
+            funcion(*comprimido);
+        } else {
+            funcion(bloques);
+        }
+    }
+
+    /**
+     * @brief Versión de solo lectura de aplicar()
+     */
+    template <typename Funcion>
+    void aplicar(Funcion&& funcion) const {
+        if (ventana != nullptr) {
+            funcion(static_cast<const HistorialCircular<T>&>(*ventana));
+        } else if (comprimido != nullptr) {
+            funcion(static_cast<const HistorialComprimido<T>&>(*comprimido));
+        } else {
+            funcion(bloques);
+        }
+    }
+
+    void insertarAlFinal(T valor, int64_t instante) {
+        aplicar(InsertarLectura(valor, instante));
+    }
+
+    void insertarLote(const T* valores, int cantidad, int64_t instante) {
+        aplicar(InsertarLote(valores, cantidad, instante));
+    }
+
+    void insertarTramo(const T* valores, const int64_t* instantes, int cantidad) {
+        aplicar(InsertarTramo(valores, instantes, cantidad));
+    }
+
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const {
+        aplicar(Recorrer<Funcion>(funcion));
+    }
+
+    template <typename Funcion>
+    void recorrerConInstante(Funcion funcion) const {
+        aplicar(RecorrerConInstante<Funcion>(funcion));
+    }
+
+    int obtenerTamano() const {
+        int tamano = 0;
+        aplicar(Tamano(tamano));
+        return tamano;
+    }
+
+    /**
+     * @brief Retira de la ventana las lecturas que ya salieron de ella
+     * @param ahora Instante actual (reloj monotónico, ms)
+     *
+     * Sin ventana no hace nada. Es const porque solo aplica la retención
+     * configurada: lo que retira ya no formaba parte del historial.
+     */
+    void descartarAntiguas(int64_t ahora) const {
+        if (ventana != nullptr) {
+            ventana->descartarAntiguas(ahora);
+        }
+    }
+
+    /**
+     * @brief Acota el historial o lo deja sin límite
+     * @param maxLecturas Lecturas retenidas como máximo (0 = sin límite)
+     * @param ventanaMs Antigüedad máxima en milisegundos (0 = sin límite)
+     *
+     * Las lecturas previas entran en orden y con su instante: si no caben
+     * o ya salieron de la ventana de tiempo, quedan las últimas.
+     */
+    void acotar(int maxLecturas, int64_t ventanaMs) {
+        if (maxLecturas <= 0) {
+            // Vuelta al historial ilimitado con lo que hubiera en la ventana
+            if (ventana != nullptr) {
+                TrasladarA<ListaSensorDesenrollada<T> > haciaBloques(bloques);
+                haciaBloques(*ventana);
+                delete ventana;
+                ventana = nullptr;
+            }
+            return;
+        }
+
+        HistorialCircular<T>* nueva = new HistorialCircular<T>(maxLecturas, ventanaMs);
+        aplicar(TrasladarA<HistorialCircular<T> >(*nueva));
+        delete ventana;
+        delete comprimido;
+        ventana = nueva;
+        comprimido = nullptr;
+    }
+
+    /**
+     * @brief Pasa el historial a (o desde) su forma comprimida
+     * @param activar true para comprimir, false para volver a bloques sin comprimir
+     *
+     * Comprimir deja el historial sin límite: entra todo lo retenido.
+     */
+    void comprimir(bool activar) {
+        if (!activar) {
+            if (comprimido != nullptr) {
+                TrasladarA<ListaSensorDesenrollada<T> > haciaBloques(bloques);
+                haciaBloques(*comprimido);
+                delete comprimido;
+                comprimido = nullptr;
+            }
+            return;
+        }
+        if (comprimido != nullptr) {
+            return;
+        }
+
+        HistorialComprimido<T>* nuevo = new HistorialComprimido<T>;
+        aplicar(TrasladarA<HistorialComprimido<T> >(*nuevo));
+        delete ventana;
+        ventana = nullptr;
+        comprimido = nuevo;
+    }
+
+    /**
+     * @brief Ventana vigente (nullptr si el historial no está acotado)
+     */
+    const HistorialCircular<T>* obtenerVentana() const {
+        return ventana;
+    }
+
+    bool estaComprimido() const {
+        return comprimido != nullptr;
+    }
+
+    /**
+     * @brief Imprime la retención o la compresión vigente (nada si no hay límite)
+     */
+    void describir(std::ostream& salida) const {
+        if (ventana != nullptr) {
+            salida << "Retención: últimas " << ventana->obtenerCapacidad() << " lecturas";
+            if (ventana->obtenerVentanaMs() > 0) {
+                salida << ", " << ventana->obtenerVentanaMs() / 1000.0 << " s como máximo";
+            }
+            salida << "\n";
+        } else if (comprimido != nullptr) {
+            salida << "Historial comprimido: " << comprimido->obtenerBytes() << " bytes";
+            if (!comprimido->estaVacia()) {
+                salida << " (" << std::fixed << std::setprecision(2)
+                       << static_cast<double>(comprimido->obtenerBytes()) / comprimido->obtenerTamano()
+                       << " bytes/lectura)";
+            }
+            salida << "\n";
+        }
+    }
+};
+
+#endif // HISTORIALSENSOR_H
@@ -0,0 +1,178 @@
+/**
+ * @file ImportadorCaptura.cpp
+ * @brief Implementación de la importación masiva de tramas
+ */
+
+#include "ImportadorCaptura.h"
+#include "ArchivoProyectado.h"
+#include "ListaGestion.h"
+#include "Log.h"
+#include "PoolTrabajo.h"
+#include "SensorBase.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+const size_t ImportadorCaptura::TAMANO_TRAMO;
+const int ImportadorCaptura::TRAMOS_POR_HILO;
+
+ImportadorCaptura::ImportadorCaptura(ListaGestion& lista, int hilos)
+    : lista(lista), tramos(nullptr), numTramos(0), pool(new PoolTrabajo(hilos)) {
+    for (int i = 0; i < 26; i++) {
+        rutas[i] = nullptr;
+    }
+    numTramos = pool->obtenerNumeroHilos() * TRAMOS_POR_HILO;
+    tramos = new TramoArchivo[numTramos];
+    for (int t = 0; t < numTramos; t++) {
+        for (int i = 0; i < 26; i++) {
+            tramos[t].lecturas[i] = nullptr;
+            tramos[t].capacidad[i] = 0;
+        }
+    }
+}
+
+ImportadorCaptura::~ImportadorCaptura() {
+    for (int t = 0; t < numTramos; t++) {
+        for (int i = 0; i < 26; i++) {
+            delete[] tramos[t].lecturas[i];
+        }
+    }
+    delete[] tramos;
+    delete pool;
+}
+
+void ImportadorCaptura::analizarTramo(TramoArchivo& tramo) {
+    AnalizadorTramas analizador;
+    LecturaTrama lectura;
+
+    for (int i = 0; i < 26; i++) {
+        tramo.cantidad[i] = 0;
+    }
+    analizador.alimentar(tramo.inicio, static_cast<size_t>(tramo.fin - tramo.inicio));
+    for (int vuelta = 0; vuelta < 2; vuelta++) {
+        while (analizador.siguiente(lectura)) {
+            int i = lectura.tipo - 'A';
+            if (i < 0 || i >= 26) {
+                continue;  // AnalizadorTramas solo entrega letras, pero por si acaso
+            }
+            if (tramo.cantidad[i] == tramo.capacidad[i]) {
+                size_t nueva = tramo.capacidad[i] == 0 ? 1024 : tramo.capacidad[i] * 2;
+                LecturaTrama* mayor = new LecturaTrama[nueva];
+                if (tramo.cantidad[i] > 0) {
+                    memcpy(mayor, tramo.lecturas[i], tramo.cantidad[i] * sizeof(LecturaTrama));
+                }
+                delete[] tramo.lecturas[i];
+                tramo.lecturas[i] = mayor;
+                tramo.capacidad[i] = nueva;
+            }
+            tramo.lecturas[i][tramo.cantidad[i]++] = lectura;
+        }
+        // Solo el último tramo puede acabar sin '\n': se completa la línea
+        if (vuelta == 0 && tramo.fin > tramo.inicio && tramo.fin[-1] != '\n') {
+            analizador.alimentar("\n", 1);
+        } else {
+            break;
+        }
+    }
+
+    tramo.tramas = analizador.obtenerTramasValidas();
+    tramo.ignoradas = analizador.obtenerLineasIgnoradas();
+    tramo.descartadas = analizador.obtenerLineasDescartadas();
+}
+
+SensorBase* ImportadorCaptura::obtenerRuta(int indice) {
+    if (rutas[indice] == nullptr) {
+        char tipo = static_cast<char>('A' + indice);
+        // "T-001" puede ser ya un sensor de otra clase: se usa el primer número libre
+        char nombre[16];
+        int numero = 1;
+        do {
+            snprintf(nombre, sizeof(nombre), "%c-%03d", tipo, numero++);
+        } while (lista.buscarSensor(nombre) != nullptr);
+        SensorBase* nuevo = SensorBase::crearDeTipo(tipo, nombre);
+        if (nuevo != nullptr) {
+            lista.insertarSensor(nuevo);
+            rutas[indice] = nuevo;
+            estadisticas.sensoresCreados++;
+            LOG_INFO("[Importación] Sensor " << nombre << " creado para las tramas '"
+                     << tipo << "'.\n");
+        }
+    }
+    return rutas[indice];
+}
+
+void ImportadorCaptura::registrarTramo(const TramoArchivo& tramo) {
+    for (int i = 0; i < 26; i++) {
+        if (tramo.cantidad[i] == 0) {
+            continue;
+        }
+        SensorBase* sensor = obtenerRuta(i);
+        if (sensor != nullptr) {
+            sensor->registrarLoteTramas(tramo.lecturas[i], tramo.cantidad[i]);
+            estadisticas.registradas += tramo.cantidad[i];
+        } else {
+            estadisticas.sinDestino += tramo.cantidad[i];
+        }
+    }
+    estadisticas.tramas += tramo.tramas;
+    estadisticas.ignoradas += tramo.ignoradas;
+    estadisticas.descartadas += tramo.descartadas;
+}
+
+bool ImportadorCaptura::importar(const char* ruta) {
+    std::chrono::steady_clock::time_point comienzo = std::chrono::steady_clock::now();
+    estadisticas = EstadisticasImportacion();
+    estadisticas.hilos = pool->obtenerNumeroHilos();
+
+    ArchivoProyectado archivo;
+    ArchivoProyectado::Estado estado = archivo.abrir(ruta);
+    if (estado != ArchivoProyectado::ABIERTO) {
+        LOG_ERROR("[Importación] No se pudo "
+                  << (estado == ArchivoProyectado::NO_EXISTE ? "encontrar" : "leer")
+                  << " " << ruta << ".\n");
+        return false;
+    }
+
+    // Las rutas se resuelven al empezar, como en CanalizacionCaptura: por la
+    // clase del sensor (obtenerTipo()), no por la inicial de su nombre
+    for (int i = 0; i < 26; i++) {
+        rutas[i] = lista.buscarPorTipo(static_cast<char>('A' + i));
+    }
+
+    const char* cursor = archivo.obtenerDatos();
+    const char* finArchivo = cursor + archivo.obtenerLongitud();
+    estadisticas.bytes = archivo.obtenerLongitud();
+
+    std::function<void(int)> tarea = [this](int t) { analizarTramo(tramos[t]); };
+    while (cursor < finArchivo) {
+        // Corta la siguiente ronda de tramos en límites de línea
+        int enRonda = 0;
+        while (enRonda < numTramos && cursor < finArchivo) {
+            const char* fin = finArchivo;
+            if (static_cast<size_t>(finArchivo - cursor) > TAMANO_TRAMO) {
+                const char* corte = cursor + TAMANO_TRAMO;
+                const void* salto = memchr(corte, '\n', static_cast<size_t>(finArchivo - corte));
+                fin = salto != nullptr ? static_cast<const char*>(salto) + 1 : finArchivo;
+            }
+            tramos[enRonda].inicio = cursor;
+            tramos[enRonda].fin = fin;
+            cursor = fin;
+            enRonda++;
+        }
+
+        pool->ejecutar(enRonda, tarea);
+        for (int t = 0; t < enRonda; t++) {
+            registrarTramo(tramos[t]);
+        }
+    }
+
+    estadisticas.segundos = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - comienzo).count();
+    LOG_INFO("[Importación] " << estadisticas.registradas << " lecturas de " << ruta
+             << " en " << estadisticas.segundos << " s.\n");
+    return true;
+}
+
+EstadisticasImportacion ImportadorCaptura::obtenerEstadisticas() const {
+    return estadisticas;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file ImportadorCaptura.h
+ * @brief Importación masiva de un archivo de tramas capturadas
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef IMPORTADORCAPTURA_H
+#define IMPORTADORCAPTURA_H
+
+#include "AnalizadorTramas.h"
+#include <cstddef>
+
+class ListaGestion;
+class PoolTrabajo;
+class SensorBase;
+
+/**
+ * @brief Resultado de una importación
+ */
+struct EstadisticasImportacion {
+    size_t bytes;                  ///< Tamaño del archivo
+    unsigned long tramas;          ///< Tramas válidas encontradas
+    unsigned long registradas;     ///< Tramas entregadas a un sensor
+    unsigned long sinDestino;      ///< Tramas de un tipo sin sensor (ni creable)
+    unsigned long ignoradas;       ///< Líneas que no eran tramas
+    unsigned long descartadas;     ///< Líneas demasiado largas
+    int sensoresCreados;           ///< Sensores creados por prefijo
+    int hilos;                     ///< Hilos de análisis usados
+    double segundos;               ///< Duración total (análisis y registro)
+
+    EstadisticasImportacion()
+        : bytes(0), tramas(0), registradas(0), sinDestino(0), ignoradas(0),
+          descartadas(0), sensoresCreados(0), hilos(0), segundos(0.0) {}
+
+    /// Tramas registradas por segundo
+    double tramasPorSegundo() const { return segundos > 0.0 ? registradas / segundos : 0.0; }
+
+    /// Megabytes (10^6) del archivo leídos por segundo
+    double megabytesPorSegundo() const { return segundos > 0.0 ? bytes / segundos / 1e6 : 0.0; }
+};
+
+/**
+ * @class ImportadorCaptura
+ * @brief Carga en los sensores un archivo con tramas "TIPO:VALOR\n"
+ *
+ * Sirve para rellenar historiales con capturas guardadas y para medir el
+ * rendimiento de ingesta sin el Arduino de por medio:
+ *
+ * 1. El archivo se proyecta en memoria (ArchivoProyectado), sin copiarlo.
+ * 2. Se corta en tramos de TAMANO_TRAMO bytes, cada uno ajustado para
+ *    terminar en un '\n', de modo que ninguna trama queda partida.
+ * 3. Los tramos se analizan en paralelo (PoolTrabajo), cada uno con su
+ *    propio AnalizadorTramas, separando las lecturas por letra de tipo.
+ * 4. Los tramos analizados se registran en orden de archivo con
+ *    registrarLoteTramas(): cada sensor recibe sus lecturas en el mismo
+ *    orden que aparecen en el archivo.
+ *
+ * Se procesan TRAMOS_POR_HILO tramos por hilo a la vez, así la memoria
+ * intermedia no crece con el archivo. Cada letra va al sensor cuya clase
+ * la declara (SensorBase::obtenerTipo()), sea cual sea su nombre. Las
+ * letras sin sensor de esa clase crean uno ('T' → SensorTemperatura
+ * "T-001", 'P' → SensorPresion "P-001", o el primer número libre si el
+ * nombre ya está ocupado); las demás letras se cuentan como sin destino.
+ * Como en la captura, todas las lecturas de un lote llevan el instante
+ * de su registro, no uno leído del archivo.
+ */
+class ImportadorCaptura {
+public:
+    static const size_t TAMANO_TRAMO = 1024 * 1024;  ///< Bytes por tramo de análisis
+    static const int TRAMOS_POR_HILO = 4;            ///< Tramos en vuelo por hilo
+
+private:
+    /**
+     * @brief Tramo del archivo y las lecturas extraídas de él
+     */
+    struct TramoArchivo {
+        const char* inicio;             ///< Primer byte del tramo
+        const char* fin;                ///< Tras el último '\n' del tramo
+        LecturaTrama* lecturas[26];     ///< Lecturas por letra de tipo
+        size_t cantidad[26];            ///< Lecturas válidas por letra
+        size_t capacidad[26];           ///< Tamaño de cada arreglo
+        unsigned long tramas;           ///< Tramas válidas del tramo
+        unsigned long ignoradas;        ///< Líneas que no eran tramas
+        unsigned long descartadas;      ///< Líneas demasiado largas
+    };
+
+    ListaGestion& lista;          ///< Sensores destino
+    SensorBase* rutas[26];        ///< Sensor por letra de tipo ('A'..'Z')
+    TramoArchivo* tramos;         ///< Tramos en vuelo (se reutilizan)
+    int numTramos;                ///< Tamaño de tramos
+    PoolTrabajo* pool;            ///< Hilos de análisis
+    EstadisticasImportacion estadisticas;  ///< Resultado de la última importación
+
+    /**
+     * @brief Extrae las lecturas de un tramo (se llama desde el pool)
+     * @param tramo Tramo a analizar; solo lo toca un hilo
+     */
+    static void analizarTramo(TramoArchivo& tramo);
+
+    /**
+     * @brief Entrega las lecturas de un tramo analizado a sus sensores
+     */
+    void registrarTramo(const TramoArchivo& tramo);
+
+    /**
+     * @brief Sensor de una letra, creándolo si el tipo es conocido
+     * @param indice Letra de tipo - 'A'
+     * @return Sensor destino o nullptr
+     */
+    SensorBase* obtenerRuta(int indice);
+
+public:
+    /**
+     * @brief Constructor
+     * @param lista Lista de sensores (debe vivir más que el importador)
+     * @param hilos Hilos de análisis (0 = núcleos disponibles)
+     */
+    ImportadorCaptura(ListaGestion& lista, int hilos = 0);
+
+    /**
+     * @brief Destructor - Libera tramos e hilos
+     */
+    ~ImportadorCaptura();
+
+    /**
+     * @brief Importa todas las tramas de un archivo
+     * @param ruta Archivo de captura
+     * @return false si el archivo no existe o no se pudo leer
+     *
+     * Puede llamarse con otros hilos registrando lecturas: cada sensor
+     * protege su historial.
+     */
+    bool importar(const char* ruta);
+
+    /**
+     * @brief Obtiene el resultado de la última importación
+     */
+    EstadisticasImportacion obtenerEstadisticas() const;
+
+    ImportadorCaptura(const ImportadorCaptura&) = delete;
+    ImportadorCaptura& operator=(const ImportadorCaptura&) = delete;
+};
+
+#endif // IMPORTADORCAPTURA_H
@@ -0,0 +1,258 @@
+/**
+ * @file InstantaneaGestion.cpp
+ * @brief Implementación del guardado y la carga de instantáneas
+ */
+
+#include "InstantaneaGestion.h"
+#include "ArchivoProyectado.h"
+#include "FormatoInstantanea.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Firma al principio de todo archivo de instantánea
+const char FIRMA[8] = {'I', 'O', 'T', 'S', 'N', 'A', 'P', '1'};
+
+/// Largo máximo de un nombre (SensorBase guarda char[50])
+const uint16_t MAX_NOMBRE = 49;
+
+/**
+ * @brief Hora Unix actual en milisegundos
+ */
+int64_t horaUnixMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Fuerza a disco el contenido de un archivo ya cerrado
+ */
+bool sincronizarArchivo(const std::string& ruta) {
+#ifndef _WIN32
+    int descriptor = open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool correcto = fsync(descriptor) == 0;
+    close(descriptor);
+    return correcto;
+#else
+    (void)ruta;
+    return true;
+#endif
+}
+
+} // namespace
+
+const uint32_t InstantaneaGestion::VERSION;
+const uint32_t InstantaneaGestion::MARCA_ORDEN;
+
+InstantaneaGestion::InstantaneaGestion(ListaGestion& lista, const char* ruta)
+    : lista(lista), ruta(ruta), diario(nullptr), guardadas(0), detener(false) {
+}
+
+InstantaneaGestion::~InstantaneaGestion() {
+    detenerGuardadoPeriodico();
+}
+
+void InstantaneaGestion::asociarDiario(DiarioLecturas* destino) {
+    std::lock_guard<std::mutex> guarda(cerrojoGuardado);
+    diario = destino;
+}
+
+bool InstantaneaGestion::guardar() {
+    std::lock_guard<std::mutex> guarda(cerrojoGuardado);
+    if (diario != nullptr) {
+        // Lo anotado hasta aquí quedará cubierto por esta instantánea
+        diario->rotar();
+    }
+    std::string temporal = ruta + ".tmp";
+    std::ofstream salida(temporal.c_str(), std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        LOG_AVISO("[Instantánea] No se pudo crear " << temporal << ".\n");
+        return false;
+    }
+
+    salida.write(FIRMA, sizeof(FIRMA));
+    FormatoInstantanea::escribir<uint32_t>(salida, VERSION);
+    FormatoInstantanea::escribir<uint32_t>(salida, MARCA_ORDEN);
+    std::streampos posicionCuenta = salida.tellp();
+    FormatoInstantanea::escribir<uint32_t>(salida, 0);
+    FormatoInstantanea::escribir<int64_t>(salida, horaUnixMs());
+
+    uint32_t sensores = 0;
+    lista.recorrerSensores([&](const SensorBase* sensor) {
+        uint16_t largoNombre = static_cast<uint16_t>(strlen(sensor->obtenerNombre()));
+        FormatoInstantanea::escribir<char>(salida, sensor->obtenerTipo());
+        FormatoInstantanea::escribir<uint16_t>(salida, largoNombre);
+        salida.write(sensor->obtenerNombre(), largoNombre);
+
+        // El largo del cuerpo se conoce al terminar de escribirlo
+        std::streampos posicionLargo = salida.tellp();
+        FormatoInstantanea::escribir<uint64_t>(salida, 0);
+        sensor->guardarEstado(salida);
+        std::streampos posicionFin = salida.tellp();
+        salida.seekp(posicionLargo);
+        FormatoInstantanea::escribir<uint64_t>(
+            salida, static_cast<uint64_t>(posicionFin - posicionLargo) - sizeof(uint64_t));
+        salida.seekp(posicionFin);
+        sensores++;
+    });
+    salida.seekp(posicionCuenta);
+    FormatoInstantanea::escribir<uint32_t>(salida, sensores);
+    salida.close();
+
+    if (!salida || !sincronizarArchivo(temporal)) {
+        LOG_AVISO("[Instantánea] Error al escribir " << temporal << ".\n");
+        std::remove(temporal.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(ruta.c_str());  // rename() no reemplaza en Windows
+#endif
+    if (std::rename(temporal.c_str(), ruta.c_str()) != 0) {
+        LOG_AVISO("[Instantánea] No se pudo reemplazar " << ruta << ".\n");
+        std::remove(temporal.c_str());
+        return false;
+    }
+    if (diario != nullptr) {
+        diario->descartarAnterior();
+    }
+    guardadas++;
+    LOG_INFO("[Instantánea] " << sensores << " sensores guardados en " << ruta << ".\n");
+    return true;
+}
+
+int InstantaneaGestion::cargar() {
+    ArchivoProyectado archivo;
+    ArchivoProyectado::Estado estado = archivo.abrir(ruta.c_str());
+    if (estado == ArchivoProyectado::NO_EXISTE) {
+        return 0;
+    }
+    int restaurados = estado == ArchivoProyectado::ABIERTO
+                          ? restaurar(archivo.obtenerDatos(), archivo.obtenerLongitud()) : -1;
+    if (restaurados < 0) {
+        LOG_AVISO("[Instantánea] " << ruta << " no es una instantánea válida.\n");
+    } else {
+        LOG_INFO("[Instantánea] " << restaurados << " sensores restaurados de " << ruta << ".\n");
+    }
+    return restaurados;
+}
+
+int InstantaneaGestion::restaurar(const char* datos, size_t longitud) {
+    LectorInstantanea lector(datos, datos + longitud);
+    const char* firma = lector.tomar(sizeof(FIRMA));
+    uint32_t version;
+    uint32_t marca;
+    uint32_t sensores;
+    int64_t creacion;
+    if (firma == nullptr || memcmp(firma, FIRMA, sizeof(FIRMA)) != 0 ||
+        !lector.leer(version) || version != VERSION ||
+        !lector.leer(marca) || marca != MARCA_ORDEN ||
+        !lector.leer(sensores) || !lector.leer(creacion)) {
+        return -1;
+    }
+
+    // Cada registro ocupa al menos tipo + largo del nombre + largo del cuerpo
+    const size_t REGISTRO_MINIMO = sizeof(char) + sizeof(uint16_t) + sizeof(uint64_t);
+    if (sensores > lector.restantes() / REGISTRO_MINIMO) {
+        return -1;
+    }
+
+    // Primero se restaura todo fuera de la lista: si un registro es
+    // inválido, el archivo se rechaza entero sin haber insertado nada
+    SensorBase** pendientes = new SensorBase*[sensores > 0 ? sensores : 1];
+    int restaurados = 0;
+    bool valido = true;
+    for (uint32_t i = 0; i < sensores; i++) {
+        char tipo;
+        uint16_t largoNombre;
+        uint64_t largoCuerpo;
+        const char* nombre;
+        const char* cuerpo;
+        if (!lector.leer(tipo) || !lector.leer(largoNombre) || largoNombre > MAX_NOMBRE ||
+            (nombre = lector.tomar(largoNombre)) == nullptr ||
+            !lector.leer(largoCuerpo) || (cuerpo = lector.tomar(largoCuerpo)) == nullptr) {
+            valido = false;
+            break;
+        }
+
+        char nombreSensor[MAX_NOMBRE + 1];
+        memcpy(nombreSensor, nombre, largoNombre);
+        nombreSensor[largoNombre] = '\0';
+        bool repetido = lista.buscarSensor(nombreSensor) != nullptr;
+        for (int j = 0; j < restaurados && !repetido; j++) {
+            repetido = strcmp(pendientes[j]->obtenerNombre(), nombreSensor) == 0;
+        }
+        if (repetido) {
+            LOG_AVISO("[Instantánea] " << nombreSensor << " ya existe; se omite.\n");
+            continue;
+        }
+        SensorBase* sensor = SensorBase::crearDeTipo(tipo, nombreSensor);
+        if (sensor == nullptr) {
+            LOG_AVISO("[Instantánea] Tipo de sensor desconocido '" << tipo << "'; se omite.\n");
+            continue;
+        }
+        if (!sensor->restaurarEstado(cuerpo, static_cast<size_t>(largoCuerpo))) {
+            delete sensor;
+            valido = false;
+            break;
+        }
+        pendientes[restaurados++] = sensor;
+    }
+
+    if (!valido || !lector.alFinal()) {
+        for (int j = 0; j < restaurados; j++) {
+            delete pendientes[j];
+        }
+        delete[] pendientes;
+        return -1;
+    }
+    for (int j = 0; j < restaurados; j++) {
+        lista.insertarSensor(pendientes[j]);
+    }
+    delete[] pendientes;
+    return restaurados;
+}
+
+void InstantaneaGestion::iniciarGuardadoPeriodico(int64_t periodoMs) {
+    detenerGuardadoPeriodico();
+    detener = false;
+    hiloPeriodico = std::thread(&InstantaneaGestion::buclePeriodico, this, periodoMs);
+}
+
+void InstantaneaGestion::detenerGuardadoPeriodico() {
+    if (!hiloPeriodico.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guarda(cerrojoPeriodico);
+        detener = true;
+    }
+    avisoDetener.notify_one();
+    hiloPeriodico.join();
+}
+
+void InstantaneaGestion::buclePeriodico(int64_t periodoMs) {
+    std::unique_lock<std::mutex> guarda(cerrojoPeriodico);
+    while (!avisoDetener.wait_for(guarda, std::chrono::milliseconds(periodoMs),
+                                  [this] { return detener; })) {
+        guarda.unlock();
+        guardar();
+        guarda.lock();
+    }
+}
+
+unsigned long InstantaneaGestion::obtenerGuardadas() {
+    std::lock_guard<std::mutex> guarda(cerrojoGuardado);
+    return guardadas;
+}
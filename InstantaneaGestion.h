@@ -0,0 +1,133 @@
+/**
+ * @file InstantaneaGestion.h
+ * @brief Guardado y carga del estado de todos los sensores en un archivo binario
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef INSTANTANEAGESTION_H
+#define INSTANTANEAGESTION_H
+
+#include "ListaGestion.h"
+#include "DiarioLecturas.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class InstantaneaGestion
+ * @brief Persistencia de una ListaGestion en un archivo de instantánea
+ *
+ * Archivo (valores en el orden de bytes de la máquina):
+ *
+ *     char[8] "IOTSNAP1"   uint32 versión   uint32 0x01020304 (marca de orden)
+ *     uint32 sensores      int64 creación (hora Unix en ms)
+ *     por sensor: uint8 tipo, uint16 largo del nombre, nombre,
+ *                 uint64 largo del cuerpo, cuerpo (FormatoInstantanea)
+ *
+ * guardar() escribe en "ruta.tmp", lo sincroniza a disco y lo renombra
+ * sobre la ruta: si el proceso cae a mitad, queda la instantánea anterior
+ * entera. Cada sensor se vuelca con su propio cerrojo tomado, de modo que
+ * la captura sigue mientras se guarda; la instantánea es coherente por
+ * sensor, no entre sensores.
+ *
+ * cargar() proyecta el archivo con mmap y restaura cada sensor leyendo
+ * directamente de la proyección: las lecturas se copian por columnas,
+ * un bloque de historial cada vez, sin analizar texto.
+ *
+ * Con un diario asociado, guardar() lo rota antes de empezar y, si la
+ * instantánea queda en disco, descarta el tramo rotado: todo lo que
+ * contenía ya está en la instantánea.
+ */
+class InstantaneaGestion {
+private:
+    ListaGestion& lista;     ///< Sensores a guardar y restaurar
+    std::string ruta;        ///< Archivo de la instantánea
+    DiarioLecturas* diario;  ///< Diario a recortar tras cada guardado (opcional)
+
+    std::mutex cerrojoGuardado;     ///< Serializa guardar()
+    unsigned long guardadas;        ///< Instantáneas escritas con éxito
+
+    std::thread hiloPeriodico;              ///< Guardado periódico (si está activo)
+    std::mutex cerrojoPeriodico;            ///< Protege detener
+    std::condition_variable avisoDetener;   ///< Despierta al hilo periódico
+    bool detener;                           ///< Pide al hilo periódico que salga
+
+    /**
+     * @brief Restaura los registros de una instantánea ya en memoria
+     * @param datos Contenido del archivo
+     * @param longitud Bytes del archivo
+     * @return Sensores restaurados o -1 si el archivo no es válido (sin insertar ninguno)
+     */
+    int restaurar(const char* datos, size_t longitud);
+
+    /**
+     * @brief Cuerpo del hilo de guardado periódico
+     * @param periodoMs Milisegundos entre guardados
+     */
+    void buclePeriodico(int64_t periodoMs);
+
+public:
+    static const uint32_t VERSION = 2;             ///< Versión del formato (2: con secuencia)
+    static const uint32_t MARCA_ORDEN = 0x01020304u;  ///< Detecta otro orden de bytes
+
+    /**
+     * @brief Constructor
+     * @param lista Lista de sensores (debe vivir más que la instantánea)
+     * @param ruta Archivo donde guardar y desde donde cargar
+     */
+    InstantaneaGestion(ListaGestion& lista, const char* ruta);
+
+    /**
+     * @brief Destructor - Detiene el guardado periódico
+     */
+    ~InstantaneaGestion();
+
+    /**
+     * @brief Asocia el diario de lecturas que cada guardado deja obsoleto
+     * @param destino Diario abierto, o nullptr
+     */
+    void asociarDiario(DiarioLecturas* destino);
+
+    /**
+     * @brief Escribe el estado de todos los sensores
+     * @return true si la instantánea quedó en disco
+     *
+     * Puede llamarse mientras otros hilos registran lecturas.
+     */
+    bool guardar();
+
+    /**
+     * @brief Restaura los sensores guardados en la ruta
+     * @return Sensores restaurados, 0 si no hay archivo, -1 si está dañado
+     *
+     * Los sensores se crean e insertan en la lista; si ya existe uno con
+     * el mismo nombre, el guardado se omite. Todos los registros se
+     * validan antes de insertar ninguno: un archivo dañado deja la lista
+     * como estaba.
+     */
+    int cargar();
+
+    /**
+     * @brief Guarda en segundo plano cada cierto tiempo
+     * @param periodoMs Milisegundos entre guardados (> 0)
+     */
+    void iniciarGuardadoPeriodico(int64_t periodoMs);
+
+    /**
+     * @brief Detiene el guardado periódico (sin guardar una última vez)
+     */
+    void detenerGuardadoPeriodico();
+
+    /**
+     * @brief Número de instantáneas escritas con éxito
+     */
+    unsigned long obtenerGuardadas();
+
+    InstantaneaGestion(const InstantaneaGestion&) = delete;
+    InstantaneaGestion& operator=(const InstantaneaGestion&) = delete;
+};
+
+#endif // INSTANTANEAGESTION_H
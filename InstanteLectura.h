@@ -0,0 +1,44 @@
+/**
+ * @file InstanteLectura.h
+ * @brief Reloj común para fechar las lecturas de los historiales
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef INSTANTELECTURA_H
+#define INSTANTELECTURA_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Instante actual en milisegundos del reloj monotónico
+ * @return Milisegundos de steady_clock (solo sirve para comparar instantes)
+ *
+ * Los historiales fechan cada lectura con este reloj: no retrocede aunque
+ * se cambie la hora del sistema, así que las lecturas quedan ordenadas.
+ */
+inline int64_t instanteActualMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Diferencia entre el reloj del sistema y el de instanteActualMs()
+ * @return Milisegundos a sumar a un instante para pasarlo a hora Unix
+ *
+ * El reloj monotónico empieza de nuevo con cada arranque del equipo: lo
+ * que se guarda en disco (InstantaneaGestion, DiarioLecturas) se pasa a
+ * hora Unix con este desfase y, al cargarlo, se vuelve al reloj
+ * monotónico actual. Se mide una sola vez por proceso, de modo que un
+ * instante guardado y vuelto a cargar en el mismo proceso no cambia (dos
+ * mediciones pueden diferir en 1 ms por el redondeo).
+ */
+inline int64_t desfaseRelojSistemaMs() {
+    static const int64_t desfase =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() - instanteActualMs();
+    return desfase;
+}
+
+#endif // INSTANTELECTURA_H
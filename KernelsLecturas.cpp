@@ -0,0 +1,688 @@
+/**
+ * @file KernelsLecturas.cpp
+ * @brief Implementaciones escalar, SSE4.1 y AVX2 de los núcleos y su selección
+ */
+
+#include "KernelsLecturas.h"
+#include <atomic>
+#include <limits>
+
+#if !defined(IOT_SIN_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IOT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Punteros a una implementación completa de los núcleos
+ */
+struct TablaKernels {
+    double (*sumarReal)(const float*, int);
+    int64_t (*sumarEntero)(const int*, int);
+    double (*cuadradosReal)(const float*, int);
+    double (*cuadradosEntero)(const int*, int);
+    float (*minimoReal)(const float*, int);
+    int (*minimoEntero)(const int*, int);
+    float (*maximoReal)(const float*, int);
+    int (*maximoEntero)(const int*, int);
+    int (*primeraIgualReal)(const float*, int, float);
+    int (*primeraIgualEntero)(const int*, int, int);
+};
+
+// ========== ESCALAR ==========
+
+double sumarRealEscalar(const float* d, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+int64_t sumarEnteroEscalar(const int* d, int n) {
+    int64_t s = 0;
+    for (int i = 0; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+double cuadradosRealEscalar(const float* d, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+double cuadradosEnteroEscalar(const int* d, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+float minimoRealEscalar(const float* d, int n) {
+    float m = d[0];
+    for (int i = 1; i < n; i++) {
+        if (d[i] < m || m != m) {  // Un NaN nunca es el mínimo
+            m = d[i];
+        }
+    }
+    return m;
+}
+
+int minimoEnteroEscalar(const int* d, int n) {
+    int m = d[0];
+    for (int i = 1; i < n; i++) {
+        if (d[i] < m) {
+            m = d[i];
+        }
+    }
+    return m;
+}
+
+float maximoRealEscalar(const float* d, int n) {
+    float m = d[0];
+    for (int i = 1; i < n; i++) {
+        if (m < d[i] || m != m) {  // Un NaN nunca es el máximo
+            m = d[i];
+        }
+    }
+    return m;
+}
+
+int maximoEnteroEscalar(const int* d, int n) {
+    int m = d[0];
+    for (int i = 1; i < n; i++) {
+        if (m < d[i]) {
+            m = d[i];
+        }
+    }
+    return m;
+}
+
+int primeraIgualRealEscalar(const float* d, int n, float valor) {
+    for (int i = 0; i < n; i++) {
+        if (d[i] == valor) {
+            return i;
+        }
+    }
+    return n;
+}
+
+int primeraIgualEnteroEscalar(const int* d, int n, int valor) {
+    for (int i = 0; i < n; i++) {
+        if (d[i] == valor) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Posición del menor valor que no es NaN (n - 1 si todos lo son)
+ *
+ * Camino de respaldo de indiceMinimo(): un NaN no es igual a nada, así
+ * que si el mínimo vectorial sale NaN la búsqueda por igualdad no lo
+ * encuentra y devolvería n.
+ */
+int indiceMinimoRealEscalar(const float* d, int n) {
+    int indice = 0;
+    for (int i = 1; i < n; i++) {
+        if (d[i] < d[indice] || d[indice] != d[indice]) {
+            indice = i;
+        }
+    }
+    return indice;
+}
+
+const TablaKernels TABLA_ESCALAR = {
+    sumarRealEscalar, sumarEnteroEscalar, cuadradosRealEscalar, cuadradosEnteroEscalar,
+    minimoRealEscalar, minimoEnteroEscalar, maximoRealEscalar, maximoEnteroEscalar,
+    primeraIgualRealEscalar, primeraIgualEnteroEscalar
+};
+
+#ifdef IOT_KERNELS_X86
+
+// ========== SSE4.1 (4 lecturas por instrucción) ==========
+// Las sumas de float se convierten a double de dos en dos; las de int a
+// int64_t, igual que el acumulador escalar.
+
+__attribute__((target("sse4.1")))
+double sumarRealSse(const float* d, int n) {
+    __m128d a0 = _mm_setzero_pd();
+    __m128d a1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(d + i);
+        a0 = _mm_add_pd(a0, _mm_cvtps_pd(v));
+        a1 = _mm_add_pd(a1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    double t[2];
+    _mm_storeu_pd(t, _mm_add_pd(a0, a1));
+    double s = t[0] + t[1];
+    for (; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+__attribute__((target("sse4.1")))
+int64_t sumarEnteroSse(const int* d, int n) {
+    __m128i a = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        a = _mm_add_epi64(a, _mm_cvtepi32_epi64(v));
+        a = _mm_add_epi64(a, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    int64_t t[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(t), a);
+    int64_t s = t[0] + t[1];
+    for (; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+__attribute__((target("sse4.1")))
+double cuadradosRealSse(const float* d, int n) {
+    __m128d a0 = _mm_setzero_pd();
+    __m128d a1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(d + i);
+        __m128d bajo = _mm_cvtps_pd(v);
+        __m128d alto = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        a0 = _mm_add_pd(a0, _mm_mul_pd(bajo, bajo));
+        a1 = _mm_add_pd(a1, _mm_mul_pd(alto, alto));
+    }
+    double t[2];
+    _mm_storeu_pd(t, _mm_add_pd(a0, a1));
+    double s = t[0] + t[1];
+    for (; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+__attribute__((target("sse4.1")))
+double cuadradosEnteroSse(const int* d, int n) {
+    __m128d a0 = _mm_setzero_pd();
+    __m128d a1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        __m128d bajo = _mm_cvtepi32_pd(v);
+        __m128d alto = _mm_cvtepi32_pd(_mm_srli_si128(v, 8));
+        a0 = _mm_add_pd(a0, _mm_mul_pd(bajo, bajo));
+        a1 = _mm_add_pd(a1, _mm_mul_pd(alto, alto));
+    }
+    double t[2];
+    _mm_storeu_pd(t, _mm_add_pd(a0, a1));
+    double s = t[0] + t[1];
+    for (; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+__attribute__((target("sse4.1")))
+float minimoRealSse(const float* d, int n) {
+    if (n < 4) {
+        return minimoRealEscalar(d, n);
+    }
+    // min_ps devuelve su segundo operando si hay un NaN: con el acumulado
+    // en segundo lugar (nunca NaN) los NaN de los datos se pasan por alto
+    const float neutro = std::numeric_limits<float>::infinity();
+    __m128 m = _mm_set1_ps(neutro);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_min_ps(_mm_loadu_ps(d + i), m);
+    }
+    float t[4];
+    _mm_storeu_ps(t, m);
+    float r = minimoRealEscalar(t, 4);
+    if (r == neutro) {
+        return minimoRealEscalar(d, n);  // Todo NaN o infinito: decide el bucle escalar
+    }
+    for (; i < n; i++) {
+        if (d[i] < r) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("sse4.1")))
+int minimoEnteroSse(const int* d, int n) {
+    if (n < 4) {
+        return minimoEnteroEscalar(d, n);
+    }
+    __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_min_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i)));
+    }
+    int t[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(t), m);
+    int r = minimoEnteroEscalar(t, 4);
+    for (; i < n; i++) {
+        if (d[i] < r) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("sse4.1")))
+float maximoRealSse(const float* d, int n) {
+    if (n < 4) {
+        return maximoRealEscalar(d, n);
+    }
+    // max_ps devuelve su segundo operando si hay un NaN: con el acumulado
+    // en segundo lugar (nunca NaN) los NaN de los datos se pasan por alto
+    const float neutro = -std::numeric_limits<float>::infinity();
+    __m128 m = _mm_set1_ps(neutro);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_max_ps(_mm_loadu_ps(d + i), m);
+    }
+    float t[4];
+    _mm_storeu_ps(t, m);
+    float r = maximoRealEscalar(t, 4);
+    if (r == neutro) {
+        return maximoRealEscalar(d, n);  // Todo NaN o infinito: decide el bucle escalar
+    }
+    for (; i < n; i++) {
+        if (r < d[i]) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("sse4.1")))
+int maximoEnteroSse(const int* d, int n) {
+    if (n < 4) {
+        return maximoEnteroEscalar(d, n);
+    }
+    __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm_max_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i)));
+    }
+    int t[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(t), m);
+    int r = maximoEnteroEscalar(t, 4);
+    for (; i < n; i++) {
+        if (r < d[i]) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("sse4.1")))
+int primeraIgualRealSse(const float* d, int n, float valor) {
+    __m128 buscado = _mm_set1_ps(valor);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mascara = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(d + i), buscado));
+        if (mascara != 0) {
+            return i + __builtin_ctz(static_cast<unsigned>(mascara));
+        }
+    }
+    return i + primeraIgualRealEscalar(d + i, n - i, valor);
+}
+
+__attribute__((target("sse4.1")))
+int primeraIgualEnteroSse(const int* d, int n, int valor) {
+    __m128i buscado = _mm_set1_epi32(valor);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        int mascara = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, buscado)));
+        if (mascara != 0) {
+            return i + __builtin_ctz(static_cast<unsigned>(mascara));
+        }
+    }
+    return i + primeraIgualEnteroEscalar(d + i, n - i, valor);
+}
+
+const TablaKernels TABLA_SSE41 = {
+    sumarRealSse, sumarEnteroSse, cuadradosRealSse, cuadradosEnteroSse,
+    minimoRealSse, minimoEnteroSse, maximoRealSse, maximoEnteroSse,
+    primeraIgualRealSse, primeraIgualEnteroSse
+};
+
+// ========== AVX2 (8 lecturas por instrucción) ==========
+
+__attribute__((target("avx2")))
+double sumarRealAvx2(const float* d, int n) {
+    __m256d a0 = _mm256_setzero_pd();
+    __m256d a1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(d + i);
+        a0 = _mm256_add_pd(a0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        a1 = _mm256_add_pd(a1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    double t[4];
+    _mm256_storeu_pd(t, _mm256_add_pd(a0, a1));
+    double s = (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+__attribute__((target("avx2")))
+int64_t sumarEnteroAvx2(const int* d, int n) {
+    __m256i a0 = _mm256_setzero_si256();
+    __m256i a1 = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i bajo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        __m128i alto = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i + 4));
+        a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(bajo));
+        a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(alto));
+    }
+    int64_t t[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(t), _mm256_add_epi64(a0, a1));
+    int64_t s = t[0] + t[1] + t[2] + t[3];
+    for (; i < n; i++) {
+        s += d[i];
+    }
+    return s;
+}
+
+__attribute__((target("avx2")))
+double cuadradosRealAvx2(const float* d, int n) {
+    __m256d a0 = _mm256_setzero_pd();
+    __m256d a1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(d + i);
+        __m256d bajo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d alto = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(bajo, bajo));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(alto, alto));
+    }
+    double t[4];
+    _mm256_storeu_pd(t, _mm256_add_pd(a0, a1));
+    double s = (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+__attribute__((target("avx2")))
+double cuadradosEnteroAvx2(const int* d, int n) {
+    __m256d a0 = _mm256_setzero_pd();
+    __m256d a1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d bajo = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i)));
+        __m256d alto = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i + 4)));
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(bajo, bajo));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(alto, alto));
+    }
+    double t[4];
+    _mm256_storeu_pd(t, _mm256_add_pd(a0, a1));
+    double s = (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i < n; i++) {
+        s += static_cast<double>(d[i]) * static_cast<double>(d[i]);
+    }
+    return s;
+}
+
+__attribute__((target("avx2")))
+float minimoRealAvx2(const float* d, int n) {
+    if (n < 8) {
+        return minimoRealEscalar(d, n);
+    }
+    // min_ps devuelve su segundo operando si hay un NaN: con el acumulado
+    // en segundo lugar (nunca NaN) los NaN de los datos se pasan por alto
+    const float neutro = std::numeric_limits<float>::infinity();
+    __m256 m = _mm256_set1_ps(neutro);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_min_ps(_mm256_loadu_ps(d + i), m);
+    }
+    float t[8];
+    _mm256_storeu_ps(t, m);
+    float r = minimoRealEscalar(t, 8);
+    if (r == neutro) {
+        return minimoRealEscalar(d, n);  // Todo NaN o infinito: decide el bucle escalar
+    }
+    for (; i < n; i++) {
+        if (d[i] < r) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("avx2")))
+int minimoEnteroAvx2(const int* d, int n) {
+    if (n < 8) {
+        return minimoEnteroEscalar(d, n);
+    }
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d));
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)));
+    }
+    int t[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(t), m);
+    int r = minimoEnteroEscalar(t, 8);
+    for (; i < n; i++) {
+        if (d[i] < r) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("avx2")))
+float maximoRealAvx2(const float* d, int n) {
+    if (n < 8) {
+        return maximoRealEscalar(d, n);
+    }
+    // max_ps devuelve su segundo operando si hay un NaN: con el acumulado
+    // en segundo lugar (nunca NaN) los NaN de los datos se pasan por alto
+    const float neutro = -std::numeric_limits<float>::infinity();
+    __m256 m = _mm256_set1_ps(neutro);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_ps(_mm256_loadu_ps(d + i), m);
+    }
+    float t[8];
+    _mm256_storeu_ps(t, m);
+    float r = maximoRealEscalar(t, 8);
+    if (r == neutro) {
+        return maximoRealEscalar(d, n);  // Todo NaN o infinito: decide el bucle escalar
+    }
+    for (; i < n; i++) {
+        if (r < d[i]) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("avx2")))
+int maximoEnteroAvx2(const int* d, int n) {
+    if (n < 8) {
+        return maximoEnteroEscalar(d, n);
+    }
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d));
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i)));
+    }
+    int t[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(t), m);
+    int r = maximoEnteroEscalar(t, 8);
+    for (; i < n; i++) {
+        if (r < d[i]) {
+            r = d[i];
+        }
+    }
+    return r;
+}
+
+__attribute__((target("avx2")))
+int primeraIgualRealAvx2(const float* d, int n, float valor) {
+    __m256 buscado = _mm256_set1_ps(valor);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 iguales = _mm256_cmp_ps(_mm256_loadu_ps(d + i), buscado, _CMP_EQ_OQ);
+        int mascara = _mm256_movemask_ps(iguales);
+        if (mascara != 0) {
+            return i + __builtin_ctz(static_cast<unsigned>(mascara));
+        }
+    }
+    return i + primeraIgualRealEscalar(d + i, n - i, valor);
+}
+
+__attribute__((target("avx2")))
+int primeraIgualEnteroAvx2(const int* d, int n, int valor) {
+    __m256i buscado = _mm256_set1_epi32(valor);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        int mascara = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, buscado)));
+        if (mascara != 0) {
+            return i + __builtin_ctz(static_cast<unsigned>(mascara));
+        }
+    }
+    return i + primeraIgualEnteroEscalar(d + i, n - i, valor);
+}
+
+const TablaKernels TABLA_AVX2 = {
+    sumarRealAvx2, sumarEnteroAvx2, cuadradosRealAvx2, cuadradosEnteroAvx2,
+    minimoRealAvx2, minimoEnteroAvx2, maximoRealAvx2, maximoEnteroAvx2,
+    primeraIgualRealAvx2, primeraIgualEnteroAvx2
+};
+
+#endif // IOT_KERNELS_X86
+
+const TablaKernels& tablaPara(KernelsLecturas::Nivel nivel) {
+#ifdef IOT_KERNELS_X86
+    if (nivel == KernelsLecturas::AVX2) {
+        return TABLA_AVX2;
+    }
+    if (nivel == KernelsLecturas::SSE41) {
+        return TABLA_SSE41;
+    }
+#else
+    (void)nivel;
+#endif
+    return TABLA_ESCALAR;
+}
+
+std::atomic<const TablaKernels*> tablaActiva(nullptr);
+std::atomic<int> nivelElegido(-1);
+
+/**
+ * @brief Implementación en uso; se elige en la primera llamada
+ */
+const TablaKernels& tabla() {
+    const TablaKernels* actual = tablaActiva.load(std::memory_order_acquire);
+    if (actual == nullptr) {
+        KernelsLecturas::Nivel nivel = KernelsLecturas::nivelDisponible();
+        nivelElegido.store(nivel, std::memory_order_relaxed);
+        actual = &tablaPara(nivel);
+        tablaActiva.store(actual, std::memory_order_release);
+    }
+    return *actual;
+}
+
+} // namespace
+
+double KernelsLecturas::sumar(const float* datos, int n) {
+    return tabla().sumarReal(datos, n);
+}
+
+int64_t KernelsLecturas::sumar(const int* datos, int n) {
+    return tabla().sumarEntero(datos, n);
+}
+
+double KernelsLecturas::sumarCuadrados(const float* datos, int n) {
+    return tabla().cuadradosReal(datos, n);
+}
+
+double KernelsLecturas::sumarCuadrados(const int* datos, int n) {
+    return tabla().cuadradosEntero(datos, n);
+}
+
+float KernelsLecturas::minimo(const float* datos, int n) {
+    return tabla().minimoReal(datos, n);
+}
+
+int KernelsLecturas::minimo(const int* datos, int n) {
+    return tabla().minimoEntero(datos, n);
+}
+
+float KernelsLecturas::maximo(const float* datos, int n) {
+    return tabla().maximoReal(datos, n);
+}
+
+int KernelsLecturas::maximo(const int* datos, int n) {
+    return tabla().maximoEntero(datos, n);
+}
+
+int KernelsLecturas::indiceMinimo(const float* datos, int n) {
+    // Dos pasadas vectoriales: el valor mínimo y su primera aparición
+    const TablaKernels& t = tabla();
+    int indice = t.primeraIgualReal(datos, n, t.minimoReal(datos, n));
+    return indice < n ? indice : indiceMinimoRealEscalar(datos, n);
+}
+
+int KernelsLecturas::indiceMinimo(const int* datos, int n) {
+    const TablaKernels& t = tabla();
+    return t.primeraIgualEntero(datos, n, t.minimoEntero(datos, n));
+}
+
+KernelsLecturas::Nivel KernelsLecturas::nivelDisponible() {
+#ifdef IOT_KERNELS_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SSE41;
+    }
+#endif
+    return ESCALAR;
+}
+
+KernelsLecturas::Nivel KernelsLecturas::nivelActivo() {
+    tabla();
+    return static_cast<Nivel>(nivelElegido.load(std::memory_order_relaxed));
+}
+
+void KernelsLecturas::limitarNivel(Nivel maximo) {
+    Nivel nivel = nivelDisponible();
+    if (maximo < nivel) {
+        nivel = maximo;
+    }
+    nivelElegido.store(nivel, std::memory_order_relaxed);
+    tablaActiva.store(&tablaPara(nivel), std::memory_order_release);
+}
+
+const char* KernelsLecturas::nombreNivel(Nivel nivel) {
+    switch (nivel) {
+        case AVX2:
+            return "AVX2";
+        case SSE41:
+            return "SSE4.1";
+        default:
+            return "escalar";
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file KernelsLecturas.h
+ * @brief Núcleos vectoriales (SSE4.1/AVX2) de suma, mínimo y máximo sobre lecturas contiguas
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef KERNELSLECTURAS_H
+#define KERNELSLECTURAS_H
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Tipo de acumulador ancho para sumar lecturas de tipo T
+ *
+ * Los enteros se acumulan en int64_t (una suma de int desborda con
+ * historiales grandes) y los flotantes en double.
+ */
+template <typename T>
+struct AcumuladorAncho {
+    typedef typename std::conditional<std::is_integral<T>::value,
+                                      int64_t, double>::type tipo;
+};
+
+/**
+ * @class KernelsLecturas
+ * @brief Recorridos de tramos contiguos de lecturas con instrucciones SIMD
+ *
+ * Los historiales guardan las lecturas en arreglos contiguos (bloques de
+ * ListaSensorDesenrollada, buffer de HistorialCircular), así que las
+ * pasadas de suma, mínimo y búsqueda pueden procesar 4 u 8 lecturas por
+ * instrucción. Para float e int la implementación se elige una sola vez
+ * en tiempo de ejecución según la CPU (AVX2, SSE4.1 o escalar); otros
+ * tipos usan las plantillas escalares.
+ *
+ * Los resultados coinciden con el bucle escalar: las sumas de float se
+ * acumulan en double y las de int en int64_t, como AgregadosLecturas.
+ * El orden de las sumas de double cambia, así que el último bit puede
+ * diferir. indiceMinimo() devuelve la primera posición del mínimo. En
+ * todos los niveles minimo(), maximo() e indiceMinimo() de float pasan
+ * por alto las lecturas NaN (solo dan NaN si todas lo son), y
+ * indiceMinimo() siempre devuelve una posición válida.
+ *
+ * Compilar con -DIOT_SIN_SIMD deja solo la versión escalar.
+ */
+class KernelsLecturas {
+public:
+    /**
+     * @brief Juego de instrucciones usado por los núcleos
+     */
+    enum Nivel {
+        ESCALAR = 0,  ///< Bucles escalares (cualquier CPU)
+        SSE41   = 1,  ///< 4 lecturas por instrucción
+        AVX2    = 2   ///< 8 lecturas por instrucción
+    };
+
+    /**
+     * @brief Suma de n lecturas
+     * @param datos Lecturas contiguas
+     * @param n Número de lecturas (puede ser 0)
+     */
+    static double sumar(const float* datos, int n);
+    static int64_t sumar(const int* datos, int n);
+
+    /**
+     * @brief Suma de los cuadrados de n lecturas, en double
+     */
+    static double sumarCuadrados(const float* datos, int n);
+    static double sumarCuadrados(const int* datos, int n);
+
+    /**
+     * @brief Menor de n lecturas (n >= 1)
+     */
+    static float minimo(const float* datos, int n);
+    static int minimo(const int* datos, int n);
+
+    /**
+     * @brief Mayor de n lecturas (n >= 1)
+     */
+    static float maximo(const float* datos, int n);
+    static int maximo(const int* datos, int n);
+
+    /**
+     * @brief Primera posición del mínimo de n lecturas (n >= 1)
+     * @return Siempre en [0, n), aunque haya lecturas NaN
+     */
+    static int indiceMinimo(const float* datos, int n);
+    static int indiceMinimo(const int* datos, int n);
+
+    // Versiones escalares para el resto de tipos
+
+    template <typename T>
+    static typename AcumuladorAncho<T>::tipo sumar(const T* datos, int n) {
+        typename AcumuladorAncho<T>::tipo suma = 0;
+        for (int i = 0; i < n; i++) {
+            suma += static_cast<typename AcumuladorAncho<T>::tipo>(datos[i]);
+        }
+        return suma;
+    }
+
+    template <typename T>
+    static double sumarCuadrados(const T* datos, int n) {
+        double suma = 0.0;
+        for (int i = 0; i < n; i++) {
+            suma += static_cast<double>(datos[i]) * static_cast<double>(datos[i]);
+        }
+        return suma;
+    }
+
+    template <typename T>
+    static T minimo(const T* datos, int n) {
+        return datos[indiceMinimo(datos, n)];
+    }
+
+    template <typename T>
+    static T maximo(const T* datos, int n) {
+        T mayor = datos[0];
+        for (int i = 1; i < n; i++) {
+            if (mayor < datos[i]) {
+                mayor = datos[i];
+            }
+        }
+        return mayor;
+    }
+
+    template <typename T>
+    static int indiceMinimo(const T* datos, int n) {
+        int indice = 0;
+        for (int i = 1; i < n; i++) {
+            if (datos[i] < datos[indice]) {
+                indice = i;
+            }
+        }
+        return indice;
+    }
+
+    /**
+     * @brief Mejor nivel que soportan la CPU y la compilación
+     */
+    static Nivel nivelDisponible();
+
+    /**
+     * @brief Nivel con que se están ejecutando los núcleos
+     */
+    static Nivel nivelActivo();
+
+    /**
+     * @brief Limita el nivel usado (para comparar implementaciones)
+     * @param maximo Nivel más alto permitido; se usa el menor entre este y el disponible
+     *
+     * No debe llamarse mientras otro hilo ejecuta los núcleos.
+     */
+    static void limitarNivel(Nivel maximo);
+
+    /**
+     * @brief Nombre legible de un nivel ("AVX2", "SSE4.1", "escalar")
+     */
+    static const char* nombreNivel(Nivel nivel);
+};
+
+#endif // KERNELSLECTURAS_H
@@ -4,61 +4,158 @@
  */
 
 #include "ListaGestion.h"
+#include "Log.h"
+#include "PoolTrabajo.h"
+#include <cctype>
 #include <cstring>
 #include <iostream>
+#include <new>
+#include <sstream>
 
-ListaGestion::ListaGestion() : cabeza(nullptr), tamano(0) {
-    std::cout << "[ListaGestion] Sistema de gestión inicializado.\n";
+ListaGestion::ListaGestion()
+    : cabeza(nullptr), cola(nullptr), tamano(0), indice(nullptr), pool(nullptr), diario(nullptr) {
+    LOG_INFO("[ListaGestion] Sistema de gestión inicializado.\n");
 }
 
 ListaGestion::~ListaGestion() {
-    std::cout << "\n--- Liberación de Memoria en Cascada ---\n";
+    LOG_INFO("\n--- Liberación de Memoria en Cascada ---\n");
     
     NodoSensor* actual = cabeza;
     while (actual != nullptr) {
         NodoSensor* temp = actual;
         actual = actual->siguiente;
         
-        std::cout << "[Destructor General] Liberando Nodo: " 
-                  << temp->sensor->obtenerNombre() << "\n";
+        LOG_INFO("[Destructor General] Liberando Nodo: "
+                 << temp->sensor->obtenerNombre() << "\n");
         
         // CRÍTICO: delete llama al destructor virtual, ejecutando
         // el destructor de la clase derivada correcta
         delete temp->sensor;
-        delete temp;
+        temp->~NodoSensor();
     }
+    // Los nodos se devuelven en bloque al destruirse la arena
+
+    // Tabla vigente y tablas retiradas: ya no quedan lectores
+    TablaIndice* tabla = indice.load(std::memory_order_relaxed);
+    while (tabla != nullptr) {
+        TablaIndice* anterior = tabla->anterior;
+        delete[] tabla->casillas;
+        delete tabla;
+        tabla = anterior;
+    }
+    delete pool;
     
-    std::cout << "Sistema cerrado. Memoria limpia.\n";
+    LOG_INFO("Sistema cerrado. Memoria limpia.\n");
 }
 
 void ListaGestion::insertarSensor(SensorBase* sensor) {
-    NodoSensor* nuevoNodo = new NodoSensor(sensor);
+    std::lock_guard<std::mutex> guarda(cerrojoRegistro);
+    if (diario != nullptr) {
+        sensor->conectarDiario(diario);
+    }
+
+    NodoSensor* nuevoNodo = new (asignadorNodos.reservar()) NodoSensor(sensor);
     
-    if (cabeza == nullptr) {
-        cabeza = nuevoNodo;
+    // El nodo ya está completo: publicarlo lo hace visible a los lectores
+    if (cola == nullptr) {
+        cabeza.store(nuevoNodo, std::memory_order_release);
     } else {
-        NodoSensor* actual = cabeza;
-        while (actual->siguiente != nullptr) {
-            actual = actual->siguiente;
-        }
-        actual->siguiente = nuevoNodo;
+        cola->siguiente.store(nuevoNodo, std::memory_order_release);
     }
+    cola = nuevoNodo;
     
-    tamano++;
-    std::cout << "[ListaGestion] Sensor '" << sensor->obtenerNombre() 
-              << "' insertado en la lista de gestión.\n";
+    int nuevoTamano = tamano.load(std::memory_order_relaxed) + 1;
+    tamano.store(nuevoTamano, std::memory_order_release);
+
+    // Mantiene el factor de carga del índice por debajo de 1/2
+    TablaIndice* tabla = indice.load(std::memory_order_relaxed);
+    if (tabla == nullptr || 2 * nuevoTamano > tabla->capacidad) {
+        crecerIndice();
+    } else {
+        indexarSensor(tabla, sensor);
+    }
+    LOG_INFO("[ListaGestion] Sensor '" << sensor->obtenerNombre()
+             << "' insertado en la lista de gestión.\n");
+}
+
+void ListaGestion::indexarSensor(TablaIndice* tabla, SensorBase* sensor) {
+    uint64_t hash = sensor->obtenerHashNombre();
+    int mascara = tabla->capacidad - 1;
+    int casilla = static_cast<int>(hash & static_cast<uint64_t>(mascara));
+
+    // Solo escribe el hilo de registro: sus propias lecturas van relajadas
+    SensorBase* ocupante;
+    while ((ocupante = tabla->casillas[casilla].load(std::memory_order_relaxed)) != nullptr) {
+        if (ocupante->obtenerHashNombre() == hash &&
+            strcmp(ocupante->obtenerNombre(), sensor->obtenerNombre()) == 0) {
+            return;  // Nombre repetido: se conserva el primero insertado
+        }
+        casilla = (casilla + 1) & mascara;
+    }
+    tabla->casillas[casilla].store(sensor, std::memory_order_release);
+}
+
+void ListaGestion::crecerIndice() {
+    TablaIndice* anterior = indice.load(std::memory_order_relaxed);
+
+    TablaIndice* tabla = new TablaIndice;
+    tabla->capacidad = anterior == nullptr ? 16 : anterior->capacidad * 2;
+    tabla->casillas = new std::atomic<SensorBase*>[tabla->capacidad];
+    for (int i = 0; i < tabla->capacidad; i++) {
+        tabla->casillas[i].store(nullptr, std::memory_order_relaxed);
+    }
+    tabla->anterior = anterior;
+
+    // Reindexa en orden de inserción para conservar "el primero gana"
+    for (NodoSensor* actual = cabeza.load(std::memory_order_relaxed); actual != nullptr;
+         actual = actual->siguiente.load(std::memory_order_relaxed)) {
+        indexarSensor(tabla, actual->sensor);
+    }
+
+    // Los lectores que ya estaban en la tabla anterior pueden terminar en ella
+    indice.store(tabla, std::memory_order_release);
+}
+
+void ListaGestion::asociarDiario(DiarioLecturas* destino) {
+    std::lock_guard<std::mutex> guarda(cerrojoRegistro);
+    diario = destino;
+    recorrerSensores([destino](SensorBase* sensor) {
+        sensor->conectarDiario(destino);
+    });
 }
 
 SensorBase* ListaGestion::buscarSensor(const char* nombre) {
-    NodoSensor* actual = cabeza;
+    TablaIndice* tabla = indice.load(std::memory_order_acquire);
+    if (tabla == nullptr) {
+        return nullptr;
+    }
+
+    uint64_t hash = SensorBase::calcularHash(nombre);
+    int mascara = tabla->capacidad - 1;
+    int casilla = static_cast<int>(hash & static_cast<uint64_t>(mascara));
+
+    // Sondeo lineal hasta encontrar el nombre o una casilla libre
+    SensorBase* candidato;
+    while ((candidato = tabla->casillas[casilla].load(std::memory_order_acquire)) != nullptr) {
+        if (candidato->obtenerHashNombre() == hash &&
+            strcmp(candidato->obtenerNombre(), nombre) == 0) {
+            return candidato;
+        }
+        casilla = (casilla + 1) & mascara;
+    }
     
-    while (actual != nullptr) {
-        if (strcmp(actual->sensor->obtenerNombre(), nombre) == 0) {
+    return nullptr;
+}
+
+SensorBase* ListaGestion::buscarPorTipo(char tipo) {
+    char buscado = static_cast<char>(toupper(static_cast<unsigned char>(tipo)));
+    for (NodoSensor* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        // La clase decide qué tramas acepta, no el nombre ("Patio" puede
+        // ser un sensor de temperatura)
+        if (actual->sensor->obtenerTipo() == buscado) {
             return actual->sensor;
         }
-        actual = actual->siguiente;
     }
-    
     return nullptr;
 }
 
@@ -91,6 +188,52 @@ void ListaGestion::procesarTodosSensores() {
     std::cout << "\n========================================\n";
 }
 
+void ListaGestion::procesarTodosSensoresParalelo(int hilos, std::ostream& destino) {
+    if (cabeza == nullptr) {
+        destino << "[ListaGestion] No hay sensores para procesar.\n";
+        return;
+    }
+
+    if (pool == nullptr || (hilos > 0 && pool->obtenerNumeroHilos() != hilos)) {
+        delete pool;
+        pool = new PoolTrabajo(hilos);
+    }
+
+    // Los sensores se pasan a un arreglo para acceder por índice. Se toman
+    // los n primeros: los que se registren entre tanto quedan fuera
+    int n = tamano.load(std::memory_order_acquire);
+    SensorBase** sensores = new SensorBase*[n];
+    NodoSensor* actual = cabeza.load(std::memory_order_acquire);
+    for (int i = 0; i < n; i++) {
+        sensores[i] = actual->sensor;
+        actual = actual->siguiente.load(std::memory_order_acquire);
+    }
+
+    // Un buffer por sensor: los hilos nunca escriben en el destino
+    std::ostringstream* informes = new std::ostringstream[n];
+    pool->ejecutar(n, [n, sensores, informes](int i) {
+        informes[i] << "\n[" << (i + 1) << "/" << n << "] ";
+        sensores[i]->redirigirSalida(&informes[i]);
+        sensores[i]->procesarLectura();
+        sensores[i]->redirigirSalida(nullptr);
+    });
+
+    destino << "\n========================================\n";
+    destino << "  EJECUTANDO PROCESAMIENTO POLIMÓRFICO  \n";
+    destino << "========================================\n";
+    for (int i = 0; i < n; i++) {
+        destino << informes[i].str();
+    }
+    destino << "\n========================================\n";
+
+    LOG_INFO("[ListaGestion] " << n << " sensores procesados con "
+             << pool->obtenerNumeroHilos() << " hilos ("
+             << pool->obtenerRobos() << " robos de trabajo acumulados).\n");
+
+    delete[] informes;
+    delete[] sensores;
+}
+
 void ListaGestion::imprimirTodosSensores() const {
     if (cabeza == nullptr) {
         std::cout << "[ListaGestion] No hay sensores registrados.\n";
@@ -9,13 +9,19 @@
 #define LISTAGESTION_H
 
 #include "SensorBase.h"
+#include "AsignadorNodos.h"
+#include <atomic>
+#include <mutex>
+
+class PoolTrabajo;
+class DiarioLecturas;
 
 /**
  * @brief Nodo para almacenar punteros a SensorBase
  */
 struct NodoSensor {
     SensorBase* sensor;        ///< Puntero polimórfico a la clase base
-    NodoSensor* siguiente;     ///< Puntero al siguiente nodo
+    std::atomic<NodoSensor*> siguiente;  ///< Puntero al siguiente nodo (publicado con release)
 
     /**
      * @brief Constructor del nodo
@@ -31,11 +37,58 @@ struct NodoSensor {
  * Esta lista almacena punteros a SensorBase*, permitiendo almacenar
  * diferentes tipos de sensores (SensorTemperatura, SensorPresion, etc.)
  * en una única estructura de datos.
+ *
+ * Además de la lista, mantiene un índice hash de direccionamiento abierto
+ * (sondeo lineal) sobre los nombres, de modo que buscarSensor() resuelve
+ * un nombre en O(1) esperado en lugar de recorrer todos los nodos.
+ *
+ * Concurrencia (lecturas frecuentes, altas raras, sin bajas):
+ * - insertarSensor() se serializa con un mutex de registro.
+ * - Los recorridos y buscarSensor() no toman ningún cerrojo. Un nodo o una
+ *   casilla del índice solo se publican (store release) cuando el sensor
+ *   ya está construido, así que un lector ve el sensor completo o no lo ve.
+ * - Al crecer, el índice se reconstruye en una tabla nueva que se publica
+ *   de una vez; la anterior queda retirada, no liberada, porque puede
+ *   haber lectores recorriéndola. Las tablas retiradas (en total menos
+ *   que la actual) se liberan con la lista, como en un esquema RCU cuyo
+ *   periodo de gracia es la vida de la lista.
+ * El acceso al historial de cada sensor lo protege el propio sensor.
  */
 class ListaGestion {
 private:
-    NodoSensor* cabeza;  ///< Primer nodo de la lista
-    int tamano;          ///< Número de sensores en la lista
+    /**
+     * @brief Tabla hash del índice por nombre
+     */
+    struct TablaIndice {
+        std::atomic<SensorBase*>* casillas;  ///< nullptr = casilla libre
+        int capacidad;                       ///< Casillas (potencia de dos)
+        TablaIndice* anterior;               ///< Tabla retirada al crecer
+    };
+
+    std::atomic<NodoSensor*> cabeza;  ///< Primer nodo de la lista
+    NodoSensor* cola;    ///< Último nodo (solo lo usa insertarSensor())
+    std::atomic<int> tamano;          ///< Número de sensores en la lista
+    AsignadorArena<NodoSensor> asignadorNodos;  ///< Arena de los nodos de gestión
+    std::mutex cerrojoRegistro;       ///< Serializa insertarSensor()
+
+    std::atomic<TablaIndice*> indice;  ///< Tabla hash vigente (nullptr si vacía)
+
+    PoolTrabajo* pool;     ///< Hilos del procesamiento paralelo (se crea al usarlo)
+    DiarioLecturas* diario;  ///< Diario al que se conectan los sensores (lo protege cerrojoRegistro)
+
+    /**
+     * @brief Coloca un sensor en la tabla hash si su nombre no está ya
+     * @param tabla Tabla donde indexar
+     * @param sensor Sensor a indexar
+     */
+    static void indexarSensor(TablaIndice* tabla, SensorBase* sensor);
+
+    /**
+     * @brief Construye una tabla hash del doble de tamaño y la publica
+     *
+     * La tabla anterior se retira (sigue siendo legible) hasta destruir la lista.
+     */
+    void crecerIndice();
 
 public:
     /**
@@ -55,16 +108,42 @@ public:
     /**
      * @brief Inserta un nuevo sensor en la lista
      * @param sensor Puntero al sensor a insertar
+     *
+     * Puede llamarse mientras otros hilos buscan o recorren la lista.
      */
     void insertarSensor(SensorBase* sensor);
 
+    /**
+     * @brief Conecta todos los sensores, y los que se inserten después, a un diario
+     * @param destino Diario abierto, o nullptr para desconectarlos
+     *
+     * El diario debe vivir más que la conexión: antes de destruirlo hay
+     * que llamar a asociarDiario(nullptr).
+     */
+    void asociarDiario(DiarioLecturas* destino);
+
     /**
      * @brief Busca un sensor por nombre
      * @param nombre Nombre del sensor a buscar
      * @return Puntero al sensor o nullptr si no se encuentra
+     *
+     * Consulta el índice hash: compara primero el hash precalculado de
+     * cada candidato y solo hace strcmp cuando coincide. Con nombres
+     * repetidos devuelve el primer sensor insertado. No toma cerrojos.
      */
     SensorBase* buscarSensor(const char* nombre);
 
+    /**
+     * @brief Busca el primer sensor que recibe un tipo de trama
+     * @param tipo Letra de tipo de trama ('T', 'P', 'V', ...; sin distinguir mayúsculas)
+     * @return Puntero al sensor o nullptr si ninguno coincide
+     *
+     * Compara con SensorBase::obtenerTipo(), es decir, con la clase del
+     * sensor: las tramas 'P' nunca llegan a un SensorTemperatura, se
+     * llame como se llame.
+     */
+    SensorBase* buscarPorTipo(char tipo);
+
     /**
      * @brief Procesa todos los sensores de forma polimórfica
      * 
@@ -73,11 +152,42 @@ public:
      */
     void procesarTodosSensores();
 
+    /**
+     * @brief Procesa todos los sensores repartiéndolos entre varios hilos
+     * @param hilos Hilos a usar (0 = núcleos disponibles)
+     * @param destino Flujo donde imprimir los informes (std::cout por defecto)
+     *
+     * Cada sensor escribe su informe en un buffer propio y, al terminar
+     * todos, los informes se imprimen en el orden de la lista: la salida
+     * es idéntica a la de procesarTodosSensores(). El reparto es por robo
+     * de trabajo (PoolTrabajo), de modo que un sensor con un historial
+     * enorme no retiene a los que venían detrás.
+     *
+     * Los sensores registrados durante la llamada no se procesan. No debe
+     * ejecutarse a la vez que otro procesamiento de la misma lista.
+     */
+    void procesarTodosSensoresParalelo(int hilos = 0, std::ostream& destino = std::cout);
+
     /**
      * @brief Imprime información de todos los sensores
      */
     void imprimirTodosSensores() const;
 
+    /**
+     * @brief Aplica una función a cada sensor, en orden de inserción
+     * @param funcion Invocable con un argumento SensorBase*
+     *
+     * Sin cerrojos, como los demás recorridos: puede llamarse desde otro
+     * hilo mientras se insertan sensores (los nuevos pueden no verse).
+     */
+    template <typename Funcion>
+    void recorrerSensores(Funcion funcion) const {
+        for (NodoSensor* actual = cabeza.load(std::memory_order_acquire); actual != nullptr;
+             actual = actual->siguiente.load(std::memory_order_acquire)) {
+            funcion(actual->sensor);
+        }
+    }
+
     /**
      * @brief Obtiene el número de sensores en la lista
      * @return Número de sensores
@@ -9,6 +9,11 @@
 #define LISTASENSOR_H
 
 #include <iostream>
+#include <stdexcept>
+#include <typeinfo>
+#include "Log.h"
+#include "AsignadorNodos.h"
+#include "AgregadosLecturas.h"
 
 /**
  * @brief Estructura de nodo genérico para la lista enlazada
@@ -30,15 +35,34 @@ struct Nodo {
  * @class ListaSensor
  * @brief Lista Enlazada Simple Genérica para gestionar lecturas de sensores
  * @tparam T Tipo de dato de las lecturas
+ * @tparam Asignador Origen de la memoria de los nodos (arena por defecto)
  * 
  * Esta clase implementa manualmente una lista enlazada simple sin usar STL.
- * Gestiona la memoria de forma dinámica con punteros.
+ * Gestiona la memoria de forma dinámica con punteros. Cada lista tiene su
+ * propia arena, de modo que los nodos de un mismo sensor quedan contiguos
+ * y limpiar() libera bloques completos en lugar de nodo por nodo.
  */
-template <typename T>
+template <typename T, typename Asignador = AsignadorArena<Nodo<T> > >
 class ListaSensor {
 private:
     Nodo<T>* cabeza;  ///< Puntero al primer nodo de la lista
+    Nodo<T>* cola;    ///< Puntero al último nodo (inserción al final en O(1))
     int tamano;       ///< Número de elementos en la lista
+    Asignador asignador;  ///< Proveedor de memoria para los nodos
+    AgregadosLecturas<T> agregados;  ///< Suma, cuenta y suma de cuadrados
+
+    /**
+     * @brief Construye un nodo en memoria del asignador
+     * @param valor Valor del nodo
+     * @return Nodo nuevo
+     */
+    Nodo<T>* crearNodo(T valor);
+
+    /**
+     * @brief Destruye un nodo y devuelve su memoria al asignador
+     * @param nodo Nodo a destruir
+     */
+    void destruirNodo(Nodo<T>* nodo);
 
 public:
     /**
@@ -55,18 +79,20 @@ public:
      * @brief Constructor de copia (Regla de los Tres)
      * @param otra Lista a copiar
      */
-    ListaSensor(const ListaSensor<T>& otra);
+    ListaSensor(const ListaSensor& otra);
 
     /**
      * @brief Operador de asignación (Regla de los Tres)
      * @param otra Lista a asignar
      * @return Referencia a esta lista
      */
-    ListaSensor<T>& operator=(const ListaSensor<T>& otra);
+    ListaSensor& operator=(const ListaSensor& otra);
 
     /**
      * @brief Inserta un nuevo elemento al final de la lista
      * @param valor Valor a insertar
+     *
+     * Complejidad O(1): se enlaza directamente después de la cola.
      */
     void insertarAlFinal(T valor);
 
@@ -87,9 +113,23 @@ public:
     /**
      * @brief Calcula el promedio de todos los valores en la lista
      * @return Promedio como tipo T
+     *
+     * Complejidad O(1): usa la suma acumulada en lugar de recorrer la lista.
      */
     T calcularPromedio() const;
 
+    /**
+     * @brief Calcula la varianza poblacional de los valores
+     * @return Varianza (0 con menos de dos lecturas), en O(1)
+     */
+    double calcularVarianza() const;
+
+    /**
+     * @brief Calcula la desviación estándar poblacional de los valores
+     * @return Desviación estándar, en O(1)
+     */
+    double calcularDesviacionEstandar() const;
+
     /**
      * @brief Encuentra y retorna el valor mínimo en la lista
      * @return Valor mínimo encontrado
@@ -123,22 +163,39 @@ public:
      * @brief Libera toda la memoria de la lista
      */
     void limpiar();
+
+    /**
+     * @brief Obtiene los contadores del asignador de nodos
+     * @return Estadísticas de reservas y nodos entregados
+     */
+    const EstadisticasAsignador& obtenerEstadisticasMemoria() const;
 };
 
 // ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
 
-template <typename T>
-ListaSensor<T>::ListaSensor() : cabeza(nullptr), tamano(0) {
+template <typename T, typename Asignador>
+Nodo<T>* ListaSensor<T, Asignador>::crearNodo(T valor) {
+    return new (asignador.reservar()) Nodo<T>(valor);
 }
 
-template <typename T>
-ListaSensor<T>::~ListaSensor() {
+template <typename T, typename Asignador>
+void ListaSensor<T, Asignador>::destruirNodo(Nodo<T>* nodo) {
+    nodo->~Nodo<T>();
+    asignador.liberar(nodo);
+}
+
+template <typename T, typename Asignador>
+ListaSensor<T, Asignador>::ListaSensor() : cabeza(nullptr), cola(nullptr), tamano(0) {
+}
+
+template <typename T, typename Asignador>
+ListaSensor<T, Asignador>::~ListaSensor() {
     limpiar();
 }
 
-template <typename T>
-ListaSensor<T>::ListaSensor(const ListaSensor<T>& otra) : cabeza(nullptr), tamano(0) {
-    // Copia profunda de todos los nodos
+template <typename T, typename Asignador>
+ListaSensor<T, Asignador>::ListaSensor(const ListaSensor& otra) : cabeza(nullptr), cola(nullptr), tamano(0) {
+    // Copia profunda de todos los nodos (cada inserción es O(1) gracias a la cola)
     Nodo<T>* actual = otra.cabeza;
     while (actual != nullptr) {
         insertarAlFinal(actual->dato);
@@ -146,8 +203,8 @@ ListaSensor<T>::ListaSensor(const ListaSensor<T>& otra) : cabeza(nullptr), taman
     }
 }
 
-template <typename T>
-ListaSensor<T>& ListaSensor<T>::operator=(const ListaSensor<T>& otra) {
+template <typename T, typename Asignador>
+ListaSensor<T, Asignador>& ListaSensor<T, Asignador>::operator=(const ListaSensor& otra) {
     if (this != &otra) {
         limpiar();  // Libera memoria actual
         
@@ -161,28 +218,26 @@ ListaSensor<T>& ListaSensor<T>::operator=(const ListaSensor<T>& otra) {
     return *this;
 }
 
-template <typename T>
-void ListaSensor<T>::insertarAlFinal(T valor) {
-    Nodo<T>* nuevoNodo = new Nodo<T>(valor);
+template <typename T, typename Asignador>
+void ListaSensor<T, Asignador>::insertarAlFinal(T valor) {
+    Nodo<T>* nuevoNodo = crearNodo(valor);
     
     if (cabeza == nullptr) {
-        // Lista vacía - el nuevo nodo es la cabeza
+        // Lista vacía - el nuevo nodo es cabeza y cola a la vez
         cabeza = nuevoNodo;
     } else {
-        // Recorre hasta el último nodo
-        Nodo<T>* actual = cabeza;
-        while (actual->siguiente != nullptr) {
-            actual = actual->siguiente;
-        }
-        actual->siguiente = nuevoNodo;
+        // Enlaza directamente tras el último nodo, sin recorrer la lista
+        cola->siguiente = nuevoNodo;
     }
+    cola = nuevoNodo;
     
     tamano++;
-    std::cout << "[Log] Nodo<" << typeid(T).name() << "> insertado con valor: " << valor << "\n";
+    agregados.agregar(valor);
+    LOG_TRAZA("[Log] Nodo<" << typeid(T).name() << "> insertado con valor: " << valor << "\n");
 }
 
-template <typename T>
-bool ListaSensor<T>::eliminar(T valor) {
+template <typename T, typename Asignador>
+bool ListaSensor<T, Asignador>::eliminar(T valor) {
     if (cabeza == nullptr) {
         return false;
     }
@@ -191,9 +246,13 @@ bool ListaSensor<T>::eliminar(T valor) {
     if (cabeza->dato == valor) {
         Nodo<T>* temp = cabeza;
         cabeza = cabeza->siguiente;
-        delete temp;
+        if (cabeza == nullptr) {
+            cola = nullptr;  // Era el único nodo
+        }
+        destruirNodo(temp);
         tamano--;
-        std::cout << "[Log] Nodo con valor " << valor << " eliminado.\n";
+        agregados.quitar(valor);
+        LOG_TRAZA("[Log] Nodo con valor " << valor << " eliminado.\n");
         return true;
     }
     
@@ -203,9 +262,13 @@ bool ListaSensor<T>::eliminar(T valor) {
         if (actual->siguiente->dato == valor) {
             Nodo<T>* temp = actual->siguiente;
             actual->siguiente = temp->siguiente;
-            delete temp;
+            if (temp == cola) {
+                cola = actual;  // Se eliminó el último nodo
+            }
+            destruirNodo(temp);
             tamano--;
-            std::cout << "[Log] Nodo con valor " << valor << " eliminado.\n";
+            agregados.quitar(valor);
+            LOG_TRAZA("[Log] Nodo con valor " << valor << " eliminado.\n");
             return true;
         }
         actual = actual->siguiente;
@@ -214,8 +277,8 @@ bool ListaSensor<T>::eliminar(T valor) {
     return false;
 }
 
-template <typename T>
-bool ListaSensor<T>::buscar(T valor) const {
+template <typename T, typename Asignador>
+bool ListaSensor<T, Asignador>::buscar(T valor) const {
     Nodo<T>* actual = cabeza;
     while (actual != nullptr) {
         if (actual->dato == valor) {
@@ -226,25 +289,23 @@ bool ListaSensor<T>::buscar(T valor) const {
     return false;
 }
 
-template <typename T>
-T ListaSensor<T>::calcularPromedio() const {
-    if (cabeza == nullptr) {
-        return T(0);
-    }
-    
-    T suma = T(0);
-    Nodo<T>* actual = cabeza;
-    
-    while (actual != nullptr) {
-        suma += actual->dato;
-        actual = actual->siguiente;
-    }
-    
-    return suma / T(tamano);
+template <typename T, typename Asignador>
+T ListaSensor<T, Asignador>::calcularPromedio() const {
+    return agregados.promedio();
 }
 
-template <typename T>
-T ListaSensor<T>::encontrarMinimo() const {
+template <typename T, typename Asignador>
+double ListaSensor<T, Asignador>::calcularVarianza() const {
+    return agregados.varianza();
+}
+
+template <typename T, typename Asignador>
+double ListaSensor<T, Asignador>::calcularDesviacionEstandar() const {
+    return agregados.desviacionEstandar();
+}
+
+template <typename T, typename Asignador>
+T ListaSensor<T, Asignador>::encontrarMinimo() const {
     if (cabeza == nullptr) {
         throw std::runtime_error("Lista vacía - no se puede encontrar mínimo");
     }
@@ -262,8 +323,8 @@ T ListaSensor<T>::encontrarMinimo() const {
     return minimo;
 }
 
-template <typename T>
-T ListaSensor<T>::eliminarMinimo() {
+template <typename T, typename Asignador>
+T ListaSensor<T, Asignador>::eliminarMinimo() {
     if (cabeza == nullptr) {
         throw std::runtime_error("Lista vacía - no se puede eliminar mínimo");
     }
@@ -273,18 +334,18 @@ T ListaSensor<T>::eliminarMinimo() {
     return minimo;
 }
 
-template <typename T>
-int ListaSensor<T>::obtenerTamano() const {
+template <typename T, typename Asignador>
+int ListaSensor<T, Asignador>::obtenerTamano() const {
     return tamano;
 }
 
-template <typename T>
-bool ListaSensor<T>::estaVacia() const {
+template <typename T, typename Asignador>
+bool ListaSensor<T, Asignador>::estaVacia() const {
     return cabeza == nullptr;
 }
 
-template <typename T>
-void ListaSensor<T>::imprimir() const {
+template <typename T, typename Asignador>
+void ListaSensor<T, Asignador>::imprimir() const {
     std::cout << "[";
     Nodo<T>* actual = cabeza;
     while (actual != nullptr) {
@@ -297,15 +358,30 @@ void ListaSensor<T>::imprimir() const {
     std::cout << "]\n";
 }
 
-template <typename T>
-void ListaSensor<T>::limpiar() {
-    while (cabeza != nullptr) {
+template <typename T, typename Asignador>
+void ListaSensor<T, Asignador>::limpiar() {
+    // Con arena, datos triviales y sin trazas no hace falta visitar cada
+    // nodo: basta con devolver los bloques completos
+    bool recorrer = !Asignador::liberaEnBloque
+                    || !std::is_trivially_destructible<T>::value
+                    || Log::habilitado(Log::TRAZA);
+
+    while (recorrer && cabeza != nullptr) {
         Nodo<T>* temp = cabeza;
         cabeza = cabeza->siguiente;
-        std::cout << "[Log] Nodo<" << typeid(T).name() << "> " << temp->dato << " liberado.\n";
-        delete temp;
+        LOG_TRAZA("[Log] Nodo<" << typeid(T).name() << "> " << temp->dato << " liberado.\n");
+        destruirNodo(temp);
     }
+    asignador.liberarTodo();
+    cabeza = nullptr;
+    cola = nullptr;
     tamano = 0;
+    agregados.reiniciar();
+}
+
+template <typename T, typename Asignador>
+const EstadisticasAsignador& ListaSensor<T, Asignador>::obtenerEstadisticasMemoria() const {
+    return asignador.obtenerEstadisticas();
 }
 
 #endif // LISTASENSOR_H
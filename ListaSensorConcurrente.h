@@ -0,0 +1,504 @@
+/**
+ * @file ListaSensorConcurrente.h
+ * @brief Lista de lecturas solo de inserción, sin bloqueos para varios productores
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef LISTASENSORCONCURRENTE_H
+#define LISTASENSORCONCURRENTE_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include "AgregadosLecturas.h"
+
+/**
+ * @class RanuraHilo
+ * @brief Índice propio de cada hilo en los contadores de operaciones en curso
+ *
+ * La primera vez que un hilo opera sobre una ListaSensorConcurrente toma
+ * un índice libre en [0, MAX_RANURAS) y lo devuelve al terminar, así los
+ * hilos nuevos reutilizan los de los que ya salieron. Mientras lo tiene,
+ * solo ese hilo escribe en su contador de cada lista. Si hay más hilos
+ * vivos que ranuras, los sobrantes comparten RANURA_COMPARTIDA.
+ */
+class RanuraHilo {
+public:
+    static const int MAX_RANURAS = 64;               ///< Hilos con contador propio
+    static const int RANURA_COMPARTIDA = MAX_RANURAS;  ///< Contador del resto
+
+    /**
+     * @brief Índice del hilo que llama (lo reserva en su primera llamada)
+     */
+    static int propia() {
+        static thread_local RanuraHilo ranura;
+        return ranura.indice;
+    }
+
+private:
+    int indice;  ///< Ranura reservada o RANURA_COMPARTIDA
+
+    static std::atomic<uint64_t>& ocupadas() {
+        static std::atomic<uint64_t> mapa(0);  ///< Bit i: ranura i en uso
+        return mapa;
+    }
+
+    RanuraHilo() : indice(RANURA_COMPARTIDA) {
+        uint64_t mapa = ocupadas().load(std::memory_order_relaxed);
+        while (mapa != ~static_cast<uint64_t>(0)) {
+            int libre = 0;
+            while (mapa & (static_cast<uint64_t>(1) << libre)) {
+                libre++;
+            }
+            if (ocupadas().compare_exchange_weak(mapa, mapa | (static_cast<uint64_t>(1) << libre))) {
+                indice = libre;
+                return;
+            }
+        }
+    }
+
+    ~RanuraHilo() {
+        if (indice != RANURA_COMPARTIDA) {
+            ocupadas().fetch_and(~(static_cast<uint64_t>(1) << indice));
+        }
+    }
+
+    RanuraHilo(const RanuraHilo&);
+    RanuraHilo& operator=(const RanuraHilo&);
+};
+
+/**
+ * @brief Bloque de la lista concurrente: hasta B lecturas y su estado
+ * @tparam T Tipo de dato de las lecturas
+ * @tparam B Capacidad del bloque
+ */
+template <typename T, int B>
+struct BloqueConcurrente {
+    T datos[B];                        ///< Lecturas contiguas del bloque
+    std::atomic<bool> listo[B];        ///< listo[i]: datos[i] ya es visible
+    std::atomic<int> reservados;       ///< Posiciones repartidas (puede pasar de B)
+    std::atomic<BloqueConcurrente<T, B>*> siguiente;  ///< Siguiente bloque
+
+    BloqueConcurrente() : reservados(0), siguiente(nullptr) {
+        for (int i = 0; i < B; i++) {
+            listo[i].store(false, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @class ListaSensorConcurrente
+ * @brief Variante de ListaSensor<T> solo de inserción, segura entre hilos
+ * @tparam T Tipo de dato de las lecturas
+ * @tparam B Lecturas por bloque (256 por defecto)
+ *
+ * Varios hilos pueden llamar a insertarAlFinal() a la vez, y otros
+ * recorrer la lista (promedio, mínimo, impresión) mientras tanto, sin
+ * ningún mutex:
+ * - Cada bloque reparte sus posiciones con un fetch_add; el productor
+ *   escribe su lectura y la marca como lista con un store release.
+ * - El productor que encuentra el último bloque lleno crea uno nuevo ya
+ *   con su lectura en la posición 0 y lo enlaza con un CAS sobre
+ *   siguiente; después avanza la cola con otro CAS. Quien pierde el
+ *   enlace libera su bloque y ayuda a avanzar la cola.
+ * - Los recorridos solo visitan posiciones marcadas como listas: una
+ *   inserción a medio escribir aún no forma parte de la lista.
+ *
+ * No hay eliminación individual (eliminar(), eliminarMinimo()): solo
+ * limpiar(), que desengancha la cadena entera y la retira. La memoria
+ * retirada se libera cuando no queda ninguna operación en curso, en la
+ * propia limpiar(), en reclamarDiferidos() o en el destructor. Las
+ * operaciones en curso se cuentan por hilo (RanuraHilo): cada contador
+ * está en su propia línea de caché y solo lo escribe su hilo, de modo que
+ * los productores no comparten más que el bloque de la cola. Una
+ * inserción que coincide con limpiar() puede caer en la cadena retirada:
+ * cuenta como anterior a la limpieza.
+ *
+ * A diferencia de las otras listas, insertarAlFinal() no emite trazas:
+ * el cerrojo del log serializaría a los productores.
+ */
+template <typename T, int B = 256>
+class ListaSensorConcurrente {
+public:
+    typedef BloqueConcurrente<T, B> Bloque;  ///< Tipo de nodo de la lista
+
+private:
+    /**
+     * @brief Cadena de bloques desenganchada por limpiar()
+     */
+    struct CadenaRetirada {
+        Bloque* primero;             ///< Primer bloque de la cadena
+        CadenaRetirada* siguiente;   ///< Cadena retirada antes
+    };
+
+    static const size_t LINEA_CACHE = 64;  ///< Bytes de una línea de caché típica
+
+    /**
+     * @brief Operaciones en curso de un hilo, sola en su línea de caché
+     */
+    struct ContadorHilo {
+        std::atomic<long> activos;  ///< Operaciones del hilo aún sin terminar
+        char relleno[LINEA_CACHE - sizeof(std::atomic<long>)];
+    };
+
+    /**
+     * @brief Marca una operación en curso mientras existe
+     *
+     * Con ranura propia nadie más escribe el contador: la marca es un
+     * exchange sin competencia y el final, un store release. La marca es
+     * seq_cst y precede a la lectura de cabeza o cola; reclamarSinCerrojo()
+     * lee los contadores después de cambiarlas, así que o ve la marca o la
+     * operación ve la cadena nueva.
+     */
+    class Operacion {
+        std::atomic<long>* activos;
+        bool propia;
+
+    public:
+        explicit Operacion(const ListaSensorConcurrente& lista) {
+            int ranura = RanuraHilo::propia();
+            activos = &lista.contadores[ranura].activos;
+            propia = ranura != RanuraHilo::RANURA_COMPARTIDA;
+            if (propia) {
+                activos->exchange(activos->load(std::memory_order_relaxed) + 1);
+            } else {
+                activos->fetch_add(1);
+            }
+        }
+        ~Operacion() {
+            if (propia) {
+                activos->store(activos->load(std::memory_order_relaxed) - 1, std::memory_order_release);
+            } else {
+                activos->fetch_sub(1, std::memory_order_release);
+            }
+        }
+    };
+
+    std::atomic<Bloque*> cabeza;  ///< Primer bloque (inicio de los recorridos)
+    std::atomic<Bloque*> cola;    ///< Último bloque, o uno cercano (inserción)
+    char relleno[LINEA_CACHE - 2 * sizeof(std::atomic<Bloque*>)];
+
+    /// Operaciones en curso por hilo; la última ranura la comparten los sobrantes
+    mutable ContadorHilo contadores[RanuraHilo::MAX_RANURAS + 1];
+
+    std::mutex cerrojoLimpieza;   ///< Serializa limpiar() y la reclamación
+    CadenaRetirada* retirados;    ///< Cadenas pendientes de liberar
+
+    /**
+     * @brief Libera los bloques de una cadena
+     * @param primero Primer bloque
+     */
+    static void liberarCadena(Bloque* primero);
+
+    /**
+     * @brief Libera las cadenas retiradas si no hay operaciones en curso
+     * @return true si se liberaron (o no había ninguna)
+     *
+     * Requiere cerrojoLimpieza.
+     */
+    bool reclamarSinCerrojo();
+
+public:
+    /**
+     * @brief Constructor: lista vacía con un bloque preparado
+     */
+    ListaSensorConcurrente();
+
+    /**
+     * @brief Destructor - Libera la cadena actual y las retiradas
+     *
+     * No debe quedar ningún hilo usando la lista.
+     */
+    ~ListaSensorConcurrente();
+
+    /**
+     * @brief Inserta un valor al final (seguro desde varios hilos)
+     * @param valor Valor a insertar
+     *
+     * Sin bloqueos: O(1) salvo cuando toca crear un bloque.
+     */
+    void insertarAlFinal(T valor);
+
+    /**
+     * @brief Aplica una función a cada lectura visible, en orden de bloque
+     * @param funcion Invocable con un argumento T
+     *
+     * Se puede llamar mientras otros hilos insertan; las lecturas que
+     * lleguen durante el recorrido pueden verse o no.
+     */
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const;
+
+    /**
+     * @brief Calcula el promedio de las lecturas visibles
+     * @return Promedio como tipo T (0 si está vacía)
+     *
+     * Recorre la lista: O(n). Los agregados no se mantienen al insertar
+     * para no añadir otro punto de contención entre productores.
+     */
+    T calcularPromedio() const;
+
+    /**
+     * @brief Calcula la varianza poblacional de las lecturas visibles
+     * @return Varianza (0 con menos de dos lecturas), en O(n)
+     */
+    double calcularVarianza() const;
+
+    /**
+     * @brief Calcula la desviación estándar poblacional
+     * @return Desviación estándar, en O(n)
+     */
+    double calcularDesviacionEstandar() const;
+
+    /**
+     * @brief Encuentra el valor mínimo de las lecturas visibles
+     * @return Valor mínimo
+     */
+    T encontrarMinimo() const;
+
+    /**
+     * @brief Obtiene el número de lecturas visibles
+     * @return Número de elementos, en O(n): cuenta las marcas listo[]
+     */
+    int obtenerTamano() const;
+
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si no hay lecturas visibles
+     */
+    bool estaVacia() const;
+
+    /**
+     * @brief Imprime todas las lecturas visibles
+     */
+    void imprimir() const;
+
+    /**
+     * @brief Vacía la lista; la memoria se libera de forma diferida
+     *
+     * Puede llamarse mientras otros hilos insertan o recorren.
+     */
+    void limpiar();
+
+    /**
+     * @brief Intenta liberar las cadenas que dejó limpiar()
+     * @return true si ya no queda memoria retirada
+     */
+    bool reclamarDiferidos();
+
+private:
+    ListaSensorConcurrente(const ListaSensorConcurrente&);
+    ListaSensorConcurrente& operator=(const ListaSensorConcurrente&);
+};
+
+// ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
+
+template <typename T, int B>
+ListaSensorConcurrente<T, B>::ListaSensorConcurrente() : retirados(nullptr) {
+    for (int i = 0; i <= RanuraHilo::MAX_RANURAS; i++) {
+        contadores[i].activos.store(0, std::memory_order_relaxed);
+    }
+    Bloque* inicial = new Bloque;
+    cabeza.store(inicial, std::memory_order_relaxed);
+    cola.store(inicial, std::memory_order_relaxed);
+}
+
+template <typename T, int B>
+ListaSensorConcurrente<T, B>::~ListaSensorConcurrente() {
+    liberarCadena(cabeza.load(std::memory_order_relaxed));
+    while (retirados != nullptr) {
+        CadenaRetirada* temp = retirados;
+        retirados = retirados->siguiente;
+        liberarCadena(temp->primero);
+        delete temp;
+    }
+}
+
+template <typename T, int B>
+void ListaSensorConcurrente<T, B>::liberarCadena(Bloque* primero) {
+    while (primero != nullptr) {
+        Bloque* temp = primero;
+        primero = primero->siguiente.load(std::memory_order_relaxed);
+        delete temp;
+    }
+}
+
+template <typename T, int B>
+void ListaSensorConcurrente<T, B>::insertarAlFinal(T valor) {
+    Operacion operacion(*this);
+    Bloque* bloque = cola.load();
+
+    while (true) {
+        int posicion = bloque->reservados.fetch_add(1, std::memory_order_relaxed);
+        if (posicion < B) {
+            bloque->datos[posicion] = valor;
+            bloque->listo[posicion].store(true, std::memory_order_release);
+            return;
+        }
+
+        // Bloque lleno: enlazar uno nuevo que ya lleva la lectura
+        Bloque* siguiente = bloque->siguiente.load(std::memory_order_acquire);
+        if (siguiente == nullptr) {
+            Bloque* nuevo = new Bloque;
+            nuevo->datos[0] = valor;
+            nuevo->listo[0].store(true, std::memory_order_relaxed);
+            nuevo->reservados.store(1, std::memory_order_relaxed);
+
+            if (bloque->siguiente.compare_exchange_strong(siguiente, nuevo,
+                                                          std::memory_order_acq_rel)) {
+                Bloque* esperado = bloque;
+                cola.compare_exchange_strong(esperado, nuevo);
+                return;
+            }
+            delete nuevo;  // Otro productor enlazó antes: siguiente es el suyo
+        }
+
+        // Ayuda a avanzar la cola y sigue por el bloque siguiente
+        Bloque* esperado = bloque;
+        cola.compare_exchange_strong(esperado, siguiente);
+        bloque = siguiente;
+    }
+}
+
+template <typename T, int B>
+template <typename Funcion>
+void ListaSensorConcurrente<T, B>::recorrer(Funcion funcion) const {
+    Operacion operacion(*this);
+    for (Bloque* bloque = cabeza.load(); bloque != nullptr;
+         bloque = bloque->siguiente.load(std::memory_order_acquire)) {
+        int ocupadas = bloque->reservados.load(std::memory_order_acquire);
+        if (ocupadas > B) {
+            ocupadas = B;
+        }
+        for (int i = 0; i < ocupadas; i++) {
+            if (bloque->listo[i].load(std::memory_order_acquire)) {
+                funcion(bloque->datos[i]);
+            }
+        }
+    }
+}
+
+template <typename T, int B>
+T ListaSensorConcurrente<T, B>::calcularPromedio() const {
+    AgregadosLecturas<T> agregados;
+    recorrer([&agregados](T valor) { agregados.agregar(valor); });
+    return agregados.promedio();
+}
+
+template <typename T, int B>
+double ListaSensorConcurrente<T, B>::calcularVarianza() const {
+    AgregadosLecturas<T> agregados;
+    recorrer([&agregados](T valor) { agregados.agregar(valor); });
+    return agregados.varianza();
+}
+
+template <typename T, int B>
+double ListaSensorConcurrente<T, B>::calcularDesviacionEstandar() const {
+    AgregadosLecturas<T> agregados;
+    recorrer([&agregados](T valor) { agregados.agregar(valor); });
+    return agregados.desviacionEstandar();
+}
+
+template <typename T, int B>
+T ListaSensorConcurrente<T, B>::encontrarMinimo() const {
+    bool hayLecturas = false;
+    T minimo = T();
+    recorrer([&hayLecturas, &minimo](T valor) {
+        if (!hayLecturas || valor < minimo) {
+            minimo = valor;
+            hayLecturas = true;
+        }
+    });
+
+    if (!hayLecturas) {
+        throw std::runtime_error("Lista vacía - no se puede encontrar mínimo");
+    }
+    return minimo;
+}
+
+template <typename T, int B>
+int ListaSensorConcurrente<T, B>::obtenerTamano() const {
+    int total = 0;
+    recorrer([&total](T) { total++; });
+    return total;
+}
+
+template <typename T, int B>
+bool ListaSensorConcurrente<T, B>::estaVacia() const {
+    Operacion operacion(*this);
+    for (Bloque* bloque = cabeza.load(); bloque != nullptr;
+         bloque = bloque->siguiente.load(std::memory_order_acquire)) {
+        int ocupadas = bloque->reservados.load(std::memory_order_acquire);
+        for (int i = 0; i < ocupadas && i < B; i++) {
+            if (bloque->listo[i].load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T, int B>
+void ListaSensorConcurrente<T, B>::imprimir() const {
+    bool primero = true;
+    std::cout << "[";
+    recorrer([&primero](T valor) {
+        if (!primero) {
+            std::cout << ", ";
+        }
+        std::cout << valor;
+        primero = false;
+    });
+    std::cout << "]\n";
+}
+
+template <typename T, int B>
+void ListaSensorConcurrente<T, B>::limpiar() {
+    std::lock_guard<std::mutex> guarda(cerrojoLimpieza);
+
+    // Primero la cola (nuevas inserciones) y después la cabeza (recorridos)
+    Bloque* nuevo = new Bloque;
+    cola.store(nuevo);
+    Bloque* anterior = cabeza.exchange(nuevo);
+
+    CadenaRetirada* cadena = new CadenaRetirada;
+    cadena->primero = anterior;
+    cadena->siguiente = retirados;
+    retirados = cadena;
+
+    reclamarSinCerrojo();
+}
+
+template <typename T, int B>
+bool ListaSensorConcurrente<T, B>::reclamarDiferidos() {
+    std::lock_guard<std::mutex> guarda(cerrojoLimpieza);
+    return reclamarSinCerrojo();
+}
+
+template <typename T, int B>
+bool ListaSensorConcurrente<T, B>::reclamarSinCerrojo() {
+    if (retirados == nullptr) {
+        return true;
+    }
+
+    // Una operación que marque su contador después de esta lectura ya ve
+    // la cadena nueva (cabeza y cola se publicaron antes, ver Operacion)
+    for (int i = 0; i <= RanuraHilo::MAX_RANURAS; i++) {
+        if (contadores[i].activos.load() != 0) {
+            return false;
+        }
+    }
+
+    while (retirados != nullptr) {
+        CadenaRetirada* temp = retirados;
+        retirados = retirados->siguiente;
+        liberarCadena(temp->primero);
+        delete temp;
+    }
+    return true;
+}
+
+#endif // LISTASENSORCONCURRENTE_H
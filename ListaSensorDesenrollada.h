@@ -0,0 +1,962 @@
+/**
+ * @file ListaSensorDesenrollada.h
+ * @brief Lista enlazada desenrollada: cada nodo guarda un bloque de lecturas
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef LISTASENSORDESENROLLADA_H
+#define LISTASENSORDESENROLLADA_H
+
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include "Log.h"
+#include "AsignadorNodos.h"
+#include "AgregadosLecturas.h"
+#include "InstanteLectura.h"
+
+/**
+ * @brief Nodo de la lista desenrollada: un bloque de hasta B lecturas
+ * @tparam T Tipo de dato de las lecturas
+ * @tparam B Capacidad del bloque
+ */
+template <typename T, int B>
+struct BloqueLecturas {
+    T datos[B];                        ///< Lecturas contiguas del bloque
+    uint32_t deltas[B];                ///< Llegada de datos[i]: instanteBase + deltas[i] (ms)
+    int64_t instanteBase;              ///< Instante de referencia del bloque (ms)
+    int cuenta;                        ///< Lecturas ocupadas en datos[0..cuenta)
+    int indiceMinimo;                  ///< Posición del mínimo dentro del bloque
+    int posicionHeap;                  ///< Posición del bloque en el heap de mínimos
+    unsigned long secuencia;           ///< Orden de creación (desempate en el heap)
+    BloqueLecturas<T, B>* siguiente;   ///< Puntero al siguiente bloque
+    BloqueLecturas<T, B>* anterior;    ///< Puntero al bloque previo
+
+    /**
+     * @brief Constructor del bloque vacío
+     * @param sec Número de secuencia del bloque
+     * @param base Instante de la primera lectura del bloque (ms)
+     */
+    BloqueLecturas(unsigned long sec, int64_t base)
+        : instanteBase(base), cuenta(0), indiceMinimo(0), posicionHeap(-1), secuencia(sec),
+          siguiente(nullptr), anterior(nullptr) {}
+
+    /**
+     * @brief Instante de llegada de una lectura del bloque
+     * @param i Posición dentro del bloque
+     */
+    int64_t instante(int i) const { return instanteBase + deltas[i]; }
+};
+
+/**
+ * @class ListaSensorDesenrollada
+ * @brief Lista enlazada simple cuyos nodos almacenan bloques de lecturas
+ * @tparam T Tipo de dato de las lecturas
+ * @tparam B Lecturas por bloque (64 por defecto)
+ * @tparam Asignador Origen de la memoria de los bloques (arena por defecto)
+ *
+ * Ofrece la misma interfaz pública que ListaSensor<T>, pero en lugar de
+ * un puntero de 8 bytes por lectura paga uno por bloque, y los recorridos
+ * (promedio, mínimo, búsqueda) avanzan por memoria contigua.
+ *
+ * Las lecturas conservan su orden de llegada: al eliminar una lectura se
+ * desplazan las siguientes dentro de su bloque, y un bloque que queda
+ * vacío se desenlaza de la lista.
+ *
+ * Índice de mínimos: cada bloque recuerda la posición de su mínimo y los
+ * bloques forman un heap binario indexado por ese mínimo. encontrarMinimo()
+ * es O(1) y eliminarMinimo() quita la lectura exacta en O(B + log(n/B)),
+ * sin volver a buscarla por valor. Ante empates gana el bloque más antiguo
+ * y, dentro del bloque, la primera posición, igual que ListaSensor<T>.
+ * La búsqueda del mínimo dentro de un bloque, los lotes y los promedios
+ * por intervalo recorren tramos contiguos con KernelsLecturas (SIMD).
+ *
+ * Marcas de tiempo: cada lectura guarda su instante de llegada (ms del
+ * reloj monotónico) como desplazamiento de 32 bits respecto al instante
+ * base de su bloque: 4 bytes por lectura en lugar de 8. Un bloque nuevo
+ * empieza cuando el actual se llena o cuando el desplazamiento ya no cabe
+ * (unos 49 días). Como los instantes no decrecen, un directorio de bloques
+ * en orden de llegada permite llegar por búsqueda binaria al principio de
+ * un intervalo de tiempo (recorrerRango()) sin recorrer desde la cabeza.
+ */
+template <typename T, int B = 64, typename Asignador = AsignadorArena<BloqueLecturas<T, B> > >
+class ListaSensorDesenrollada {
+public:
+    typedef BloqueLecturas<T, B> Bloque;  ///< Tipo de nodo de la lista
+
+private:
+    Bloque* cabeza;   ///< Primer bloque de la lista
+    Bloque* cola;     ///< Último bloque (inserción al final en O(1))
+    int tamano;       ///< Número total de lecturas
+    int numBloques;   ///< Número de bloques enlazados
+    unsigned long proximaSecuencia;  ///< Secuencia del próximo bloque
+    Asignador asignador;  ///< Proveedor de memoria para los bloques
+    AgregadosLecturas<T> agregados;  ///< Suma, cuenta y suma de cuadrados
+    Bloque** heap;        ///< Heap binario de bloques ordenado por su mínimo
+    int capacidadHeap;    ///< Capacidad reservada del arreglo heap
+    Bloque** directorio;  ///< Bloques en orden de llegada (numBloques válidos)
+    int capacidadDirectorio;  ///< Capacidad reservada del directorio
+    int64_t ultimoInstante;  ///< Instante de la última lectura insertada (ms)
+
+    /// Mayor desplazamiento que cabe en BloqueLecturas::deltas
+    static const int64_t DELTA_MAXIMO = 0xFFFFFFFFLL;
+
+    /**
+     * @brief Crea un bloque vacío y lo enlaza al final (aún fuera del heap)
+     * @param base Instante de la primera lectura que recibirá
+     */
+    void agregarBloque(int64_t base);
+
+    /**
+     * @brief Indica si la próxima lectura necesita un bloque nuevo
+     * @param instante Instante de la lectura
+     */
+    bool necesitaBloque(int64_t instante) const {
+        return cola == nullptr || cola->cuenta == B || instante - cola->instanteBase > DELTA_MAXIMO;
+    }
+
+    /**
+     * @brief Ajusta un instante para que no sea anterior a la última lectura
+     */
+    int64_t instanteOrdenado(int64_t instante) const {
+        return instante < ultimoInstante ? ultimoInstante : instante;
+    }
+
+    /**
+     * @brief Quita un bloque del directorio (su secuencia lo localiza)
+     * @param bloque Bloque ya desenlazado; numBloques aún lo incluye
+     */
+    void quitarDeDirectorio(Bloque* bloque);
+
+    /**
+     * @brief Quita la lectura en la posición indicada de un bloque
+     * @param bloque Bloque que contiene la lectura
+     * @param indice Posición dentro del bloque
+     */
+    void quitarEn(Bloque* bloque, int indice);
+
+    /**
+     * @brief Compara dos bloques por su mínimo (desempate por antigüedad)
+     * @return true si a debe quedar por encima de b en el heap
+     */
+    static bool precede(const Bloque* a, const Bloque* b);
+
+    /**
+     * @brief Recalcula la posición del mínimo de un bloque no vacío
+     * @param bloque Bloque a examinar
+     */
+    static void recalcularMinimo(Bloque* bloque);
+
+    /**
+     * @brief Coloca un bloque en una posición del heap
+     */
+    void colocarEnHeap(Bloque* bloque, int posicion);
+
+    /**
+     * @brief Sube un bloque en el heap mientras preceda a su padre
+     */
+    void subirEnHeap(int posicion);
+
+    /**
+     * @brief Baja un bloque en el heap mientras algún hijo lo preceda
+     */
+    void bajarEnHeap(int posicion);
+
+    /**
+     * @brief Inserta un bloque recién creado en el heap
+     */
+    void insertarEnHeap(Bloque* bloque);
+
+    /**
+     * @brief Retira un bloque del heap
+     */
+    void quitarDeHeap(Bloque* bloque);
+
+    /**
+     * @brief Restaura la posición de un bloque tras cambiar su mínimo
+     */
+    void reubicarEnHeap(Bloque* bloque);
+
+    /**
+     * @brief Copia todas las lecturas de otra lista al final de esta
+     * @param otra Lista de origen
+     */
+    void copiarDesde(const ListaSensorDesenrollada& otra);
+
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    ListaSensorDesenrollada();
+
+    /**
+     * @brief Destructor - Libera todos los bloques
+     */
+    ~ListaSensorDesenrollada();
+
+    /**
+     * @brief Constructor de copia (Regla de los Tres)
+     * @param otra Lista a copiar
+     */
+    ListaSensorDesenrollada(const ListaSensorDesenrollada& otra);
+
+    /**
+     * @brief Operador de asignación (Regla de los Tres)
+     * @param otra Lista a asignar
+     * @return Referencia a esta lista
+     */
+    ListaSensorDesenrollada& operator=(const ListaSensorDesenrollada& otra);
+
+    /**
+     * @brief Inserta un nuevo elemento al final de la lista
+     * @param valor Valor a insertar
+     *
+     * Complejidad O(1): se escribe en el bloque de la cola y solo se
+     * reserva un bloque nuevo cada B lecturas. La lectura se fecha con
+     * instanteActualMs().
+     */
+    void insertarAlFinal(T valor);
+
+    /**
+     * @brief Inserta un nuevo elemento al final con su instante de llegada
+     * @param valor Valor a insertar
+     * @param instanteMs Instante en ms; si es anterior a la última lectura
+     *        se usa el de esta, para conservar el orden temporal
+     */
+    void insertarAlFinal(T valor, int64_t instanteMs);
+
+    /**
+     * @brief Inserta un bloque de valores al final, en orden
+     * @param valores Arreglo de valores
+     * @param cantidad Número de valores
+     *
+     * Rellena el bloque de la cola y los bloques nuevos con copias
+     * contiguas, y actualiza el heap de mínimos una vez por bloque en
+     * lugar de una vez por lectura. Todas las lecturas del lote se
+     * fechan con el mismo instante.
+     */
+    void insertarLote(const T* valores, int cantidad);
+
+    /**
+     * @brief Inserta un bloque de valores llegados en un mismo instante
+     * @param valores Arreglo de valores
+     * @param cantidad Número de valores
+     * @param instanteMs Instante de llegada del lote (ms)
+     */
+    void insertarLote(const T* valores, int cantidad, int64_t instanteMs);
+
+    /**
+     * @brief Inserta lecturas con su propio instante de llegada
+     * @param valores Arreglo de valores
+     * @param instantes Instante de cada valor (ms, no decrecientes)
+     * @param cantidad Número de valores
+     *
+     * Como insertarLote(), un bloque cada vez; lo usa la carga de
+     * InstantaneaGestion para reconstruir el historial.
+     */
+    void insertarTramo(const T* valores, const int64_t* instantes, int cantidad);
+
+    /**
+     * @brief Elimina la primera lectura igual al valor especificado
+     * @param valor Valor a eliminar
+     * @return true si se eliminó, false si no se encontró
+     */
+    bool eliminar(T valor);
+
+    /**
+     * @brief Busca un valor en la lista
+     * @param valor Valor a buscar
+     * @return true si se encontró, false en caso contrario
+     */
+    bool buscar(T valor) const;
+
+    /**
+     * @brief Calcula el promedio de todos los valores en la lista
+     * @return Promedio como tipo T
+     *
+     * Complejidad O(1): usa la suma acumulada en lugar de recorrer la lista.
+     */
+    T calcularPromedio() const;
+
+    /**
+     * @brief Calcula la varianza poblacional de los valores
+     * @return Varianza (0 con menos de dos lecturas), en O(1)
+     */
+    double calcularVarianza() const;
+
+    /**
+     * @brief Calcula la desviación estándar poblacional de los valores
+     * @return Desviación estándar, en O(1)
+     */
+    double calcularDesviacionEstandar() const;
+
+    /**
+     * @brief Encuentra y retorna el valor mínimo en la lista
+     * @return Valor mínimo encontrado (O(1), raíz del heap)
+     */
+    T encontrarMinimo() const;
+
+    /**
+     * @brief Elimina la lectura con el valor mínimo
+     * @return Valor que fue eliminado
+     *
+     * Toma la posición exacta del mínimo del heap: O(B + log(n/B)).
+     */
+    T eliminarMinimo();
+
+    /**
+     * @brief Obtiene el tamaño actual de la lista
+     * @return Número de lecturas
+     */
+    int obtenerTamano() const;
+
+    /**
+     * @brief Obtiene el número de bloques enlazados
+     * @return Número de bloques
+     */
+    int obtenerNumeroBloques() const;
+
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si está vacía, false en caso contrario
+     */
+    bool estaVacia() const;
+
+    /**
+     * @brief Imprime todos los elementos de la lista
+     */
+    void imprimir() const;
+
+    /**
+     * @brief Aplica una función a cada lectura, en orden de llegada
+     * @param funcion Invocable con un argumento T
+     */
+    template <typename Funcion>
+    void recorrer(Funcion funcion) const {
+        for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            for (int i = 0; i < actual->cuenta; i++) {
+                funcion(actual->datos[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Aplica una función a las lecturas llegadas en [desdeMs, hastaMs)
+     * @param desdeMs Inicio del intervalo (incluido)
+     * @param hastaMs Fin del intervalo (excluido)
+     * @param funcion Invocable con un argumento T
+     *
+     * Localiza el primer bloque y la primera lectura del intervalo con
+     * búsquedas binarias, O(log(n/B) + log B), y recorre solo el intervalo.
+     */
+    template <typename Funcion>
+    void recorrerRango(int64_t desdeMs, int64_t hastaMs, Funcion funcion) const;
+
+    /**
+     * @brief Como recorrerRango(), pero entrega tramos contiguos
+     * @param funcion Invocable con argumentos (const T* datos, int n)
+     *
+     * Cada llamada recibe las lecturas del intervalo de un bloque, para
+     * procesarlas con KernelsLecturas en lugar de una a una.
+     */
+    template <typename Funcion>
+    void recorrerTramosRango(int64_t desdeMs, int64_t hastaMs, Funcion funcion) const;
+
+    /**
+     * @brief Cuenta las lecturas llegadas en [desdeMs, hastaMs)
+     */
+    int contarEnRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    /**
+     * @brief Promedio de las lecturas llegadas en [desdeMs, hastaMs)
+     * @return Promedio como tipo T (0 si no hay ninguna)
+     */
+    T calcularPromedioRango(int64_t desdeMs, int64_t hastaMs) const;
+
+    /**
+     * @brief Aplica una función a cada lectura con su instante de llegada
+     * @param funcion Invocable con argumentos (T valor, int64_t instanteMs)
+     */
+    template <typename Funcion>
+    void recorrerConInstante(Funcion funcion) const {
+        for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            for (int i = 0; i < actual->cuenta; i++) {
+                funcion(actual->datos[i], actual->instante(i));
+            }
+        }
+    }
+
+    /**
+     * @brief Libera toda la memoria de la lista
+     */
+    void limpiar();
+
+    /**
+     * @brief Obtiene los contadores del asignador de bloques
+     * @return Estadísticas de reservas y bloques entregados
+     */
+    const EstadisticasAsignador& obtenerEstadisticasMemoria() const;
+};
+
+// ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
+
+template <typename T, int B, typename Asignador>
+ListaSensorDesenrollada<T, B, Asignador>::ListaSensorDesenrollada()
+    : cabeza(nullptr), cola(nullptr), tamano(0), numBloques(0), proximaSecuencia(0),
+      heap(nullptr), capacidadHeap(0), directorio(nullptr), capacidadDirectorio(0),
+      ultimoInstante(0) {
+}
+
+template <typename T, int B, typename Asignador>
+ListaSensorDesenrollada<T, B, Asignador>::~ListaSensorDesenrollada() {
+    limpiar();
+    delete[] heap;
+    delete[] directorio;
+}
+
+template <typename T, int B, typename Asignador>
+ListaSensorDesenrollada<T, B, Asignador>::ListaSensorDesenrollada(const ListaSensorDesenrollada& otra)
+    : cabeza(nullptr), cola(nullptr), tamano(0), numBloques(0), proximaSecuencia(0),
+      heap(nullptr), capacidadHeap(0), directorio(nullptr), capacidadDirectorio(0),
+      ultimoInstante(0) {
+    copiarDesde(otra);
+}
+
+template <typename T, int B, typename Asignador>
+ListaSensorDesenrollada<T, B, Asignador>&
+ListaSensorDesenrollada<T, B, Asignador>::operator=(const ListaSensorDesenrollada& otra) {
+    if (this != &otra) {
+        limpiar();  // Libera memoria actual
+        copiarDesde(otra);
+    }
+    return *this;
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::copiarDesde(const ListaSensorDesenrollada& otra) {
+    // Copia profunda bloque a bloque (compacta los bloques parcialmente llenos)
+    for (Bloque* actual = otra.cabeza; actual != nullptr; actual = actual->siguiente) {
+        for (int i = 0; i < actual->cuenta; i++) {
+            insertarAlFinal(actual->datos[i], actual->instante(i));
+        }
+    }
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::agregarBloque(int64_t base) {
+    Bloque* nuevo = new (asignador.reservar()) Bloque(proximaSecuencia++, base);
+    if (cabeza == nullptr) {
+        cabeza = nuevo;
+    } else {
+        cola->siguiente = nuevo;
+        nuevo->anterior = cola;
+    }
+    cola = nuevo;
+
+    if (numBloques == capacidadDirectorio) {
+        int nuevaCapacidad = capacidadDirectorio == 0 ? 16 : capacidadDirectorio * 2;
+        Bloque** nuevoDirectorio = new Bloque*[nuevaCapacidad];
+        for (int i = 0; i < numBloques; i++) {
+            nuevoDirectorio[i] = directorio[i];
+        }
+        delete[] directorio;
+        directorio = nuevoDirectorio;
+        capacidadDirectorio = nuevaCapacidad;
+    }
+    directorio[numBloques] = nuevo;
+    numBloques++;
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::quitarDeDirectorio(Bloque* bloque) {
+    // Las secuencias crecen en orden de llegada: búsqueda binaria
+    int bajo = 0;
+    int alto = numBloques - 1;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        if (directorio[medio]->secuencia < bloque->secuencia) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    for (int i = bajo + 1; i < numBloques; i++) {
+        directorio[i - 1] = directorio[i];
+    }
+}
+
+template <typename T, int B, typename Asignador>
+bool ListaSensorDesenrollada<T, B, Asignador>::precede(const Bloque* a, const Bloque* b) {
+    T minA = a->datos[a->indiceMinimo];
+    T minB = b->datos[b->indiceMinimo];
+    if (minA < minB) {
+        return true;
+    }
+    if (minB < minA) {
+        return false;
+    }
+    return a->secuencia < b->secuencia;
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::recalcularMinimo(Bloque* bloque) {
+    bloque->indiceMinimo = KernelsLecturas::indiceMinimo(bloque->datos, bloque->cuenta);
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::colocarEnHeap(Bloque* bloque, int posicion) {
+    heap[posicion] = bloque;
+    bloque->posicionHeap = posicion;
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::subirEnHeap(int posicion) {
+    Bloque* bloque = heap[posicion];
+    while (posicion > 0) {
+        int padre = (posicion - 1) / 2;
+        if (!precede(bloque, heap[padre])) {
+            break;
+        }
+        colocarEnHeap(heap[padre], posicion);
+        posicion = padre;
+    }
+    colocarEnHeap(bloque, posicion);
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::bajarEnHeap(int posicion) {
+    Bloque* bloque = heap[posicion];
+    while (true) {
+        int hijo = 2 * posicion + 1;
+        if (hijo >= numBloques) {
+            break;
+        }
+        if (hijo + 1 < numBloques && precede(heap[hijo + 1], heap[hijo])) {
+            hijo++;
+        }
+        if (!precede(heap[hijo], bloque)) {
+            break;
+        }
+        colocarEnHeap(heap[hijo], posicion);
+        posicion = hijo;
+    }
+    colocarEnHeap(bloque, posicion);
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarEnHeap(Bloque* bloque) {
+    // numBloques ya incluye al bloque nuevo
+    if (numBloques > capacidadHeap) {
+        int nuevaCapacidad = capacidadHeap == 0 ? 16 : capacidadHeap * 2;
+        Bloque** nuevoHeap = new Bloque*[nuevaCapacidad];
+        for (int i = 0; i < numBloques - 1; i++) {
+            nuevoHeap[i] = heap[i];
+        }
+        delete[] heap;
+        heap = nuevoHeap;
+        capacidadHeap = nuevaCapacidad;
+    }
+    colocarEnHeap(bloque, numBloques - 1);
+    subirEnHeap(numBloques - 1);
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::quitarDeHeap(Bloque* bloque) {
+    // numBloques ya excluye al bloque que sale: su hueco lo ocupa el último
+    int posicion = bloque->posicionHeap;
+    Bloque* ultimo = heap[numBloques];
+    bloque->posicionHeap = -1;
+    if (ultimo != bloque) {
+        colocarEnHeap(ultimo, posicion);
+        reubicarEnHeap(ultimo);
+    }
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::reubicarEnHeap(Bloque* bloque) {
+    subirEnHeap(bloque->posicionHeap);
+    bajarEnHeap(bloque->posicionHeap);
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarAlFinal(T valor) {
+    insertarAlFinal(valor, instanteActualMs());
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarAlFinal(T valor, int64_t instanteMs) {
+    int64_t instante = instanteOrdenado(instanteMs);
+    bool bloqueNuevo = necesitaBloque(instante);
+    if (bloqueNuevo) {
+        agregarBloque(instante);
+    }
+    int posicion = cola->cuenta++;
+    cola->datos[posicion] = valor;
+    cola->deltas[posicion] = static_cast<uint32_t>(instante - cola->instanteBase);
+    ultimoInstante = instante;
+    tamano++;
+
+    // Un bloque nuevo entra al heap con su primera lectura; si no, el
+    // bloque solo sube cuando la lectura es su nuevo mínimo
+    if (bloqueNuevo) {
+        cola->indiceMinimo = posicion;
+        insertarEnHeap(cola);
+    } else if (valor < cola->datos[cola->indiceMinimo]) {
+        cola->indiceMinimo = posicion;
+        subirEnHeap(cola->posicionHeap);
+    }
+    agregados.agregar(valor);
+    LOG_TRAZA("[Log] Bloque<" << typeid(T).name() << "> lectura insertada: " << valor << "\n");
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarLote(const T* valores, int cantidad) {
+    insertarLote(valores, cantidad, instanteActualMs());
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarLote(const T* valores, int cantidad,
+                                                            int64_t instanteMs) {
+    int64_t instante = instanteOrdenado(instanteMs);
+    int i = 0;
+    while (i < cantidad) {
+        bool bloqueNuevo = necesitaBloque(instante);
+        if (bloqueNuevo) {
+            agregarBloque(instante);
+        }
+        uint32_t delta = static_cast<uint32_t>(instante - cola->instanteBase);
+
+        int inicio = cola->cuenta;
+        int n = B - inicio;
+        if (n > cantidad - i) {
+            n = cantidad - i;
+        }
+
+        for (int k = 0; k < n; k++) {
+            cola->datos[inicio + k] = valores[i + k];
+            cola->deltas[inicio + k] = delta;
+        }
+        agregados.agregarTramo(valores + i, n);
+
+        // Mínimo del tramo nuevo; ante empates se queda el anterior
+        int indiceMin = inicio + KernelsLecturas::indiceMinimo(cola->datos + inicio, n);
+        if (!bloqueNuevo && !(cola->datos[indiceMin] < cola->datos[cola->indiceMinimo])) {
+            indiceMin = cola->indiceMinimo;
+        }
+        cola->cuenta += n;
+        tamano += n;
+        i += n;
+        ultimoInstante = instante;
+
+        // Una sola actualización del heap por bloque tocado
+        bool minimoCambio = (indiceMin != cola->indiceMinimo);
+        cola->indiceMinimo = indiceMin;
+        if (bloqueNuevo) {
+            insertarEnHeap(cola);
+        } else if (minimoCambio) {
+            subirEnHeap(cola->posicionHeap);
+        }
+    }
+    LOG_TRAZA("[Log] Bloque<" << typeid(T).name() << "> lote de " << cantidad
+              << " lecturas insertado.\n");
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::insertarTramo(const T* valores,
+                                                             const int64_t* instantes,
+                                                             int cantidad) {
+    int i = 0;
+    while (i < cantidad) {
+        int64_t instante = instanteOrdenado(instantes[i]);
+        bool bloqueNuevo = necesitaBloque(instante);
+        if (bloqueNuevo) {
+            agregarBloque(instante);
+        }
+
+        // Lecturas seguidas que caben en el bloque (hueco y desplazamiento)
+        int inicio = cola->cuenta;
+        int n = 0;
+        while (inicio + n < B && i + n < cantidad) {
+            if (instantes[i + n] > instante) {
+                instante = instantes[i + n];
+            }
+            if (instante - cola->instanteBase > DELTA_MAXIMO) {
+                break;
+            }
+            cola->datos[inicio + n] = valores[i + n];
+            cola->deltas[inicio + n] = static_cast<uint32_t>(instante - cola->instanteBase);
+            n++;
+        }
+        agregados.agregarTramo(valores + i, n);
+
+        int indiceMin = inicio + KernelsLecturas::indiceMinimo(cola->datos + inicio, n);
+        if (!bloqueNuevo && !(cola->datos[indiceMin] < cola->datos[cola->indiceMinimo])) {
+            indiceMin = cola->indiceMinimo;
+        }
+        cola->cuenta += n;
+        tamano += n;
+        i += n;
+        ultimoInstante = cola->instante(cola->cuenta - 1);
+
+        bool minimoCambio = (indiceMin != cola->indiceMinimo);
+        cola->indiceMinimo = indiceMin;
+        if (bloqueNuevo) {
+            insertarEnHeap(cola);
+        } else if (minimoCambio) {
+            subirEnHeap(cola->posicionHeap);
+        }
+    }
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::quitarEn(Bloque* bloque, int indice) {
+    agregados.quitar(bloque->datos[indice]);
+
+    // Desplaza las lecturas posteriores para conservar el orden de llegada
+    for (int i = indice + 1; i < bloque->cuenta; i++) {
+        bloque->datos[i - 1] = bloque->datos[i];
+        bloque->deltas[i - 1] = bloque->deltas[i];
+    }
+    bloque->cuenta--;
+    tamano--;
+
+    if (bloque->cuenta == 0) {
+        // Bloque vacío: se desenlaza, sale del heap y vuelve al asignador
+        if (bloque->anterior == nullptr) {
+            cabeza = bloque->siguiente;
+        } else {
+            bloque->anterior->siguiente = bloque->siguiente;
+        }
+        if (bloque->siguiente == nullptr) {
+            cola = bloque->anterior;
+        } else {
+            bloque->siguiente->anterior = bloque->anterior;
+        }
+        quitarDeDirectorio(bloque);
+        numBloques--;
+        quitarDeHeap(bloque);
+        bloque->~Bloque();
+        asignador.liberar(bloque);
+    } else {
+        // El mínimo del bloque pudo cambiar o desplazarse
+        recalcularMinimo(bloque);
+        reubicarEnHeap(bloque);
+    }
+}
+
+template <typename T, int B, typename Asignador>
+bool ListaSensorDesenrollada<T, B, Asignador>::eliminar(T valor) {
+    for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        for (int i = 0; i < actual->cuenta; i++) {
+            if (actual->datos[i] == valor) {
+                quitarEn(actual, i);
+                LOG_TRAZA("[Log] Lectura con valor " << valor << " eliminada.\n");
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T, int B, typename Asignador>
+bool ListaSensorDesenrollada<T, B, Asignador>::buscar(T valor) const {
+    for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        for (int i = 0; i < actual->cuenta; i++) {
+            if (actual->datos[i] == valor) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T, int B, typename Asignador>
+T ListaSensorDesenrollada<T, B, Asignador>::calcularPromedio() const {
+    return agregados.promedio();
+}
+
+template <typename T, int B, typename Asignador>
+double ListaSensorDesenrollada<T, B, Asignador>::calcularVarianza() const {
+    return agregados.varianza();
+}
+
+template <typename T, int B, typename Asignador>
+double ListaSensorDesenrollada<T, B, Asignador>::calcularDesviacionEstandar() const {
+    return agregados.desviacionEstandar();
+}
+
+template <typename T, int B, typename Asignador>
+T ListaSensorDesenrollada<T, B, Asignador>::encontrarMinimo() const {
+    if (cabeza == nullptr) {
+        throw std::runtime_error("Lista vacía - no se puede encontrar mínimo");
+    }
+
+    // La raíz del heap es el bloque con el menor mínimo: O(1)
+    return heap[0]->datos[heap[0]->indiceMinimo];
+}
+
+template <typename T, int B, typename Asignador>
+T ListaSensorDesenrollada<T, B, Asignador>::eliminarMinimo() {
+    if (cabeza == nullptr) {
+        throw std::runtime_error("Lista vacía - no se puede eliminar mínimo");
+    }
+
+    // Quita la lectura exacta señalada por el heap, sin buscarla por valor
+    Bloque* bloqueMin = heap[0];
+    T minimo = bloqueMin->datos[bloqueMin->indiceMinimo];
+    quitarEn(bloqueMin, bloqueMin->indiceMinimo);
+    LOG_TRAZA("[Log] Lectura con valor " << minimo << " eliminada.\n");
+    return minimo;
+}
+
+template <typename T, int B, typename Asignador>
+int ListaSensorDesenrollada<T, B, Asignador>::obtenerTamano() const {
+    return tamano;
+}
+
+template <typename T, int B, typename Asignador>
+int ListaSensorDesenrollada<T, B, Asignador>::obtenerNumeroBloques() const {
+    return numBloques;
+}
+
+template <typename T, int B, typename Asignador>
+bool ListaSensorDesenrollada<T, B, Asignador>::estaVacia() const {
+    return tamano == 0;
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::imprimir() const {
+    std::cout << "[";
+    bool primero = true;
+    for (Bloque* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+        for (int i = 0; i < actual->cuenta; i++) {
+            if (!primero) {
+                std::cout << ", ";
+            }
+            std::cout << actual->datos[i];
+            primero = false;
+        }
+    }
+    std::cout << "]\n";
+}
+
+template <typename T, int B, typename Asignador>
+template <typename Funcion>
+void ListaSensorDesenrollada<T, B, Asignador>::recorrerRango(int64_t desdeMs, int64_t hastaMs,
+                                                             Funcion funcion) const {
+    recorrerTramosRango(desdeMs, hastaMs, [&funcion](const T* datos, int n) {
+        for (int i = 0; i < n; i++) {
+            funcion(datos[i]);
+        }
+    });
+}
+
+template <typename T, int B, typename Asignador>
+template <typename Funcion>
+void ListaSensorDesenrollada<T, B, Asignador>::recorrerTramosRango(int64_t desdeMs, int64_t hastaMs,
+                                                                   Funcion funcion) const {
+    // Primer bloque cuya última lectura no es anterior a desdeMs
+    int bajo = 0;
+    int alto = numBloques;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        const Bloque* bloque = directorio[medio];
+        if (bloque->instante(bloque->cuenta - 1) < desdeMs) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    if (bajo == numBloques) {
+        return;
+    }
+
+    // Dentro del bloque, primera lectura no anterior a desdeMs
+    Bloque* actual = directorio[bajo];
+    int primera = 0;
+    int ultima = actual->cuenta;
+    while (primera < ultima) {
+        int medio = (primera + ultima) / 2;
+        if (actual->instante(medio) < desdeMs) {
+            primera = medio + 1;
+        } else {
+            ultima = medio;
+        }
+    }
+
+    for (int i = primera; actual != nullptr; actual = actual->siguiente, i = 0) {
+        // El intervalo termina en este bloque si su última lectura ya no entra
+        int fin = actual->cuenta;
+        bool ultimo = actual->instante(fin - 1) >= hastaMs;
+        if (ultimo) {
+            int bajoFin = i;
+            while (bajoFin < fin) {
+                int medio = (bajoFin + fin) / 2;
+                if (actual->instante(medio) < hastaMs) {
+                    bajoFin = medio + 1;
+                } else {
+                    fin = medio;
+                }
+            }
+        }
+        if (fin > i) {
+            funcion(actual->datos + i, fin - i);
+        }
+        if (ultimo) {
+            return;
+        }
+    }
+}
+
+template <typename T, int B, typename Asignador>
+int ListaSensorDesenrollada<T, B, Asignador>::contarEnRango(int64_t desdeMs, int64_t hastaMs) const {
+    int cuenta = 0;
+    recorrerTramosRango(desdeMs, hastaMs, [&cuenta](const T*, int n) { cuenta += n; });
+    return cuenta;
+}
+
+template <typename T, int B, typename Asignador>
+T ListaSensorDesenrollada<T, B, Asignador>::calcularPromedioRango(int64_t desdeMs,
+                                                                  int64_t hastaMs) const {
+    AgregadosLecturas<T> agregadosRango;
+    recorrerTramosRango(desdeMs, hastaMs, [&agregadosRango](const T* datos, int n) {
+        agregadosRango.agregarTramo(datos, n);
+    });
+    return agregadosRango.promedio();
+}
+
+template <typename T, int B, typename Asignador>
+void ListaSensorDesenrollada<T, B, Asignador>::limpiar() {
+    // Igual que ListaSensor: con arena y datos triviales se sueltan los
+    // bloques de la arena sin visitar cada nodo
+    bool recorrer = !Asignador::liberaEnBloque
+                    || !std::is_trivially_destructible<T>::value
+                    || Log::habilitado(Log::TRAZA);
+
+    while (recorrer && cabeza != nullptr) {
+        Bloque* temp = cabeza;
+        cabeza = cabeza->siguiente;
+        LOG_TRAZA("[Log] Bloque<" << typeid(T).name() << "> con " << temp->cuenta
+                  << " lecturas liberado.\n");
+        temp->~Bloque();
+        asignador.liberar(temp);
+    }
+    asignador.liberarTodo();
+    cabeza = nullptr;
+    cola = nullptr;
+    tamano = 0;
+    numBloques = 0;  // Heap y directorio quedan vacíos (conservan su capacidad)
+    proximaSecuencia = 0;
+    ultimoInstante = 0;  // Si no, las lecturas siguientes se ajustarían al máximo anterior
+    agregados.reiniciar();
+}
+
+template <typename T, int B, typename Asignador>
+const EstadisticasAsignador& ListaSensorDesenrollada<T, B, Asignador>::obtenerEstadisticasMemoria() const {
+    return asignador.obtenerEstadisticas();
+}
+
+#endif // LISTASENSORDESENROLLADA_H
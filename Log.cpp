@@ -0,0 +1,135 @@
+/**
+ * @file Log.cpp
+ * @brief Implementación del registro con buffer propio
+ */
+
+#include "Log.h"
+#include <mutex>
+
+namespace {
+
+/**
+ * @brief streambuf de tamaño fijo que escribe a un FILE* con fwrite
+ */
+class BufferLog : public std::streambuf {
+private:
+    static const int CAPACIDAD = 8192;  ///< Bytes del buffer interno
+    char zona[CAPACIDAD];               ///< Almacenamiento del buffer
+    std::FILE* destino;                 ///< Archivo de salida
+
+public:
+    bool bufferizado;  ///< true: volcar solo al llenarse o con vaciar()
+
+    BufferLog() : destino(stdout), bufferizado(false) {
+        setp(zona, zona + CAPACIDAD);
+    }
+
+    ~BufferLog() {
+        volcar();
+    }
+
+    /**
+     * @brief Escribe el contenido pendiente al destino
+     */
+    void volcar() {
+        std::ptrdiff_t pendiente = pptr() - pbase();
+        if (pendiente > 0) {
+            std::fwrite(pbase(), 1, static_cast<size_t>(pendiente), destino);
+        }
+        setp(zona, zona + CAPACIDAD);
+    }
+
+    void cambiarDestino(std::FILE* nuevo) {
+        volcar();
+        destino = nuevo;
+    }
+
+    void finMensaje() {
+        if (!bufferizado) {
+            volcar();
+        }
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        volcar();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        volcar();
+        std::fflush(destino);
+        return 0;
+    }
+};
+
+/**
+ * @brief Cerrojo del registro
+ *
+ * Recursivo para que un mensaje que formatea un objeto cuyo operator<<
+ * también registra no se bloquee a sí mismo.
+ */
+std::recursive_mutex& cerrojo() {
+    static std::recursive_mutex instancia;
+    return instancia;
+}
+
+BufferLog& buffer() {
+    static BufferLog instancia;
+    return instancia;
+}
+
+std::ostream& flujoLog() {
+    static std::ostream flujo(&buffer());
+    return flujo;
+}
+
+} // namespace
+
+Log::Nivel Log::nivelActual = static_cast<Log::Nivel>(IOT_LOG_NIVEL);
+
+Log::Mensaje::Mensaje(Nivel) {
+    cerrojo().lock();
+}
+
+Log::Mensaje::~Mensaje() {
+    buffer().finMensaje();
+    cerrojo().unlock();
+}
+
+std::ostream& Log::Mensaje::flujo() {
+    return flujoLog();
+}
+
+void Log::establecerNivel(Nivel nivel) {
+    if (static_cast<int>(nivel) > IOT_LOG_NIVEL) {
+        nivel = static_cast<Nivel>(IOT_LOG_NIVEL);
+    }
+    nivelActual = nivel;
+}
+
+Log::Nivel Log::obtenerNivel() {
+    return nivelActual;
+}
+
+void Log::establecerDestino(std::FILE* destino) {
+    std::lock_guard<std::recursive_mutex> guarda(cerrojo());
+    buffer().cambiarDestino(destino);
+}
+
+void Log::establecerBufferizado(bool activo) {
+    std::lock_guard<std::recursive_mutex> guarda(cerrojo());
+    buffer().bufferizado = activo;
+    if (!activo) {
+        buffer().volcar();
+    }
+}
+
+void Log::vaciar() {
+    std::lock_guard<std::recursive_mutex> guarda(cerrojo());
+    flujoLog().flush();
+}
@@ -0,0 +1,173 @@
+/**
+ * @file Log.h
+ * @brief Registro de mensajes con filtrado por nivel y salida bufferizada
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * El nivel máximo se fija en compilación con IOT_LOG_NIVEL. Los mensajes
+ * por encima de ese nivel (por ejemplo, las trazas por nodo de ListaSensor)
+ * desaparecen por completo del binario. Dentro de lo compilado, el nivel
+ * puede reducirse en tiempo de ejecución con Log::establecerNivel().
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+
+// Niveles de registro (de menor a mayor detalle)
+#define IOT_LOG_NINGUNO 0
+#define IOT_LOG_ERROR   1
+#define IOT_LOG_AVISO   2
+#define IOT_LOG_INFO    3
+#define IOT_LOG_TRAZA   4
+
+/**
+ * @brief Nivel máximo compilado
+ *
+ * La compilación didáctica conserva las trazas por nodo (TRAZA). Para
+ * producción compile con -DIOT_LOG_NIVEL=IOT_LOG_INFO (o menor).
+ */
+#ifndef IOT_LOG_NIVEL
+#define IOT_LOG_NIVEL IOT_LOG_TRAZA
+#endif
+
+/**
+ * @class Log
+ * @brief Registro global con nivel configurable y buffer propio
+ *
+ * Los mensajes se formatean en un buffer interno de tamaño fijo y se
+ * escriben al destino con una sola llamada a fwrite. En modo por mensaje
+ * (por defecto) cada mensaje se vuelca al terminar, conservando el orden
+ * con std::cout. En modo bufferizado solo se vuelca cuando el buffer se
+ * llena o al llamar a vaciar().
+ *
+ * Es seguro entre hilos: cada Mensaje retiene el cerrojo del registro
+ * desde que se abre hasta que se cierra, así que los mensajes de hilos
+ * distintos no se entremezclan.
+ */
+class Log {
+public:
+    /**
+     * @brief Niveles de severidad
+     */
+    enum Nivel {
+        NINGUNO = IOT_LOG_NINGUNO,
+        ERROR   = IOT_LOG_ERROR,
+        AVISO   = IOT_LOG_AVISO,
+        INFO    = IOT_LOG_INFO,
+        TRAZA   = IOT_LOG_TRAZA
+    };
+
+    /**
+     * @brief Mensaje en construcción
+     *
+     * Objeto RAII: el mensaje se cierra (y se vuelca si corresponde)
+     * al destruirse.
+     */
+    class Mensaje {
+    public:
+        /**
+         * @brief Abre un mensaje del nivel indicado y toma el cerrojo
+         * @param nivel Nivel del mensaje
+         */
+        explicit Mensaje(Nivel nivel);
+
+        /**
+         * @brief Cierra el mensaje y libera el cerrojo
+         */
+        ~Mensaje();
+
+        /**
+         * @brief Flujo donde se formatea el mensaje
+         * @return Referencia al flujo del registro
+         */
+        std::ostream& flujo();
+
+    private:
+        Mensaje(const Mensaje&);
+        Mensaje& operator=(const Mensaje&);
+    };
+
+    /**
+     * @brief Indica si un nivel está habilitado (compilación y ejecución)
+     * @param nivel Nivel a consultar
+     * @return true si los mensajes de ese nivel se emiten
+     */
+    static bool habilitado(Nivel nivel) {
+        return static_cast<int>(nivel) <= IOT_LOG_NIVEL && nivel <= nivelActual;
+    }
+
+    /**
+     * @brief Cambia el nivel en tiempo de ejecución
+     * @param nivel Nuevo nivel (no puede superar IOT_LOG_NIVEL)
+     */
+    static void establecerNivel(Nivel nivel);
+
+    /**
+     * @brief Obtiene el nivel en tiempo de ejecución
+     * @return Nivel actual
+     */
+    static Nivel obtenerNivel();
+
+    /**
+     * @brief Cambia el destino de los mensajes (por defecto stdout)
+     * @param destino Archivo abierto donde escribir
+     */
+    static void establecerDestino(std::FILE* destino);
+
+    /**
+     * @brief Activa o desactiva el modo bufferizado
+     * @param activo true para volcar solo al llenarse el buffer
+     */
+    static void establecerBufferizado(bool activo);
+
+    /**
+     * @brief Vuelca al destino todo lo pendiente en el buffer
+     */
+    static void vaciar();
+
+private:
+    static Nivel nivelActual;  ///< Nivel en tiempo de ejecución
+};
+
+/**
+ * @brief Emite un mensaje si su nivel está habilitado
+ *
+ * Uso: IOT_LOG(Log::INFO, "Sensor " << nombre << " creado.\n");
+ */
+#define IOT_LOG(nivel, expr)                          \
+    do {                                              \
+        if (::Log::habilitado(nivel)) {               \
+            ::Log::Mensaje iotLogMensaje_(nivel);     \
+            iotLogMensaje_.flujo() << expr;           \
+        }                                             \
+    } while (0)
+
+#if IOT_LOG_NIVEL >= IOT_LOG_ERROR
+#define LOG_ERROR(expr) IOT_LOG(::Log::ERROR, expr)
+#else
+#define LOG_ERROR(expr) ((void)0)
+#endif
+
+#if IOT_LOG_NIVEL >= IOT_LOG_AVISO
+#define LOG_AVISO(expr) IOT_LOG(::Log::AVISO, expr)
+#else
+#define LOG_AVISO(expr) ((void)0)
+#endif
+
+#if IOT_LOG_NIVEL >= IOT_LOG_INFO
+#define LOG_INFO(expr) IOT_LOG(::Log::INFO, expr)
+#else
+#define LOG_INFO(expr) ((void)0)
+#endif
+
+#if IOT_LOG_NIVEL >= IOT_LOG_TRAZA
+#define LOG_TRAZA(expr) IOT_LOG(::Log::TRAZA, expr)
+#else
+#define LOG_TRAZA(expr) ((void)0)
+#endif
+
+#endif // LOG_H
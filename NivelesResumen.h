@@ -0,0 +1,347 @@
+/**
+ * @file NivelesResumen.h
+ * @brief Resúmenes por minuto y por hora de las lecturas de un sensor
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef NIVELESRESUMEN_H
+#define NIVELESRESUMEN_H
+
+#include <cstdint>
+#include <iostream>
+#include "AgregadosLecturas.h"
+
+/**
+ * @brief Mínimo, máximo y agregados de las lecturas de un intervalo
+ * @tparam T Tipo de dato de las lecturas
+ */
+template <typename T>
+struct ResumenIntervalo {
+    int64_t inicioMs;                ///< Comienzo del intervalo (ms)
+    AgregadosLecturas<T> agregados;  ///< Suma, cuenta y suma de cuadrados
+    T minimo;                        ///< Menor lectura (válido si hay lecturas)
+    T maximo;                        ///< Mayor lectura (válido si hay lecturas)
+
+    ResumenIntervalo() : inicioMs(0), minimo(T()), maximo(T()) {}
+
+    /**
+     * @brief Incorpora una lectura
+     */
+    void agregar(T valor) {
+        if (agregados.obtenerCuenta() == 0 || valor < minimo) {
+            minimo = valor;
+        }
+        if (agregados.obtenerCuenta() == 0 || maximo < valor) {
+            maximo = valor;
+        }
+        agregados.agregar(valor);
+    }
+
+    /**
+     * @brief Incorpora n lecturas contiguas (mínimo, máximo y sumas con SIMD)
+     */
+    void agregarTramo(const T* valores, int n) {
+        if (n <= 0) {
+            return;
+        }
+        T menor = KernelsLecturas::minimo(valores, n);
+        T mayor = KernelsLecturas::maximo(valores, n);
+        if (agregados.obtenerCuenta() == 0 || menor < minimo) {
+            minimo = menor;
+        }
+        if (agregados.obtenerCuenta() == 0 || maximo < mayor) {
+            maximo = mayor;
+        }
+        agregados.agregarTramo(valores, n);
+    }
+
+    /**
+     * @brief Incorpora el resumen de otro intervalo
+     */
+    void combinar(const ResumenIntervalo& otro) {
+        if (otro.agregados.obtenerCuenta() == 0) {
+            return;
+        }
+        if (agregados.obtenerCuenta() == 0 || otro.minimo < minimo) {
+            minimo = otro.minimo;
+        }
+        if (agregados.obtenerCuenta() == 0 || maximo < otro.maximo) {
+            maximo = otro.maximo;
+        }
+        agregados.combinar(otro.agregados);
+    }
+
+    /**
+     * @brief Número de lecturas resumidas
+     */
+    int64_t obtenerCuenta() const { return agregados.obtenerCuenta(); }
+};
+
+/**
+ * @class SerieResumen
+ * @brief Un nivel de resumen: intervalos de ancho fijo en un buffer circular
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Cada lectura actualiza el intervalo en curso en O(1); al empezar uno
+ * nuevo, con el buffer lleno, se descarta el más antiguo. La memoria se
+ * reserva con la primera lectura, así que un sensor sin lecturas no paga
+ * nada.
+ */
+template <typename T>
+class SerieResumen {
+private:
+    ResumenIntervalo<T>* casillas;  ///< Intervalos, en orden circular desde inicio
+    int capacidad;                  ///< Intervalos retenidos como máximo
+    int inicio;                     ///< Posición del intervalo más antiguo
+    int tamano;                     ///< Intervalos retenidos
+    int64_t anchoMs;                ///< Duración de cada intervalo
+
+    int posicion(int i) const {
+        int p = inicio + i;
+        return p >= capacidad ? p - capacidad : p;
+    }
+
+    /**
+     * @brief Comienzo del intervalo que contiene un instante
+     */
+    int64_t inicioDe(int64_t instanteMs) const {
+        int64_t resto = instanteMs % anchoMs;
+        return instanteMs - (resto < 0 ? resto + anchoMs : resto);
+    }
+
+    /**
+     * @brief Intervalo donde va una lectura del instante dado
+     *
+     * Una lectura anterior al intervalo en curso (no debería ocurrir con
+     * instantes ordenados) se cuenta en el intervalo en curso.
+     */
+    ResumenIntervalo<T>& intervaloPara(int64_t instanteMs);
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacidad Intervalos retenidos como máximo
+     * @param anchoMs Duración de cada intervalo en milisegundos
+     */
+    SerieResumen(int capacidad, int64_t anchoMs)
+        : casillas(nullptr), capacidad(capacidad > 0 ? capacidad : 1), inicio(0), tamano(0),
+          anchoMs(anchoMs > 0 ? anchoMs : 1) {}
+
+    ~SerieResumen() { delete[] casillas; }
+
+    /**
+     * @brief Incorpora una lectura en O(1)
+     */
+    void agregar(T valor, int64_t instanteMs) {
+        intervaloPara(instanteMs).agregar(valor);
+    }
+
+    /**
+     * @brief Incorpora el resumen de varias lecturas del mismo instante
+     */
+    void combinar(const ResumenIntervalo<T>& resumen, int64_t instanteMs) {
+        intervaloPara(instanteMs).combinar(resumen);
+    }
+
+    /**
+     * @brief Combina los intervalos que empiezan en el de desdeMs o después
+     * @param desdeMs Instante inicial; su intervalo entra completo
+     * @return Resumen combinado (cuenta 0 si no hay ninguno)
+     */
+    ResumenIntervalo<T> resumirDesde(int64_t desdeMs) const;
+
+    /**
+     * @brief Indica si la serie aún conserva el intervalo de un instante
+     */
+    bool cubre(int64_t instanteMs) const {
+        return tamano > 0 && casillas[inicio].inicioMs <= inicioDe(instanteMs);
+    }
+
+    /**
+     * @brief Número de intervalos retenidos
+     */
+    int obtenerTamano() const { return tamano; }
+
+    /**
+     * @brief Intervalo i-ésimo, del más antiguo (0) al más reciente
+     */
+    const ResumenIntervalo<T>& obtener(int i) const { return casillas[posicion(i)]; }
+
+    /**
+     * @brief Duración de cada intervalo
+     */
+    int64_t obtenerAnchoMs() const { return anchoMs; }
+
+private:
+    SerieResumen(const SerieResumen&);
+    SerieResumen& operator=(const SerieResumen&);
+};
+
+/**
+ * @class NivelesResumen
+ * @brief Resúmenes por minuto y por hora mantenidos al insertar
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Los historiales guardan las lecturas en bruto (acotadas o no); estos
+ * niveles guardan, para las últimas MINUTOS_RETENIDOS minutos y
+ * HORAS_RETENIDAS horas, cuenta, suma, suma de cuadrados, mínimo y
+ * máximo. Una consulta de largo plazo combina unas decenas de intervalos
+ * en lugar de recorrer millones de lecturas. Memoria fija por sensor:
+ * (MINUTOS_RETENIDOS + HORAS_RETENIDAS) resúmenes.
+ */
+template <typename T>
+class NivelesResumen {
+public:
+    static const int MINUTOS_RETENIDOS = 120;  ///< Dos horas de resúmenes por minuto
+    static const int HORAS_RETENIDAS = 168;    ///< Una semana de resúmenes por hora
+    static const int64_t MINUTO_MS = 60 * 1000;
+    static const int64_t HORA_MS = 60 * MINUTO_MS;
+
+private:
+    SerieResumen<T> minutos;  ///< Nivel fino
+    SerieResumen<T> horas;    ///< Nivel grueso
+
+public:
+    NivelesResumen()
+        : minutos(MINUTOS_RETENIDOS, MINUTO_MS), horas(HORAS_RETENIDAS, HORA_MS) {}
+
+    /**
+     * @brief Incorpora una lectura a los dos niveles, en O(1)
+     * @param valor Lectura
+     * @param instanteMs Instante de llegada
+     */
+    void agregar(T valor, int64_t instanteMs) {
+        minutos.agregar(valor, instanteMs);
+        horas.agregar(valor, instanteMs);
+    }
+
+    /**
+     * @brief Incorpora un lote llegado en un mismo instante
+     * @param valores Arreglo de lecturas
+     * @param cantidad Número de lecturas
+     * @param instanteMs Instante de llegada del lote
+     *
+     * Resume el lote una vez y lo combina en cada nivel.
+     */
+    void agregarLote(const T* valores, int cantidad, int64_t instanteMs) {
+        ResumenIntervalo<T> lote;
+        lote.agregarTramo(valores, cantidad);
+        minutos.combinar(lote, instanteMs);
+        horas.combinar(lote, instanteMs);
+    }
+
+    /**
+     * @brief Resume las lecturas de los últimos duracionMs
+     * @param duracionMs Duración hacia atrás desde ahoraMs
+     * @param ahoraMs Instante de referencia
+     * @return Resumen con granularidad de intervalo
+     *
+     * Usa los intervalos por minuto si aún cubren el inicio y, si no, los
+     * de hora. El intervalo que contiene el inicio entra completo.
+     */
+    ResumenIntervalo<T> resumirUltimos(int64_t duracionMs, int64_t ahoraMs) const {
+        int64_t desde = ahoraMs - duracionMs;
+        if (minutos.cubre(desde)) {
+            return minutos.resumirDesde(desde);
+        }
+        return horas.resumirDesde(desde);
+    }
+
+    /**
+     * @brief Incorpora un intervalo por minuto guardado (InstantaneaGestion)
+     * @param intervalo Resumen con su inicioMs en el reloj actual
+     *
+     * Los intervalos deben llegar en orden, del más antiguo al más reciente.
+     */
+    void restaurarMinuto(const ResumenIntervalo<T>& intervalo) {
+        minutos.combinar(intervalo, intervalo.inicioMs);
+    }
+
+    /**
+     * @brief Incorpora un intervalo por hora guardado (InstantaneaGestion)
+     */
+    void restaurarHora(const ResumenIntervalo<T>& intervalo) {
+        horas.combinar(intervalo, intervalo.inicioMs);
+    }
+
+    /**
+     * @brief Nivel por minuto
+     */
+    const SerieResumen<T>& obtenerMinutos() const { return minutos; }
+
+    /**
+     * @brief Nivel por hora
+     */
+    const SerieResumen<T>& obtenerHoras() const { return horas; }
+
+    /**
+     * @brief Imprime el resumen de la última hora y de las últimas 24 horas
+     * @param unidad Sufijo de las magnitudes (por ejemplo "°C")
+     * @param ahoraMs Instante de referencia
+     */
+    void imprimir(const char* unidad, int64_t ahoraMs) const;
+};
+
+// ========== IMPLEMENTACIÓN DE LOS MÉTODOS (En el .h por ser template) ==========
+
+template <typename T>
+ResumenIntervalo<T>& SerieResumen<T>::intervaloPara(int64_t instanteMs) {
+    int64_t comienzo = inicioDe(instanteMs);
+    if (tamano > 0) {
+        ResumenIntervalo<T>& ultimo = casillas[posicion(tamano - 1)];
+        if (comienzo <= ultimo.inicioMs) {
+            return ultimo;
+        }
+    }
+
+    if (casillas == nullptr) {
+        casillas = new ResumenIntervalo<T>[capacidad];
+    }
+    if (tamano == capacidad) {
+        inicio = posicion(1);  // Se descarta el intervalo más antiguo
+        tamano--;
+    }
+
+    ResumenIntervalo<T>& nuevo = casillas[posicion(tamano)];
+    nuevo = ResumenIntervalo<T>();
+    nuevo.inicioMs = comienzo;
+    tamano++;
+    return nuevo;
+}
+
+template <typename T>
+ResumenIntervalo<T> SerieResumen<T>::resumirDesde(int64_t desdeMs) const {
+    ResumenIntervalo<T> total;
+    int64_t comienzo = inicioDe(desdeMs);
+    total.inicioMs = comienzo;
+
+    // Del más reciente hacia atrás: solo se tocan los intervalos pedidos
+    for (int i = tamano - 1; i >= 0; i--) {
+        const ResumenIntervalo<T>& intervalo = casillas[posicion(i)];
+        if (intervalo.inicioMs < comienzo) {
+            break;
+        }
+        total.combinar(intervalo);
+    }
+    return total;
+}
+
+template <typename T>
+void NivelesResumen<T>::imprimir(const char* unidad, int64_t ahoraMs) const {
+    const int64_t duraciones[2] = { HORA_MS, 24 * HORA_MS };
+    const char* etiquetas[2] = { "Última hora", "Últimas 24 h" };
+
+    for (int k = 0; k < 2; k++) {
+        ResumenIntervalo<T> resumen = resumirUltimos(duraciones[k], ahoraMs);
+        std::cout << etiquetas[k] << ": " << resumen.obtenerCuenta() << " lecturas";
+        if (resumen.obtenerCuenta() > 0) {
+            std::cout << " (mín " << resumen.minimo << unidad
+                      << ", máx " << resumen.maximo << unidad
+                      << ", prom " << resumen.agregados.promedio() << unidad << ")";
+        }
+        std::cout << "\n";
+    }
+}
+
+#endif // NIVELESRESUMEN_H
@@ -0,0 +1,151 @@
+/**
+ * @file PoolTrabajo.cpp
+ * @brief Implementación del grupo de hilos con robo de trabajo
+ */
+
+#include "PoolTrabajo.h"
+
+PoolTrabajo::PoolTrabajo(int hilos)
+    : numHilos(hilos), tramos(nullptr), hilos(nullptr), ronda(0),
+      auxiliaresActivos(0), terminar(false), tarea(nullptr), robos(0) {
+    if (numHilos <= 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+        if (numHilos <= 0) {
+            numHilos = 1;  // hardware_concurrency() puede no saberlo
+        }
+    }
+
+    tramos = new Tramo[numHilos];
+    this->hilos = new std::thread[numHilos - 1];
+    for (int i = 1; i < numHilos; i++) {
+        this->hilos[i - 1] = std::thread(&PoolTrabajo::bucleAuxiliar, this, i);
+    }
+}
+
+PoolTrabajo::~PoolTrabajo() {
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        terminar = true;
+    }
+    hayTrabajo.notify_all();
+    for (int i = 0; i < numHilos - 1; i++) {
+        hilos[i].join();
+    }
+    delete[] hilos;
+    delete[] tramos;
+}
+
+int PoolTrabajo::obtenerNumeroHilos() const {
+    return numHilos;
+}
+
+unsigned long PoolTrabajo::obtenerRobos() const {
+    return robos.load(std::memory_order_relaxed);
+}
+
+void PoolTrabajo::ejecutar(int cantidad, const std::function<void(int)>& tarea) {
+    if (cantidad <= 0) {
+        return;
+    }
+
+    // Reparto inicial: tramos contiguos de tamaño parecido
+    for (int i = 0; i < numHilos; i++) {
+        uint32_t inicio = static_cast<uint32_t>(static_cast<int64_t>(cantidad) * i / numHilos);
+        uint32_t fin = static_cast<uint32_t>(static_cast<int64_t>(cantidad) * (i + 1) / numHilos);
+        tramos[i].intervalo.store(empaquetar(inicio, fin), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> guarda(cerrojo);
+        this->tarea = &tarea;
+        auxiliaresActivos = numHilos - 1;
+        ronda++;
+    }
+    hayTrabajo.notify_all();
+
+    trabajar(0);
+
+    // Cuando todos los auxiliares salen de trabajar() no queda ninguna tarea
+    std::unique_lock<std::mutex> bloqueo(cerrojo);
+    rondaTerminada.wait(bloqueo, [this] { return auxiliaresActivos == 0; });
+    this->tarea = nullptr;
+}
+
+void PoolTrabajo::bucleAuxiliar(int id) {
+    unsigned long vista = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> bloqueo(cerrojo);
+            hayTrabajo.wait(bloqueo, [this, vista] { return terminar || ronda != vista; });
+            if (terminar) {
+                return;
+            }
+            vista = ronda;
+        }
+
+        trabajar(id);
+
+        {
+            std::lock_guard<std::mutex> guarda(cerrojo);
+            if (--auxiliaresActivos == 0) {
+                rondaTerminada.notify_one();
+            }
+        }
+    }
+}
+
+void PoolTrabajo::trabajar(int id) {
+    int indice;
+    while (true) {
+        if (tomarPropia(id, indice)) {
+            (*tarea)(indice);
+        } else if (!robar(id)) {
+            return;
+        }
+    }
+}
+
+bool PoolTrabajo::tomarPropia(int id, int& indice) {
+    std::atomic<uint64_t>& intervalo = tramos[id].intervalo;
+    uint64_t actual = intervalo.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t inicio = static_cast<uint32_t>(actual);
+        uint32_t fin = static_cast<uint32_t>(actual >> 32);
+        if (inicio >= fin) {
+            return false;
+        }
+        // Si un ladrón recortó el tramo, el CAS falla y se reintenta
+        if (intervalo.compare_exchange_weak(actual, empaquetar(inicio + 1, fin),
+                                            std::memory_order_acq_rel)) {
+            indice = static_cast<int>(inicio);
+            return true;
+        }
+    }
+}
+
+bool PoolTrabajo::robar(int id) {
+    for (int k = 1; k < numHilos; k++) {
+        int victima = (id + k) % numHilos;
+        std::atomic<uint64_t>& intervalo = tramos[victima].intervalo;
+        uint64_t actual = intervalo.load(std::memory_order_acquire);
+
+        while (true) {
+            uint32_t inicio = static_cast<uint32_t>(actual);
+            uint32_t fin = static_cast<uint32_t>(actual >> 32);
+            if (inicio >= fin) {
+                break;  // Nada que robar aquí: siguiente víctima
+            }
+
+            // La mitad final (al menos una tarea) pasa al ladrón
+            uint32_t mitad = (fin - inicio + 1) / 2;
+            if (intervalo.compare_exchange_weak(actual, empaquetar(inicio, fin - mitad),
+                                                std::memory_order_acq_rel)) {
+                tramos[id].intervalo.store(empaquetar(fin - mitad, fin),
+                                           std::memory_order_release);
+                robos.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file PoolTrabajo.h
+ * @brief Grupo de hilos persistentes con reparto por robo de trabajo
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef POOLTRABAJO_H
+#define POOLTRABAJO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class PoolTrabajo
+ * @brief Ejecuta tareas indexadas 0..n-1 en varios hilos (work stealing)
+ *
+ * ejecutar() reparte los índices en tramos contiguos, uno por hilo (el
+ * hilo que llama también trabaja). Cada hilo consume su tramo por el
+ * principio; cuando se le acaba, roba la mitad final del tramo de otro
+ * hilo. Así una tarea muy larga (un sensor con un historial enorme) solo
+ * ocupa a su hilo, y las tareas que le seguían en el tramo se las llevan
+ * los demás.
+ *
+ * Cada tramo es un par [inicio, fin) empaquetado en un único entero
+ * atómico de 64 bits: el dueño avanza inicio y los ladrones recortan fin,
+ * ambos con compare-and-swap, sin mutex en el reparto. Los hilos se crean
+ * una vez y duermen en una variable de condición entre llamadas.
+ */
+class PoolTrabajo {
+private:
+    /**
+     * @brief Tramo de índices pendiente de un hilo, en su propia línea de caché
+     */
+    struct Tramo {
+        std::atomic<uint64_t> intervalo;  ///< (fin << 32) | inicio
+        char relleno[64 - sizeof(std::atomic<uint64_t>)];
+
+        Tramo() : intervalo(0) {}
+    };
+
+    int numHilos;                 ///< Participantes, incluido el que llama
+    Tramo* tramos;                ///< Un tramo por participante
+    std::thread* hilos;           ///< numHilos - 1 hilos auxiliares
+
+    std::mutex cerrojo;                       ///< Protege el estado de la ronda
+    std::condition_variable hayTrabajo;       ///< Despierta a los auxiliares
+    std::condition_variable rondaTerminada;   ///< Avisa al que llamó
+    unsigned long ronda;          ///< Número de la ronda en curso
+    int auxiliaresActivos;        ///< Auxiliares que aún no acabaron la ronda
+    bool terminar;                ///< Pide a los auxiliares que salgan
+    const std::function<void(int)>* tarea;  ///< Tarea de la ronda en curso
+
+    std::atomic<unsigned long> robos;  ///< Tramos robados (estadística)
+
+    static uint64_t empaquetar(uint32_t inicio, uint32_t fin) {
+        return (static_cast<uint64_t>(fin) << 32) | inicio;
+    }
+
+    /**
+     * @brief Cuerpo de un hilo auxiliar
+     * @param id Índice del participante (1..numHilos-1)
+     */
+    void bucleAuxiliar(int id);
+
+    /**
+     * @brief Ejecuta tareas propias y robadas hasta que no quede ninguna
+     * @param id Índice del participante
+     */
+    void trabajar(int id);
+
+    /**
+     * @brief Toma el primer índice del tramo propio
+     * @param id Índice del participante
+     * @param indice Índice obtenido
+     * @return false si el tramo propio está vacío
+     */
+    bool tomarPropia(int id, int& indice);
+
+    /**
+     * @brief Roba la mitad final del tramo de otro participante
+     * @param id Índice del participante ladrón
+     * @return false si todos los tramos están vacíos
+     */
+    bool robar(int id);
+
+public:
+    /**
+     * @brief Crea el grupo de hilos
+     * @param hilos Participantes (0 = núcleos disponibles)
+     */
+    explicit PoolTrabajo(int hilos = 0);
+
+    /**
+     * @brief Destructor - Detiene y espera a los hilos auxiliares
+     */
+    ~PoolTrabajo();
+
+    /**
+     * @brief Ejecuta tarea(i) para i en [0, cantidad) y espera a que terminen
+     * @param cantidad Número de tareas
+     * @param tarea Función a ejecutar; se llama una vez por índice
+     *
+     * Las tareas de distintos índices pueden correr a la vez, así que no
+     * deben compartir datos sin sincronizar.
+     */
+    void ejecutar(int cantidad, const std::function<void(int)>& tarea);
+
+    /**
+     * @brief Obtiene el número de participantes
+     * @return Hilos que ejecutan tareas, incluido el que llama
+     */
+    int obtenerNumeroHilos() const;
+
+    /**
+     * @brief Obtiene cuántos tramos se han robado desde la creación
+     * @return Contador de robos
+     */
+    unsigned long obtenerRobos() const;
+
+private:
+    PoolTrabajo(const PoolTrabajo&);
+    PoolTrabajo& operator=(const PoolTrabajo&);
+};
+
+#endif // POOLTRABAJO_H
@@ -0,0 +1,299 @@
+/**
+ * @file PuertoSerial.cpp
+ * @brief Implementación del puerto serial POSIX
+ */
+
+#include "PuertoSerial.h"
+#include "Log.h"
+#include <cstring>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+PuertoSerial::PuertoSerial()
+    : descriptor(-1), usados(0), lineasDescartadas(0) {
+}
+
+PuertoSerial::~PuertoSerial() {
+    cerrar();
+}
+
+bool PuertoSerial::estaAbierto() const {
+    return descriptor >= 0;
+}
+
+unsigned long PuertoSerial::obtenerLineasDescartadas() const {
+    return lineasDescartadas;
+}
+
+int PuertoSerial::extraerLinea(char* destino, int capacidad) {
+    for (int i = 0; i < usados; i++) {
+        if (pendiente[i] != '\n') {
+            continue;
+        }
+
+        // Longitud sin '\r' final (Serial.println envía "\r\n")
+        int longitud = i;
+        if (longitud > 0 && pendiente[longitud - 1] == '\r') {
+            longitud--;
+        }
+        int copia = longitud < capacidad - 1 ? longitud : capacidad - 1;
+        memcpy(destino, pendiente, static_cast<size_t>(copia));
+        destino[copia] = '\0';
+
+        // Desplaza lo que queda tras el '\n'
+        int resto = usados - (i + 1);
+        memmove(pendiente, pendiente + i + 1, static_cast<size_t>(resto));
+        usados = resto;
+        return copia;
+    }
+    return -1;
+}
+
+bool PuertoSerial::velocidadSoportada(int baudios) {
+    return baudios == 9600 || baudios == 19200 || baudios == 38400 ||
+           baudios == 57600 || baudios == 115200;
+}
+
+#ifndef _WIN32
+
+namespace {
+
+speed_t velocidadTermios(int baudios) {
+    switch (baudios) {
+        case 19200:  return B19200;
+        case 38400:  return B38400;
+        case 57600:  return B57600;
+        case 115200: return B115200;
+        default:     return B9600;  // abrir() ya rechazó las no soportadas
+    }
+}
+
+long milisegundosMonotonicos() {
+    timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return static_cast<long>(ahora.tv_sec) * 1000L + ahora.tv_nsec / 1000000L;
+}
+
+} // namespace
+
+bool PuertoSerial::abrir(const char* ruta, int baudios) {
+    cerrar();
+
+    if (!velocidadSoportada(baudios)) {
+        LOG_AVISO("[Serial] Velocidad no soportada para " << ruta << ": " << baudios
+                  << " baudios (use 9600, 19200, 38400, 57600 o 115200).\n");
+        return false;
+    }
+
+    int fd = open(ruta, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        LOG_AVISO("[Serial] No se pudo abrir " << ruta << ": " << strerror(errno) << "\n");
+        return false;
+    }
+
+    termios opciones;
+    if (tcgetattr(fd, &opciones) != 0) {
+        LOG_AVISO("[Serial] " << ruta << " no es un terminal: " << strerror(errno) << "\n");
+        close(fd);
+        return false;
+    }
+
+    // Modo crudo 8N1, sin control de flujo, lectura habilitada
+    cfmakeraw(&opciones);
+    opciones.c_cflag |= (CLOCAL | CREAD);
+    opciones.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+    opciones.c_cflag |= CS8;
+    opciones.c_cc[VMIN] = 0;
+    opciones.c_cc[VTIME] = 0;
+    cfsetispeed(&opciones, velocidadTermios(baudios));
+    cfsetospeed(&opciones, velocidadTermios(baudios));
+
+    if (tcsetattr(fd, TCSANOW, &opciones) != 0) {
+        LOG_AVISO("[Serial] No se pudo configurar " << ruta << ": " << strerror(errno) << "\n");
+        close(fd);
+        return false;
+    }
+    tcflush(fd, TCIFLUSH);
+
+    descriptor = fd;
+    usados = 0;
+    LOG_INFO("[Serial] " << ruta << " abierto a " << baudios << " baudios.\n");
+    return true;
+}
+
+void PuertoSerial::cerrar() {
+    if (descriptor >= 0) {
+        close(descriptor);
+        descriptor = -1;
+    }
+    usados = 0;
+}
+
+int PuertoSerial::rellenar() {
+    if (usados == CAPACIDAD_LINEA) {
+        // Línea sin '\n' que no cabe: se descarta para resincronizar
+        usados = 0;
+        lineasDescartadas++;
+    }
+
+    ssize_t leidos = read(descriptor, pendiente + usados,
+                          static_cast<size_t>(CAPACIDAD_LINEA - usados));
+    if (leidos > 0) {
+        usados += static_cast<int>(leidos);
+        return static_cast<int>(leidos);
+    }
+    if (leidos == 0) {
+        return -1;  // Fin de archivo: el otro extremo cerró
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        return 0;
+    }
+    return -1;
+}
+
+int PuertoSerial::leerLinea(char* destino, int capacidad, int esperaMs) {
+    if (descriptor < 0 || capacidad <= 0) {
+        return -1;
+    }
+
+    long limite = milisegundosMonotonicos() + esperaMs;
+    while (true) {
+        int longitud = extraerLinea(destino, capacidad);
+        if (longitud >= 0) {
+            return longitud;
+        }
+
+        long restante = limite - milisegundosMonotonicos();
+        if (restante < 0) {
+            restante = 0;
+        }
+
+        pollfd espera;
+        espera.fd = descriptor;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        int listo = poll(&espera, 1, static_cast<int>(restante));
+        if (listo < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (listo == 0) {
+            return 0;  // Se agotó la espera sin una línea completa
+        }
+        if (espera.revents & (POLLERR | POLLNVAL)) {
+            return -1;
+        }
+        if (rellenar() < 0) {
+            return -1;
+        }
+    }
+}
+
+int PuertoSerial::leer(char* destino, int capacidad, int esperaMs) {
+    if (descriptor < 0 || capacidad <= 0) {
+        return -1;
+    }
+
+    if (usados > 0) {
+        // Primero lo que quedó pendiente de leerLinea()
+        int copia = usados < capacidad ? usados : capacidad;
+        memcpy(destino, pendiente, static_cast<size_t>(copia));
+        memmove(pendiente, pendiente + copia, static_cast<size_t>(usados - copia));
+        usados -= copia;
+        return copia;
+    }
+
+    long limite = milisegundosMonotonicos() + esperaMs;
+    while (true) {
+        long restante = limite - milisegundosMonotonicos();
+        if (restante < 0) {
+            restante = 0;
+        }
+
+        pollfd espera;
+        espera.fd = descriptor;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        int listo = poll(&espera, 1, static_cast<int>(restante));
+        if (listo < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (listo == 0) {
+            return 0;  // Se agotó la espera sin datos
+        }
+        if (espera.revents & (POLLERR | POLLNVAL)) {
+            return -1;
+        }
+
+        ssize_t leidos = read(descriptor, destino, static_cast<size_t>(capacidad));
+        if (leidos > 0) {
+            return static_cast<int>(leidos);
+        }
+        if (leidos == 0) {
+            return -1;  // Fin de archivo: el otro extremo cerró
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            continue;
+        }
+        return -1;
+    }
+}
+
+bool PuertoSerial::hayLineaDisponible() {
+    if (descriptor < 0) {
+        return false;
+    }
+    for (int i = 0; i < usados; i++) {
+        if (pendiente[i] == '\n') {
+            return true;
+        }
+    }
+    rellenar();
+    for (int i = 0; i < usados; i++) {
+        if (pendiente[i] == '\n') {
+            return true;
+        }
+    }
+    return false;
+}
+
+#else  // _WIN32: sin backend serial; ArduinoSimulador usa datos simulados
+
+bool PuertoSerial::abrir(const char* ruta, int) {
+    LOG_AVISO("[Serial] Puerto " << ruta << " no soportado en esta plataforma.\n");
+    return false;
+}
+
+void PuertoSerial::cerrar() {
+    usados = 0;
+}
+
+int PuertoSerial::rellenar() {
+    return -1;
+}
+
+int PuertoSerial::leerLinea(char*, int, int) {
+    return -1;
+}
+
+int PuertoSerial::leer(char*, int, int) {
+    return -1;
+}
+
+bool PuertoSerial::hayLineaDisponible() {
+    return false;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file PuertoSerial.h
+ * @brief Acceso a un puerto serial POSIX (termios) con lectura no bloqueante
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef PUERTOSERIAL_H
+#define PUERTOSERIAL_H
+
+/**
+ * @class PuertoSerial
+ * @brief Puerto serial configurado con termios y leído con poll()
+ *
+ * Abre el dispositivo en modo no bloqueante, lo configura en modo crudo
+ * 8N1 a la velocidad pedida y ensambla líneas terminadas en '\n' (el
+ * '\r' de Serial.println se descarta). Funciona igual sobre un puerto
+ * real (/dev/ttyUSB0, /dev/ttyACM0) que sobre el extremo esclavo de un
+ * pseudo-terminal creado con openpty(), lo que permite probar la captura
+ * sin hardware.
+ */
+class PuertoSerial {
+public:
+    static const int CAPACIDAD_LINEA = 256;  ///< Bytes máximos por línea
+
+private:
+    int descriptor;                    ///< Descriptor del puerto (-1 si cerrado)
+    char pendiente[CAPACIDAD_LINEA];   ///< Bytes recibidos sin '\n' todavía
+    int usados;                        ///< Bytes válidos en pendiente
+    unsigned long lineasDescartadas;   ///< Líneas demasiado largas descartadas
+
+    /**
+     * @brief Extrae una línea completa del buffer pendiente, si la hay
+     * @param destino Buffer de salida
+     * @param capacidad Tamaño de destino
+     * @return Longitud de la línea, o -1 si no hay línea completa
+     */
+    int extraerLinea(char* destino, int capacidad);
+
+    /**
+     * @brief Lee del descriptor lo que haya disponible
+     * @return Bytes leídos, 0 si no había datos, -1 si el puerto se cerró
+     */
+    int rellenar();
+
+public:
+    /**
+     * @brief Constructor (puerto cerrado)
+     */
+    PuertoSerial();
+
+    /**
+     * @brief Destructor - Cierra el puerto si sigue abierto
+     */
+    ~PuertoSerial();
+
+    /**
+     * @brief Abre y configura el puerto
+     * @param ruta Ruta del dispositivo (ej: "/dev/ttyUSB0")
+     * @param baudios Velocidad (9600, 19200, 38400, 57600 o 115200)
+     * @return true si el puerto quedó abierto y configurado; false también
+     *         si la velocidad no está entre las soportadas
+     */
+    bool abrir(const char* ruta, int baudios);
+
+    /**
+     * @brief Indica si abrir() admite una velocidad
+     * @param baudios Velocidad en baudios
+     * @return true para 9600, 19200, 38400, 57600 y 115200
+     */
+    static bool velocidadSoportada(int baudios);
+
+    /**
+     * @brief Cierra el puerto y descarta los datos pendientes
+     */
+    void cerrar();
+
+    /**
+     * @brief Indica si el puerto está abierto
+     * @return true si hay un descriptor válido
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Lee la siguiente línea completa
+     * @param destino Buffer donde se copia la línea (sin "\r\n")
+     * @param capacidad Tamaño de destino
+     * @param esperaMs Tiempo máximo de espera (0 = no esperar)
+     * @return Longitud de la línea; 0 si no llegó ninguna a tiempo;
+     *         -1 si el puerto se cerró o falló
+     */
+    int leerLinea(char* destino, int capacidad, int esperaMs);
+
+    /**
+     * @brief Lee los bytes crudos que haya disponibles, sin ensamblar líneas
+     * @param destino Buffer de salida
+     * @param capacidad Tamaño de destino
+     * @param esperaMs Tiempo máximo de espera (0 = no esperar)
+     * @return Bytes leídos; 0 si no llegó nada a tiempo; -1 si el puerto
+     *         se cerró o falló
+     *
+     * Pensado para AnalizadorTramas, que ensambla las tramas él mismo. Si
+     * quedaban bytes de una leerLinea() anterior, se entregan primero.
+     */
+    int leer(char* destino, int capacidad, int esperaMs);
+
+    /**
+     * @brief Indica si hay una línea completa lista sin bloquear
+     * @return true si leerLinea(..., 0) devolvería una línea
+     */
+    bool hayLineaDisponible();
+
+    /**
+     * @brief Obtiene el número de líneas descartadas por exceso de longitud
+     * @return Contador de líneas descartadas
+     */
+    unsigned long obtenerLineasDescartadas() const;
+
+private:
+    PuertoSerial(const PuertoSerial&);
+    PuertoSerial& operator=(const PuertoSerial&);
+};
+
+#endif // PUERTOSERIAL_H
@@ -0,0 +1,66 @@
+/**
+ * @file RitmoCaptura.cpp
+ * @brief Implementación del control de ritmo de captura
+ */
+
+#include "RitmoCaptura.h"
+#include <thread>
+
+RitmoCaptura::RitmoCaptura(double lecturasPorSegundo)
+    : frecuencia(lecturasPorSegundo > 0.0 ? lecturasPorSegundo : 0.0),
+      periodo(Reloj::duration::zero()), lecturas(0), detenido(false) {
+    if (frecuencia > 0.0) {
+        periodo = std::chrono::duration_cast<Reloj::duration>(
+            std::chrono::duration<double>(1.0 / frecuencia));
+    }
+    inicio = proxima = fin = Reloj::now();
+}
+
+void RitmoCaptura::iniciar() {
+    inicio = proxima = Reloj::now();
+    lecturas = 0;
+    detenido = false;
+}
+
+void RitmoCaptura::esperarSiguiente() {
+    if (frecuencia <= 0.0) {
+        return;
+    }
+
+    // Plazo absoluto: un retraso puntual no desplaza los turnos siguientes
+    proxima += periodo;
+    Reloj::time_point ahora = Reloj::now();
+    if (proxima > ahora) {
+        std::this_thread::sleep_until(proxima);
+    } else if (ahora - proxima > periodo * 4) {
+        // La fuente va muy atrasada: se reancla en lugar de ráfagas de recuperación
+        proxima = ahora;
+    }
+}
+
+void RitmoCaptura::contarLectura() {
+    lecturas++;
+}
+
+void RitmoCaptura::detener() {
+    fin = Reloj::now();
+    detenido = true;
+}
+
+bool RitmoCaptura::esPausado() const {
+    return frecuencia > 0.0;
+}
+
+unsigned long RitmoCaptura::obtenerLecturas() const {
+    return lecturas;
+}
+
+double RitmoCaptura::obtenerSegundos() const {
+    Reloj::time_point hasta = detenido ? fin : Reloj::now();
+    return std::chrono::duration<double>(hasta - inicio).count();
+}
+
+double RitmoCaptura::obtenerLecturasPorSegundo() const {
+    double segundos = obtenerSegundos();
+    return segundos > 0.0 ? static_cast<double>(lecturas) / segundos : 0.0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file RitmoCaptura.h
+ * @brief Control de ritmo para la captura de lecturas (reloj monotónico)
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef RITMOCAPTURA_H
+#define RITMOCAPTURA_H
+
+#include <chrono>
+
+/**
+ * @class RitmoCaptura
+ * @brief Marca el paso de una captura a una frecuencia fija o sin pausas
+ *
+ * Con una frecuencia positiva, esperarSiguiente() duerme hasta el instante
+ * absoluto inicio + k·periodo (sleep_until sobre steady_clock), de modo que
+ * los retrasos de una lectura no se acumulan en las siguientes y el hilo
+ * no consume CPU mientras espera. Con frecuencia 0 no hay pausas: la
+ * captura avanza tan rápido como la fuente entrega datos.
+ */
+class RitmoCaptura {
+private:
+    typedef std::chrono::steady_clock Reloj;
+
+    double frecuencia;            ///< Lecturas por segundo (0 = sin pausa)
+    Reloj::duration periodo;      ///< Tiempo entre lecturas consecutivas
+    Reloj::time_point inicio;     ///< Instante de iniciar()
+    Reloj::time_point proxima;    ///< Instante objetivo de la próxima lectura
+    Reloj::time_point fin;        ///< Instante de detener()
+    unsigned long lecturas;       ///< Lecturas contabilizadas
+    bool detenido;                ///< true tras detener()
+
+public:
+    /**
+     * @brief Constructor
+     * @param lecturasPorSegundo Frecuencia deseada; 0 = máximo rendimiento
+     */
+    explicit RitmoCaptura(double lecturasPorSegundo);
+
+    /**
+     * @brief Marca el inicio de la captura
+     */
+    void iniciar();
+
+    /**
+     * @brief Duerme hasta el turno de la siguiente lectura
+     *
+     * No hace nada en modo de máximo rendimiento.
+     */
+    void esperarSiguiente();
+
+    /**
+     * @brief Contabiliza una lectura registrada
+     */
+    void contarLectura();
+
+    /**
+     * @brief Marca el final de la captura
+     */
+    void detener();
+
+    /**
+     * @brief Indica si la captura está limitada en frecuencia
+     * @return false en modo de máximo rendimiento
+     */
+    bool esPausado() const;
+
+    /**
+     * @brief Obtiene las lecturas contabilizadas
+     * @return Número de lecturas
+     */
+    unsigned long obtenerLecturas() const;
+
+    /**
+     * @brief Segundos entre iniciar() y detener() (o el instante actual)
+     * @return Duración en segundos
+     */
+    double obtenerSegundos() const;
+
+    /**
+     * @brief Rendimiento observado
+     * @return Lecturas por segundo (0 si no transcurrió tiempo)
+     */
+    double obtenerLecturasPorSegundo() const;
+};
+
+#endif // RITMOCAPTURA_H
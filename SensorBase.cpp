@@ -4,18 +4,91 @@
  */
 
 #include "SensorBase.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "Log.h"
 #include <cstring>
 
 SensorBase::SensorBase(const char* nombre) {
     // Copia segura del nombre del sensor
     strncpy(this->nombre, nombre, 49);
     this->nombre[49] = '\0';  // Asegura terminación nula
+    hashNombre = calcularHash(this->nombre);
+    salida = &std::cout;
+    diario = nullptr;
+    secuencia = 0;
 }
 
 SensorBase::~SensorBase() {
-    std::cout << "[Destructor Base] Sensor " << nombre << " liberado.\n";
+    LOG_INFO("[Destructor Base] Sensor " << nombre << " liberado.\n");
+}
+
+void SensorBase::redirigirSalida(std::ostream* destino) {
+    salida = destino != nullptr ? destino : &std::cout;
+}
+
+void SensorBase::conectarDiario(DiarioLecturas* destino) {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    diario = destino;
+    if (diario != nullptr) {
+        // Su registro precede en el diario a todas sus lecturas
+        diario->registrarSensor(hashNombre, obtenerTipo(), nombre);
+    }
+}
+
+uint64_t SensorBase::obtenerSecuencia() const {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    return secuencia;
+}
+
+SensorBase* SensorBase::crearDeTipo(char tipo, const char* nombre) {
+    switch (tipo) {
+        case 'T':
+            return new SensorTemperatura(nombre);
+        case 'P':
+            return new SensorPresion(nombre);
+        default:
+            return nullptr;
+    }
 }
 
 const char* SensorBase::obtenerNombre() const {
     return nombre;
 }
+
+uint64_t SensorBase::obtenerHashNombre() const {
+    return hashNombre;
+}
+
+bool SensorBase::siguienteValor(const char* buffer, size_t longitud, size_t& posicion,
+                                char* token, size_t capacidad) {
+    // Salta separadores
+    while (posicion < longitud && strchr(" \t\r\n,;", buffer[posicion]) != nullptr
+           && buffer[posicion] != '\0') {
+        posicion++;
+    }
+    if (posicion >= longitud || buffer[posicion] == '\0') {
+        return false;
+    }
+
+    // Copia el valor hasta el siguiente separador (truncando si no cabe)
+    size_t usados = 0;
+    while (posicion < longitud && buffer[posicion] != '\0'
+           && strchr(" \t\r\n,;", buffer[posicion]) == nullptr) {
+        if (usados + 1 < capacidad) {
+            token[usados++] = buffer[posicion];
+        }
+        posicion++;
+    }
+    token[usados] = '\0';
+    return true;
+}
+
+uint64_t SensorBase::calcularHash(const char* texto) {
+    uint64_t hash = 14695981039346656037ULL;  // Base FNV-1a
+    while (*texto != '\0') {
+        hash ^= static_cast<unsigned char>(*texto++);
+        hash *= 1099511628211ULL;                 // Primo FNV-1a
+    }
+    return hash;
+}
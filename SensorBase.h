@@ -8,7 +8,13 @@
 #ifndef SENSORBASE_H
 #define SENSORBASE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
+
+struct LecturaTrama;
+class DiarioLecturas;
 
 /**
  * @class SensorBase
@@ -20,6 +26,56 @@
 class SensorBase {
 protected:
     char nombre[50];  ///< Identificador único del sensor
+    uint64_t hashNombre;  ///< Hash FNV-1a del nombre, calculado una sola vez
+    std::ostream* salida; ///< Destino del informe de procesarLectura()
+    DiarioLecturas* diario;  ///< Registro de escritura anticipada (nullptr = sin durabilidad)
+    uint64_t secuencia;      ///< Lecturas aceptadas desde la creación (número de la última)
+
+    /**
+     * @brief Protege el historial de la clase derivada
+     *
+     * Permite registrar lecturas desde un hilo (captura) mientras otro
+     * procesa o imprime el sensor. Cada sensor tiene el suyo, así que
+     * sensores distintos nunca compiten. Orden de cerrojos: primero el del
+     * sensor, después el del log; nunca dos sensores a la vez.
+     */
+    mutable std::mutex cerrojoHistorial;
+
+    /**
+     * @brief Anota en el diario las lecturas recién aceptadas
+     * @param valores Lecturas, en el orden en que entraron al historial
+     * @param cantidad Número de lecturas
+     * @param instante Instante de llegada (reloj monotónico, ms)
+     *
+     * Numera las lecturas a continuación de secuencia. Debe llamarse con
+     * cerrojoHistorial tomado, así el diario recibe las lecturas de cada
+     * sensor en el mismo orden que su historial.
+     */
+    template <typename T>
+    void anotarEnDiario(const T* valores, int cantidad, int64_t instante);
+
+    /**
+     * @brief Flujo donde procesarLectura() escribe su informe
+     * @return std::cout, salvo que se haya redirigido con redirigirSalida()
+     */
+    std::ostream& informe() const { return *salida; }
+
+    /// Lecturas que los sensores convierten por tramo en registrarLoteDesdeBuffer()
+    static const int TRAMO_LOTE = 256;
+
+    /**
+     * @brief Extrae el siguiente valor en texto de un buffer de lote
+     * @param buffer Texto del lote
+     * @param longitud Bytes válidos en buffer
+     * @param posicion Posición de lectura; se avanza tras el valor
+     * @param token Destino del valor, terminado en nulo
+     * @param capacidad Tamaño de token
+     * @return true si se extrajo un valor, false al llegar al final
+     *
+     * Los separadores son espacios, tabuladores, comas, ';' y saltos de línea.
+     */
+    static bool siguienteValor(const char* buffer, size_t longitud, size_t& posicion,
+                               char* token, size_t capacidad);
 
 public:
     /**
@@ -47,6 +103,15 @@ public:
      */
     virtual void procesarLectura() = 0;
 
+    /**
+     * @brief Redirige el informe de procesarLectura()
+     * @param destino Flujo de salida, o nullptr para volver a std::cout
+     *
+     * Permite procesar sensores en paralelo, cada uno sobre su propio
+     * buffer, e imprimir después los informes en orden.
+     */
+    void redirigirSalida(std::ostream* destino);
+
     /**
      * @brief Método virtual puro para imprimir información del sensor
      */
@@ -58,11 +123,149 @@ public:
      */
     virtual void registrarLecturaDesdeString(const char* valor) = 0;
 
+    /**
+     * @brief Método virtual puro para registrar una lectura ya convertida
+     * @param lectura Lectura extraída de una trama por AnalizadorTramas
+     *
+     * Cada sensor toma la forma del valor que le corresponde (real o
+     * entera), sin volver a interpretar texto.
+     */
+    virtual void registrarLecturaTrama(const LecturaTrama& lectura) = 0;
+
+    /**
+     * @brief Método virtual puro para registrar un lote de lecturas en texto
+     * @param buffer Valores separados por espacios, comas o saltos de línea
+     * @param longitud Bytes válidos en buffer (no requiere terminación nula)
+     * @return Número de lecturas registradas
+     *
+     * Convierte el texto por tramos y los agrega con una sola llamada
+     * virtual por lote, en lugar de una por lectura.
+     */
+    virtual size_t registrarLoteDesdeBuffer(const char* buffer, size_t longitud) = 0;
+
+    /**
+     * @brief Método virtual puro para registrar un lote de tramas ya convertidas
+     * @param lecturas Lecturas extraídas por AnalizadorTramas, en orden de llegada
+     * @param cantidad Número de lecturas
+     *
+     * Igual que registrarLecturaTrama() para cada una, pero con un solo
+     * cerrojo y una sola anotación en el diario por tramo de TRAMO_LOTE.
+     */
+    virtual void registrarLoteTramas(const LecturaTrama* lecturas, size_t cantidad) = 0;
+
+    /**
+     * @brief Método virtual puro para acotar el historial del sensor
+     * @param maxLecturas Lecturas retenidas como máximo (0 = historial ilimitado)
+     * @param ventanaMs Antigüedad máxima de una lectura en ms (0 = sin límite)
+     *
+     * Con maxLecturas > 0 el sensor pasa a un HistorialCircular de memoria
+     * fija y su promedio es de ventana deslizante. Las lecturas que ya
+     * tenía se conservan con su instante de llegada (las más recientes,
+     * si no caben todas o ya salieron de la ventana de tiempo).
+     */
+    virtual void configurarRetencion(int maxLecturas, int64_t ventanaMs) = 0;
+
+    /**
+     * @brief Método virtual puro para guardar el historial comprimido
+     * @param activar true para comprimir, false para volver a bloques sin comprimir
+     *
+     * Con activar = true el sensor pasa a un HistorialComprimido: el
+     * historial queda sin límite (se anula configurarRetencion) y cada
+     * lectura ocupa unos pocos bits en lugar de un hueco de bloque.
+     */
+    virtual void configurarCompresion(bool activar) = 0;
+
+    /**
+     * @brief Método virtual puro para reaplicar una lectura del diario
+     * @param numero Número de secuencia de la lectura
+     * @param instante Instante de llegada (reloj monotónico, ms)
+     * @param bitsValor Los 4 bytes del valor tal como se anotaron
+     * @return false si la lectura ya estaba aplicada (numero <= secuencia)
+     *
+     * La usa DiarioLecturas al recuperarse de una caída. La lectura no se
+     * vuelve a anotar en el diario.
+     */
+    virtual bool reproducirLectura(uint64_t numero, int64_t instante, uint32_t bitsValor) = 0;
+
+    /**
+     * @brief Empieza a anotar las lecturas nuevas en un diario
+     * @param destino Diario, o nullptr para dejar de anotar
+     *
+     * Con un diario conectado, cada lectura aceptada se anota con su
+     * número de secuencia antes de que la llamada que la registra vuelva.
+     */
+    void conectarDiario(DiarioLecturas* destino);
+
+    /**
+     * @brief Número de lecturas aceptadas (incluidas las restauradas)
+     */
+    uint64_t obtenerSecuencia() const;
+
+    /**
+     * @brief Crea un sensor vacío a partir de su letra de tipo
+     * @param tipo Letra devuelta por obtenerTipo() ('T', 'P')
+     * @param nombre Identificador del sensor
+     * @return Sensor nuevo (propiedad del que llama) o nullptr si el tipo no se conoce
+     */
+    static SensorBase* crearDeTipo(char tipo, const char* nombre);
+
+    /**
+     * @brief Método virtual puro que identifica la clase concreta del sensor
+     * @return Letra de tipo de trama ('T' temperatura, 'P' presión)
+     *
+     * InstantaneaGestion la guarda para reconstruir el sensor al cargar.
+     */
+    virtual char obtenerTipo() const = 0;
+
+    /**
+     * @brief Método virtual puro para volcar el estado en binario
+     * @param salida Flujo binario donde escribir
+     *
+     * Escribe la retención, el historial completo con sus instantes y los
+     * resúmenes por minuto y por hora (formato en FormatoInstantanea.h).
+     */
+    virtual void guardarEstado(std::ostream& salida) const = 0;
+
+    /**
+     * @brief Método virtual puro para reconstruir el estado desde binario
+     * @param datos Bytes escritos por guardarEstado()
+     * @param longitud Número de bytes
+     * @return false si los datos están truncados o no son válidos
+     *
+     * Se llama sobre un sensor recién creado, antes de registrarlo.
+     */
+    virtual bool restaurarEstado(const char* datos, size_t longitud) = 0;
+
     /**
      * @brief Obtiene el nombre del sensor
      * @return Puntero al array de caracteres con el nombre
      */
     const char* obtenerNombre() const;
+
+    /**
+     * @brief Obtiene el hash precalculado del nombre
+     * @return Hash FNV-1a de obtenerNombre()
+     */
+    uint64_t obtenerHashNombre() const;
+
+    /**
+     * @brief Calcula el hash FNV-1a de 64 bits de una cadena
+     * @param texto Cadena terminada en nulo
+     * @return Hash de la cadena
+     *
+     * Es la misma función que usa ListaGestion para su índice por nombre.
+     */
+    static uint64_t calcularHash(const char* texto);
 };
 
+#include "DiarioLecturas.h"
+
+template <typename T>
+void SensorBase::anotarEnDiario(const T* valores, int cantidad, int64_t instante) {
+    if (diario != nullptr) {
+        diario->anotarLecturas(hashNombre, secuencia + 1, instante, valores, cantidad);
+    }
+    secuencia += static_cast<uint64_t>(cantidad);
+}
+
 #endif // SENSORBASE_H
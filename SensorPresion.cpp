@@ -4,53 +4,246 @@
  */
 
 #include "SensorPresion.h"
-#include <cstdlib>
+#include "AnalizadorTramas.h"
+#include "FormatoInstantanea.h"
+#include "Log.h"
+#include <cstring>
+#include <iomanip>
+
+namespace {
+
+/// Intervalo de la consulta "último minuto" de imprimirInfo()
+const int64_t MINUTO_MS = 60 * 1000;
+
+/// Lecturas en bruto que imprimirInfo() muestra como máximo (el resto, en NivelesResumen)
+const int LECTURAS_MOSTRADAS = 20;
+
+/**
+ * @brief Informe de procesarLectura() sobre cualquiera de los historiales
+ */
+struct ProcesarPresiones {
+    std::ostream& informe;
+    const char* nombre;
+    ProcesarPresiones(std::ostream& informe, const char* nombre) : informe(informe), nombre(nombre) {}
+
+    template <typename Historial>
+    void operator()(const Historial& historial) const {
+        informe << "\n-> Procesando Sensor " << nombre << " (Presión)...\n";
+    
+        if (historial.estaVacia()) {
+            informe << "[" << nombre << "] No hay lecturas para procesar.\n";
+            return;
+        }
+    
+        // Promedio y dispersión salen de los agregados de la lista (O(1))
+        int promedio = historial.calcularPromedio();
+        informe << "[Sensor Presion] Promedio de " << historial.obtenerTamano() 
+                << " lecturas: " << promedio << " kPa\n";
+        informe << "[Sensor Presion] Desviación estándar: "
+                << std::fixed << std::setprecision(2)
+                << historial.calcularDesviacionEstandar() << " kPa\n";
+    }
+};
+
+/**
+ * @brief Lecturas de imprimirInfo() sobre cualquiera de los historiales
+ */
+struct MostrarPresiones {
+    template <typename Historial>
+    void operator()(const Historial& historial) const {
+        std::cout << "Número de lecturas: " << historial.obtenerTamano() << "\n";
+    
+        if (!historial.estaVacia()) {
+            // Consulta por intervalo: salta directamente al último minuto
+            int64_t ahora = instanteActualMs();
+            int64_t desde = ahora - MINUTO_MS;
+            int recientes = historial.contarEnRango(desde, ahora + 1);
+
+            // Solo las últimas lecturas del minuto; lo anterior lo resume NivelesResumen
+            int omitidas = recientes > LECTURAS_MOSTRADAS ? recientes - LECTURAS_MOSTRADAS : 0;
+            std::cout << "Últimas lecturas: [";
+            int vistas = 0;
+            historial.recorrerRango(desde, ahora + 1, [&vistas, omitidas](int valor) {
+                if (vistas >= omitidas) {
+                    std::cout << (vistas > omitidas ? ", " : "") << valor;
+                }
+                vistas++;
+            });
+            std::cout << "]";
+            if (historial.obtenerTamano() > recientes - omitidas) {
+                std::cout << " (las " << historial.obtenerTamano() - (recientes - omitidas)
+                          << " anteriores, en el resumen por minuto y hora)";
+            }
+            std::cout << "\n";
+            std::cout << "Último minuto: " << recientes << " lecturas";
+            if (recientes > 0) {
+                std::cout << ", promedio " << historial.calcularPromedioRango(desde, ahora + 1) << " kPa";
+            }
+            std::cout << "\n";
+        } else {
+            std::cout << "Sin lecturas registradas.\n";
+        }
+    }
+};
+
+} // namespace
 
 SensorPresion::SensorPresion(const char* nombre) 
     : SensorBase(nombre) {
-    std::cout << "[Sensor Presion] " << nombre << " creado.\n";
+    LOG_INFO("[Sensor Presion] " << nombre << " creado.\n");
 }
 
 SensorPresion::~SensorPresion() {
-    std::cout << "[Destructor SensorPresion] " << nombre 
-              << " - Liberando historial de presiones...\n";
-    // El destructor de ListaSensor se encarga automáticamente de liberar memoria
+    LOG_INFO("[Destructor SensorPresion] " << nombre
+             << " - Liberando historial de presiones...\n");
+    // El destructor de HistorialSensor se encarga automáticamente de liberar memoria
 }
 
 void SensorPresion::registrarLectura(int presion) {
-    historial.insertarAlFinal(presion);
-    std::cout << "[" << nombre << "] Presión registrada: " << presion << " kPa\n";
+    {
+        int64_t instante = instanteActualMs();
+        std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+        historial.insertarAlFinal(presion, instante);
+        resumen.agregar(presion, instante);
+        anotarEnDiario(&presion, 1, instante);
+    }
+    LOG_TRAZA("[" << nombre << "] Presión registrada: " << presion << " kPa\n");
 }
 
 void SensorPresion::procesarLectura() {
-    std::cout << "\n-> Procesando Sensor " << nombre << " (Presión)...\n";
-    
-    if (historial.estaVacia()) {
-        std::cout << "[" << nombre << "] No hay lecturas para procesar.\n";
-        return;
-    }
-    
-    // Calcular promedio de todas las lecturas
-    int promedio = historial.calcularPromedio();
-    std::cout << "[Sensor Presion] Promedio de " << historial.obtenerTamano() 
-              << " lecturas: " << promedio << " kPa\n";
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    historial.descartarAntiguas(instanteActualMs());
+    historial.aplicar(ProcesarPresiones(informe(), nombre));
 }
 
 void SensorPresion::imprimirInfo() const {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
     std::cout << "\n=== Sensor de Presión: " << nombre << " ===\n";
     std::cout << "Tipo: PRESIÓN (int)\n";
-    std::cout << "Número de lecturas: " << historial.obtenerTamano() << "\n";
-    
-    if (!historial.estaVacia()) {
-        std::cout << "Lecturas actuales: ";
-        historial.imprimir();
-    } else {
-        std::cout << "Sin lecturas registradas.\n";
-    }
+    historial.descartarAntiguas(instanteActualMs());
+    historial.describir(std::cout);
+    historial.aplicar(MostrarPresiones());
+    resumen.imprimir(" kPa", instanteActualMs());
     std::cout << "=====================================\n";
 }
 
 void SensorPresion::registrarLecturaDesdeString(const char* valor) {
-    int presion = atoi(valor);  // Convierte string a int
+    int presion;
+    AnalizadorTramas::convertirEntero(valor, valor + strlen(valor), presion);  // Como atoi, sin locale
     registrarLectura(presion);
 }
+
+void SensorPresion::registrarLecturaTrama(const LecturaTrama& lectura) {
+    registrarLectura(lectura.entero);
+}
+
+void SensorPresion::registrarLote(const int* valores, size_t cantidad) {
+    {
+        int64_t instante = instanteActualMs();
+        std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+        historial.insertarLote(valores, static_cast<int>(cantidad), instante);
+        resumen.agregarLote(valores, static_cast<int>(cantidad), instante);
+        anotarEnDiario(valores, static_cast<int>(cantidad), instante);
+    }
+    LOG_TRAZA("[" << nombre << "] Lote de " << cantidad << " presiones registrado.\n");
+}
+
+size_t SensorPresion::registrarLoteDesdeBuffer(const char* buffer, size_t longitud) {
+    int tramo[TRAMO_LOTE];
+    char token[32];
+    size_t posicion = 0;
+    size_t total = 0;
+    int usados = 0;
+
+    // Convierte por tramos de TRAMO_LOTE y los agrega de una vez
+    while (siguienteValor(buffer, longitud, posicion, token, sizeof(token))) {
+        AnalizadorTramas::convertirEntero(token, token + strlen(token), tramo[usados++]);
+        if (usados == TRAMO_LOTE) {
+            registrarLote(tramo, usados);
+            total += usados;
+            usados = 0;
+        }
+    }
+    if (usados > 0) {
+        registrarLote(tramo, usados);
+        total += usados;
+    }
+    return total;
+}
+
+void SensorPresion::registrarLoteTramas(const LecturaTrama* lecturas, size_t cantidad) {
+    int tramo[TRAMO_LOTE];
+
+    while (cantidad > 0) {
+        size_t usados = cantidad < static_cast<size_t>(TRAMO_LOTE) ? cantidad : TRAMO_LOTE;
+        for (size_t i = 0; i < usados; i++) {
+            tramo[i] = lecturas[i].entero;
+        }
+        registrarLote(tramo, usados);
+        lecturas += usados;
+        cantidad -= usados;
+    }
+}
+
+void SensorPresion::configurarRetencion(int maxLecturas, int64_t ventanaMs) {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    historial.acotar(maxLecturas, ventanaMs);
+    if (maxLecturas <= 0) {
+        LOG_INFO("[" << nombre << "] Historial sin límite.\n");
+        return;
+    }
+    LOG_INFO("[" << nombre << "] Historial acotado a " << maxLecturas << " lecturas"
+             << (ventanaMs > 0 ? " con ventana de tiempo" : "") << ".\n");
+}
+
+void SensorPresion::configurarCompresion(bool activar) {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    if (activar && historial.estaComprimido()) {
+        return;
+    }
+    historial.comprimir(activar);
+    LOG_INFO("[" << nombre << "] Historial " << (activar ? "comprimido" : "sin comprimir") << ".\n");
+}
+
+char SensorPresion::obtenerTipo() const {
+    return 'P';
+}
+
+void SensorPresion::guardarEstado(std::ostream& salida) const {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    FormatoInstantanea::escribirSensor<int>(salida, secuencia, historial, resumen);
+}
+
+bool SensorPresion::restaurarEstado(const char* datos, size_t longitud) {
+    LectorInstantanea lector(datos, datos + longitud);
+    uint8_t modo;
+    int32_t maxLecturas;
+    int64_t ventanaMs;
+    uint64_t numero;
+    if (!FormatoInstantanea::leerConfiguracion(lector, numero, modo, maxLecturas, ventanaMs)) {
+        return false;
+    }
+    if (modo == FormatoInstantanea::ACOTADO) {
+        configurarRetencion(maxLecturas, ventanaMs);
+    } else if (modo == FormatoInstantanea::COMPRIMIDO) {
+        configurarCompresion(true);
+    }
+
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    secuencia = numero;
+    return FormatoInstantanea::leerLecturas<int>(lector, historial) &&
+           FormatoInstantanea::leerResumen(lector, resumen) && lector.alFinal();
+}
+
+bool SensorPresion::reproducirLectura(uint64_t numero, int64_t instante, uint32_t bitsValor) {
+    int presion;
+    memcpy(&presion, &bitsValor, sizeof(presion));
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    if (numero <= secuencia) {
+        return false;
+    }
+    historial.insertarAlFinal(presion, instante);
+    resumen.agregar(presion, instante);
+    secuencia = numero;
+    return true;
+}
@@ -9,7 +9,8 @@
 #define SENSORPRESION_H
 
 #include "SensorBase.h"
-#include "ListaSensor.h"
+#include "HistorialSensor.h"
+#include "NivelesResumen.h"
 
 /**
  * @class SensorPresion
@@ -22,7 +23,8 @@
  */
 class SensorPresion : public SensorBase {
 private:
-    ListaSensor<int> historial;  ///< Lista de lecturas de presión
+    HistorialSensor<int> historial;  ///< Lecturas en el modo de almacenamiento vigente
+    NivelesResumen<int> resumen;      ///< Resúmenes por minuto y por hora
 
 public:
     /**
@@ -59,6 +61,76 @@ public:
      * @param valor Cadena con el valor de presión
      */
     void registrarLecturaDesdeString(const char* valor) override;
+
+    /**
+     * @brief Registra la lectura de una trama ya convertida
+     * @param lectura Lectura extraída por AnalizadorTramas
+     */
+    void registrarLecturaTrama(const LecturaTrama& lectura) override;
+
+    /**
+     * @brief Registra un lote de presiones en una sola pasada
+     * @param valores Arreglo de lecturas
+     * @param cantidad Número de lecturas
+     */
+    void registrarLote(const int* valores, size_t cantidad);
+
+    /**
+     * @brief Registra un lote de lecturas en texto
+     * @param buffer Valores separados por espacios, comas o saltos de línea
+     * @param longitud Bytes válidos en buffer
+     * @return Número de lecturas registradas
+     */
+    size_t registrarLoteDesdeBuffer(const char* buffer, size_t longitud) override;
+
+    /**
+     * @brief Registra un lote de tramas ya convertidas
+     * @param lecturas Lecturas extraídas por AnalizadorTramas
+     * @param cantidad Número de lecturas
+     */
+    void registrarLoteTramas(const LecturaTrama* lecturas, size_t cantidad) override;
+
+    /**
+     * @brief Acota el historial por cantidad y, opcionalmente, por tiempo
+     * @param maxLecturas Lecturas retenidas como máximo (0 = historial ilimitado)
+     * @param ventanaMs Antigüedad máxima en milisegundos (0 = sin límite)
+     */
+    void configurarRetencion(int maxLecturas, int64_t ventanaMs) override;
+
+    /**
+     * @brief Pasa el historial a (o desde) su forma comprimida
+     * @param activar true para comprimir, false para volver a bloques sin comprimir
+     */
+    void configurarCompresion(bool activar) override;
+
+    /**
+     * @brief Letra de tipo de trama del sensor
+     * @return 'P'
+     */
+    char obtenerTipo() const override;
+
+    /**
+     * @brief Vuelca retención, historial y resúmenes en binario
+     * @param salida Flujo binario donde escribir
+     */
+    void guardarEstado(std::ostream& salida) const override;
+
+    /**
+     * @brief Reconstruye el estado escrito por guardarEstado()
+     * @param datos Bytes del registro del sensor
+     * @param longitud Número de bytes
+     * @return false si el registro está truncado o no es válido
+     */
+    bool restaurarEstado(const char* datos, size_t longitud) override;
+
+    /**
+     * @brief Reaplica una lectura recuperada del diario
+     * @param numero Número de secuencia de la lectura
+     * @param instante Instante de llegada (reloj monotónico, ms)
+     * @param bitsValor Bytes del valor (int)
+     * @return false si ya estaba aplicada
+     */
+    bool reproducirLectura(uint64_t numero, int64_t instante, uint32_t bitsValor) override;
 };
 
 #endif // SENSORPRESION_H
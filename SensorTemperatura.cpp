@@ -4,70 +4,261 @@
  */
 
 #include "SensorTemperatura.h"
-#include <cstdlib>
+#include "AnalizadorTramas.h"
+#include "FormatoInstantanea.h"
+#include "Log.h"
+#include <cstring>
 #include <iomanip>
 
+namespace {
+
+/// Intervalo de la consulta "último minuto" de imprimirInfo()
+const int64_t MINUTO_MS = 60 * 1000;
+
+/// Lecturas en bruto que imprimirInfo() muestra como máximo (el resto, en NivelesResumen)
+const int LECTURAS_MOSTRADAS = 20;
+
+/**
+ * @brief Informe de procesarLectura() sobre cualquiera de los historiales
+ */
+struct ProcesarTemperaturas {
+    std::ostream& informe;
+    const char* nombre;
+    ProcesarTemperaturas(std::ostream& informe, const char* nombre) : informe(informe), nombre(nombre) {}
+
+    template <typename Historial>
+    void operator()(Historial& historial) const {
+        informe << "\n-> Procesando Sensor " << nombre << " (Temperatura)...\n";
+    
+        if (historial.estaVacia()) {
+            informe << "[" << nombre << "] No hay lecturas para procesar.\n";
+            return;
+        }
+    
+        if (historial.obtenerTamano() == 1) {
+            float promedio = historial.calcularPromedio();
+            informe << "[Sensor Temp] Solo hay 1 lectura. Promedio: " 
+                    << std::fixed << std::setprecision(2) << promedio << "°C\n";
+            return;
+        }
+    
+        // Eliminar el valor más bajo (posible outlier)
+        float minimo = historial.eliminarMinimo();
+        informe << "[Sensor Temp] Lectura más baja eliminada: " 
+                << std::fixed << std::setprecision(2) << minimo << "°C\n";
+    
+        // Calcular promedio de las lecturas restantes
+        if (!historial.estaVacia()) {
+            float promedio = historial.calcularPromedio();
+            informe << "[Sensor Temp] Promedio de lecturas restantes (" 
+                    << historial.obtenerTamano() << "): " 
+                    << std::fixed << std::setprecision(2) << promedio << "°C\n";
+            informe << "[Sensor Temp] Desviación estándar: "
+                    << historial.calcularDesviacionEstandar() << "°C\n";
+        }
+    }
+};
+
+/**
+ * @brief Lecturas de imprimirInfo() sobre cualquiera de los historiales
+ */
+struct MostrarTemperaturas {
+    template <typename Historial>
+    void operator()(const Historial& historial) const {
+        std::cout << "Número de lecturas: " << historial.obtenerTamano() << "\n";
+    
+        if (!historial.estaVacia()) {
+            // Consulta por intervalo: salta directamente al último minuto
+            int64_t ahora = instanteActualMs();
+            int64_t desde = ahora - MINUTO_MS;
+            int recientes = historial.contarEnRango(desde, ahora + 1);
+
+            // Solo las últimas lecturas del minuto; lo anterior lo resume NivelesResumen
+            int omitidas = recientes > LECTURAS_MOSTRADAS ? recientes - LECTURAS_MOSTRADAS : 0;
+            std::cout << "Últimas lecturas: [";
+            int vistas = 0;
+            historial.recorrerRango(desde, ahora + 1, [&vistas, omitidas](float valor) {
+                if (vistas >= omitidas) {
+                    std::cout << (vistas > omitidas ? ", " : "") << valor;
+                }
+                vistas++;
+            });
+            std::cout << "]";
+            if (historial.obtenerTamano() > recientes - omitidas) {
+                std::cout << " (las " << historial.obtenerTamano() - (recientes - omitidas)
+                          << " anteriores, en el resumen por minuto y hora)";
+            }
+            std::cout << "\n";
+            std::cout << "Último minuto: " << recientes << " lecturas";
+            if (recientes > 0) {
+                std::cout << ", promedio " << std::fixed << std::setprecision(2) << historial.calcularPromedioRango(desde, ahora + 1) << "°C";
+            }
+            std::cout << "\n";
+        } else {
+            std::cout << "Sin lecturas registradas.\n";
+        }
+    }
+};
+
+} // namespace
+
 SensorTemperatura::SensorTemperatura(const char* nombre) 
     : SensorBase(nombre) {
-    std::cout << "[Sensor Temp] " << nombre << " creado.\n";
+    LOG_INFO("[Sensor Temp] " << nombre << " creado.\n");
 }
 
 SensorTemperatura::~SensorTemperatura() {
-    std::cout << "[Destructor SensorTemperatura] " << nombre 
-              << " - Liberando historial de temperaturas...\n";
-    // El destructor de ListaSensor se encarga automáticamente de liberar memoria
+    LOG_INFO("[Destructor SensorTemperatura] " << nombre
+             << " - Liberando historial de temperaturas...\n");
+    // El destructor de HistorialSensor se encarga automáticamente de liberar memoria
 }
 
 void SensorTemperatura::registrarLectura(float temperatura) {
-    historial.insertarAlFinal(temperatura);
-    std::cout << "[" << nombre << "] Temperatura registrada: " 
-              << std::fixed << std::setprecision(2) << temperatura << "°C\n";
+    {
+        int64_t instante = instanteActualMs();
+        std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+        historial.insertarAlFinal(temperatura, instante);
+        resumen.agregar(temperatura, instante);
+        anotarEnDiario(&temperatura, 1, instante);
+    }
+    LOG_TRAZA("[" << nombre << "] Temperatura registrada: "
+              << std::fixed << std::setprecision(2) << temperatura << "°C\n");
 }
 
 void SensorTemperatura::procesarLectura() {
-    std::cout << "\n-> Procesando Sensor " << nombre << " (Temperatura)...\n";
-    
-    if (historial.estaVacia()) {
-        std::cout << "[" << nombre << "] No hay lecturas para procesar.\n";
-        return;
-    }
-    
-    if (historial.obtenerTamano() == 1) {
-        float promedio = historial.calcularPromedio();
-        std::cout << "[Sensor Temp] Solo hay 1 lectura. Promedio: " 
-                  << std::fixed << std::setprecision(2) << promedio << "°C\n";
-        return;
-    }
-    
-    // Eliminar el valor más bajo (posible outlier)
-    float minimo = historial.eliminarMinimo();
-    std::cout << "[Sensor Temp] Lectura más baja eliminada: " 
-              << std::fixed << std::setprecision(2) << minimo << "°C\n";
-    
-    // Calcular promedio de las lecturas restantes
-    if (!historial.estaVacia()) {
-        float promedio = historial.calcularPromedio();
-        std::cout << "[Sensor Temp] Promedio de lecturas restantes (" 
-                  << historial.obtenerTamano() << "): " 
-                  << std::fixed << std::setprecision(2) << promedio << "°C\n";
-    }
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    historial.descartarAntiguas(instanteActualMs());
+    historial.aplicar(ProcesarTemperaturas(informe(), nombre));
 }
 
 void SensorTemperatura::imprimirInfo() const {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
     std::cout << "\n=== Sensor de Temperatura: " << nombre << " ===\n";
     std::cout << "Tipo: TEMPERATURA (float)\n";
-    std::cout << "Número de lecturas: " << historial.obtenerTamano() << "\n";
-    
-    if (!historial.estaVacia()) {
-        std::cout << "Lecturas actuales: ";
-        historial.imprimir();
-    } else {
-        std::cout << "Sin lecturas registradas.\n";
-    }
+    historial.descartarAntiguas(instanteActualMs());
+    historial.describir(std::cout);
+    historial.aplicar(MostrarTemperaturas());
+    resumen.imprimir("°C", instanteActualMs());
     std::cout << "=====================================\n";
 }
 
 void SensorTemperatura::registrarLecturaDesdeString(const char* valor) {
-    float temperatura = atof(valor);  // Convierte string a float
+    float temperatura;
+    AnalizadorTramas::convertirReal(valor, valor + strlen(valor), temperatura);  // Como atof, sin locale
     registrarLectura(temperatura);
 }
+
+void SensorTemperatura::registrarLecturaTrama(const LecturaTrama& lectura) {
+    registrarLectura(lectura.real);
+}
+
+void SensorTemperatura::registrarLote(const float* valores, size_t cantidad) {
+    {
+        int64_t instante = instanteActualMs();
+        std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+        historial.insertarLote(valores, static_cast<int>(cantidad), instante);
+        resumen.agregarLote(valores, static_cast<int>(cantidad), instante);
+        anotarEnDiario(valores, static_cast<int>(cantidad), instante);
+    }
+    LOG_TRAZA("[" << nombre << "] Lote de " << cantidad << " temperaturas registrado.\n");
+}
+
+size_t SensorTemperatura::registrarLoteDesdeBuffer(const char* buffer, size_t longitud) {
+    float tramo[TRAMO_LOTE];
+    char token[32];
+    size_t posicion = 0;
+    size_t total = 0;
+    int usados = 0;
+
+    // Convierte por tramos de TRAMO_LOTE y los agrega de una vez
+    while (siguienteValor(buffer, longitud, posicion, token, sizeof(token))) {
+        AnalizadorTramas::convertirReal(token, token + strlen(token), tramo[usados++]);
+        if (usados == TRAMO_LOTE) {
+            registrarLote(tramo, usados);
+            total += usados;
+            usados = 0;
+        }
+    }
+    if (usados > 0) {
+        registrarLote(tramo, usados);
+        total += usados;
+    }
+    return total;
+}
+
+void SensorTemperatura::registrarLoteTramas(const LecturaTrama* lecturas, size_t cantidad) {
+    float tramo[TRAMO_LOTE];
+
+    while (cantidad > 0) {
+        size_t usados = cantidad < static_cast<size_t>(TRAMO_LOTE) ? cantidad : TRAMO_LOTE;
+        for (size_t i = 0; i < usados; i++) {
+            tramo[i] = lecturas[i].real;
+        }
+        registrarLote(tramo, usados);
+        lecturas += usados;
+        cantidad -= usados;
+    }
+}
+
+void SensorTemperatura::configurarRetencion(int maxLecturas, int64_t ventanaMs) {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    historial.acotar(maxLecturas, ventanaMs);
+    if (maxLecturas <= 0) {
+        LOG_INFO("[" << nombre << "] Historial sin límite.\n");
+        return;
+    }
+    LOG_INFO("[" << nombre << "] Historial acotado a " << maxLecturas << " lecturas"
+             << (ventanaMs > 0 ? " con ventana de tiempo" : "") << ".\n");
+}
+
+void SensorTemperatura::configurarCompresion(bool activar) {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    if (activar && historial.estaComprimido()) {
+        return;
+    }
+    historial.comprimir(activar);
+    LOG_INFO("[" << nombre << "] Historial " << (activar ? "comprimido" : "sin comprimir") << ".\n");
+}
+
+char SensorTemperatura::obtenerTipo() const {
+    return 'T';
+}
+
+void SensorTemperatura::guardarEstado(std::ostream& salida) const {
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    FormatoInstantanea::escribirSensor<float>(salida, secuencia, historial, resumen);
+}
+
+bool SensorTemperatura::restaurarEstado(const char* datos, size_t longitud) {
+    LectorInstantanea lector(datos, datos + longitud);
+    uint8_t modo;
+    int32_t maxLecturas;
+    int64_t ventanaMs;
+    uint64_t numero;
+    if (!FormatoInstantanea::leerConfiguracion(lector, numero, modo, maxLecturas, ventanaMs)) {
+        return false;
+    }
+    if (modo == FormatoInstantanea::ACOTADO) {
+        configurarRetencion(maxLecturas, ventanaMs);
+    } else if (modo == FormatoInstantanea::COMPRIMIDO) {
+        configurarCompresion(true);
+    }
+
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    secuencia = numero;
+    return FormatoInstantanea::leerLecturas<float>(lector, historial) &&
+           FormatoInstantanea::leerResumen(lector, resumen) && lector.alFinal();
+}
+
+bool SensorTemperatura::reproducirLectura(uint64_t numero, int64_t instante, uint32_t bitsValor) {
+    float temperatura;
+    memcpy(&temperatura, &bitsValor, sizeof(temperatura));
+    std::lock_guard<std::mutex> guarda(cerrojoHistorial);
+    if (numero <= secuencia) {
+        return false;
+    }
+    historial.insertarAlFinal(temperatura, instante);
+    resumen.agregar(temperatura, instante);
+    secuencia = numero;
+    return true;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file ServicioSensores.cpp
+ * @brief Implementación del modo servicio
+ */
+
+#include "ServicioSensores.h"
+#include "ArduinoSimulador.h"
+#include "CanalizacionCaptura.h"
+#include "ListaGestion.h"
+#include "Log.h"
+#include "SensorBase.h"
+#include <chrono>
+#include <csignal>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+/// Puesta a 1 por solicitarDetencion() (también desde un manejador de señal)
+volatile std::sig_atomic_t detencionSolicitada = 0;
+
+/// Intervalo con el que el bucle comprueba si debe terminar
+const std::chrono::milliseconds SONDEO_DETENCION(100);
+
+} // namespace
+
+ServicioSensores::ServicioSensores(ListaGestion& lista, ArduinoSimulador& arduino,
+                                   const ConfiguracionServicio& config)
+    : lista(lista), arduino(arduino), config(config) {
+}
+
+void ServicioSensores::alRecibirSenal(int senal) {
+    (void)senal;
+    solicitarDetencion();
+}
+
+void ServicioSensores::solicitarDetencion() {
+    detencionSolicitada = 1;
+}
+
+int ServicioSensores::crearSensores(std::ostream& salida) {
+    int creados = 0;
+    size_t inicio = 0;
+    while (inicio <= config.sensores.size()) {
+        size_t fin = config.sensores.find(',', inicio);
+        if (fin == std::string::npos) {
+            fin = config.sensores.size();
+        }
+        std::string nombre = config.sensores.substr(inicio, fin - inicio);
+        inicio = fin + 1;
+
+        // Sin espacios alrededor ("T-001, P-001")
+        size_t primero = nombre.find_first_not_of(" \t");
+        size_t ultimo = nombre.find_last_not_of(" \t");
+        if (primero == std::string::npos) {
+            continue;
+        }
+        nombre = nombre.substr(primero, ultimo - primero + 1);
+        if (nombre.size() >= 50) {
+            salida << "⚠ Nombre de sensor demasiado largo: " << nombre << "\n";
+            continue;
+        }
+        if (lista.buscarSensor(nombre.c_str()) != nullptr) {
+            continue;  // Restaurado de la instantánea o del diario
+        }
+
+        char tipo = static_cast<char>(toupper(static_cast<unsigned char>(nombre[0])));
+        SensorBase* sensor = SensorBase::crearDeTipo(tipo, nombre.c_str());
+        if (sensor == nullptr) {
+            salida << "⚠ " << nombre << ": el nombre debe empezar por T (temperatura)"
+                   << " o P (presión).\n";
+            continue;
+        }
+        lista.insertarSensor(sensor);
+        creados++;
+    }
+    return creados;
+}
+
+void ServicioSensores::escribirCiclo(std::ostream& salida, unsigned long ciclo,
+                                     const EstadisticasCanalizacion& captura) {
+    char hora[32];
+    std::time_t ahora = std::time(nullptr);
+    std::tm* local = std::localtime(&ahora);
+    if (local == nullptr || std::strftime(hora, sizeof(hora), "%Y-%m-%d %H:%M:%S", local) == 0) {
+        hora[0] = '\0';
+    }
+
+    salida << "\n[" << hora << "] Ciclo " << ciclo << ": "
+           << captura.recibidas << " recibidas, "
+           << captura.procesadas << " registradas, "
+           << captura.sinDestino << " sin sensor, "
+           << captura.descartadas << " descartadas\n";
+    lista.procesarTodosSensoresParalelo(config.hilos, salida);
+    salida.flush();
+}
+
+bool ServicioSensores::ejecutar() {
+    std::ofstream archivo;
+    if (!config.salida.empty()) {
+        archivo.open(config.salida.c_str(), std::ios::app);
+        if (!archivo) {
+            LOG_ERROR("[Servicio] No se pudo abrir " << config.salida << ".\n");
+            return false;
+        }
+    }
+    std::ostream& salida = config.salida.empty() ? std::cout : archivo;
+
+    // Con un puerto pedido, la simulación no sirve de respaldo: el servicio
+    // guardaría lecturas inventadas en sensores reales, el diario y la instantánea
+    const char* puerto = config.puerto.empty() ? nullptr : config.puerto.c_str();
+    if (!arduino.conectar(puerto) || (puerto != nullptr && !arduino.esModoReal())) {
+        LOG_ERROR("[Servicio] No se pudo abrir el puerto " << config.puerto
+                  << "; el servicio no arranca con lecturas simuladas.\n");
+        arduino.desconectar();
+        return false;
+    }
+
+    detencionSolicitada = 0;
+    std::signal(SIGINT, &ServicioSensores::alRecibirSenal);
+    std::signal(SIGTERM, &ServicioSensores::alRecibirSenal);
+
+    int creados = crearSensores(salida);
+
+    salida << "Servicio iniciado: " << lista.obtenerTamano() << " sensores ("
+           << creados << " nuevos), procesamiento cada " << config.procesarCadaSeg << " s";
+    if (config.duracionSeg > 0) {
+        salida << ", durante " << config.duracionSeg << " s";
+    }
+    salida << ".\n";
+    salida.flush();
+
+    typedef std::chrono::steady_clock Reloj;
+    const Reloj::duration periodo =
+        std::chrono::seconds(config.procesarCadaSeg > 0 ? config.procesarCadaSeg : 1);
+    const Reloj::time_point inicio = Reloj::now();
+    const Reloj::time_point fin = inicio + std::chrono::seconds(config.duracionSeg);
+
+    CanalizacionCaptura canalizacion(lista, arduino);
+    canalizacion.iniciar(config.lecturasPorSegundo, 0);
+
+    unsigned long ciclo = 0;
+    Reloj::time_point proximo = inicio + periodo;
+    bool terminar = false;
+    while (!terminar) {
+        // Espera al próximo ciclo en pasos cortos para atender las señales
+        Reloj::time_point limite = proximo;
+        if (config.duracionSeg > 0 && fin < limite) {
+            limite = fin;
+        }
+        while (detencionSolicitada == 0 && Reloj::now() < limite) {
+            Reloj::time_point paso = Reloj::now() + SONDEO_DETENCION;
+            std::this_thread::sleep_until(paso < limite ? paso : limite);
+        }
+        terminar = detencionSolicitada != 0 ||
+                   (config.duracionSeg > 0 && Reloj::now() >= fin);
+        if (terminar) {
+            canalizacion.detener();
+        }
+
+        escribirCiclo(salida, ++ciclo, canalizacion.obtenerEstadisticas());
+        while (proximo <= Reloj::now()) {
+            proximo += periodo;  // Ciclos perdidos por un procesamiento lento
+        }
+    }
+
+    salida << "\nServicio detenido tras " << ciclo << " ciclos.\n";
+    salida.flush();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    return true;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ServicioSensores.h
+ * @brief Modo servicio: captura continua y procesamiento periódico sin menú
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef SERVICIOSENSORES_H
+#define SERVICIOSENSORES_H
+
+#include <ostream>
+#include <string>
+
+class ArduinoSimulador;
+class ListaGestion;
+struct EstadisticasCanalizacion;
+
+/**
+ * @brief Parámetros del modo servicio
+ */
+struct ConfiguracionServicio {
+    std::string sensores;        ///< Nombres a crear, separados por comas ("T-001,P-001")
+    std::string puerto;          ///< Puerto serial ("" = datos simulados)
+    double lecturasPorSegundo;   ///< Ritmo de captura (0 = máximo rendimiento)
+    int procesarCadaSeg;         ///< Segundos entre procesamientos (> 0)
+    int duracionSeg;             ///< Segundos de servicio (0 = hasta SIGINT/SIGTERM)
+    int hilos;                   ///< Hilos del procesamiento (0 = núcleos disponibles)
+    std::string salida;          ///< Archivo de informes ("" = salida estándar)
+
+    ConfiguracionServicio()
+        : lecturasPorSegundo(10.0), procesarCadaSeg(10), duracionSeg(0), hilos(0) {}
+};
+
+/**
+ * @class ServicioSensores
+ * @brief Ejecuta el sistema desatendido, sin leer de stdin ni lanzar procesos
+ *
+ * ejecutar():
+ * 1. Conecta el Arduino. Sin puerto configurado usa la simulación; si el
+ *    puerto configurado no se abre, no arranca (nunca cae en datos simulados).
+ * 2. Crea los sensores de la configuración que no existan (el tipo sale de
+ *    la inicial del nombre: 'T' temperatura, 'P' presión) y arranca una
+ *    CanalizacionCaptura sin límite de lecturas.
+ * 3. Cada procesarCadaSeg segundos escribe en la salida la hora, los
+ *    contadores de la captura y el informe de
+ *    ListaGestion::procesarTodosSensoresParalelo().
+ * 4. Al cumplirse duracionSeg o al recibir SIGINT/SIGTERM, detiene la
+ *    captura y escribe un último ciclo.
+ *
+ * Los ciclos se programan sobre el reloj monotónico (inicio + k·periodo):
+ * un procesamiento lento no desplaza los siguientes.
+ */
+class ServicioSensores {
+private:
+    ListaGestion& lista;             ///< Sensores del servicio
+    ArduinoSimulador& arduino;       ///< Fuente de lecturas
+    ConfiguracionServicio config;    ///< Parámetros
+
+    /**
+     * @brief Crea los sensores de config.sensores que falten
+     * @param salida Flujo donde avisar de los nombres no válidos
+     * @return Sensores creados
+     */
+    int crearSensores(std::ostream& salida);
+
+    /**
+     * @brief Escribe un ciclo: hora, contadores y procesamiento
+     */
+    void escribirCiclo(std::ostream& salida, unsigned long ciclo,
+                       const EstadisticasCanalizacion& captura);
+
+    /**
+     * @brief Manejador de SIGINT y SIGTERM
+     */
+    static void alRecibirSenal(int senal);
+
+public:
+    /**
+     * @brief Constructor
+     * @param lista Lista de sensores (puede traer sensores restaurados)
+     * @param arduino Fuente de lecturas, sin conectar
+     * @param config Parámetros del servicio
+     */
+    ServicioSensores(ListaGestion& lista, ArduinoSimulador& arduino,
+                     const ConfiguracionServicio& config);
+
+    /**
+     * @brief Ejecuta el servicio hasta agotar la duración o recibir una señal
+     * @return false si no se pudo abrir el archivo de salida o el puerto configurado
+     */
+    bool ejecutar();
+
+    /**
+     * @brief Pide al servicio en curso que termine tras el ciclo actual
+     *
+     * Segura desde un manejador de señales.
+     */
+    static void solicitarDetencion();
+
+    ServicioSensores(const ServicioSensores&) = delete;
+    ServicioSensores& operator=(const ServicioSensores&) = delete;
+};
+
+#endif // SERVICIOSENSORES_H
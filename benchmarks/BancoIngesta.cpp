@@ -0,0 +1,209 @@
+/**
+ * @file BancoIngesta.cpp
+ * @brief Pruebas de rendimiento del camino de entrada: tramas, rutas, captura e importación
+ */
+
+#include "Bancos.h"
+#include "AnalizadorTramas.h"
+#include "ArduinoSimulador.h"
+#include "CanalizacionCaptura.h"
+#include "GeneradorLecturas.h"
+#include "ImportadorCaptura.h"
+#include "ListaGestion.h"
+#include "SensorBase.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+/// Bytes entregados al analizador en cada alimentar(), como una lectura del puerto
+const size_t BLOQUE_PUERTO = 4096;
+
+/**
+ * @brief Texto con n tramas de temperatura y presión alternadas
+ * @param longitud Recibe los bytes del texto
+ * @return Texto reservado con new[]
+ */
+char* generarTramas(int64_t n, uint64_t semilla, size_t& longitud) {
+    GeneradorLecturas generador(semilla);
+    char* texto = new char[static_cast<size_t>(n) * 12 + 1];
+    longitud = 0;
+    for (int64_t i = 0; i < n; i++) {
+        int escritos = (i & 1) == 0
+            ? snprintf(texto + longitud, 13, "T:%.2f\n", generador.temperaturaPaseo())
+            : snprintf(texto + longitud, 13, "P:%d\n", generador.presionPaseo());
+        longitud += static_cast<size_t>(escritos);
+    }
+    return texto;
+}
+
+/**
+ * @brief Tramas por segundo de AnalizadorTramas sobre bloques del tamaño de una lectura del puerto
+ */
+void medirAnalizador(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    int64_t n = opciones.tamanoMaximo < 1000000 ? opciones.tamanoMaximo : 1000000;
+    size_t longitud = 0;
+    char* texto = generarTramas(n, opciones.semilla, longitud);
+
+    ResultadoMedicion& r = medidor.medir("AnalizadorTramas", "alimentar + siguiente", n, n,
+                                         [&](Cronometro& c) {
+        AnalizadorTramas analizador;
+        LecturaTrama lectura;
+        double suma = 0.0;
+        c.iniciar();
+        for (size_t posicion = 0; posicion < longitud; posicion += BLOQUE_PUERTO) {
+            size_t bloque = longitud - posicion < BLOQUE_PUERTO ? longitud - posicion : BLOQUE_PUERTO;
+            analizador.alimentar(texto + posicion, bloque);
+            while (analizador.siguiente(lectura)) {
+                suma += lectura.real;
+            }
+        }
+        c.detener();
+        MedidorRendimiento::consumir(suma);
+    });
+    MedidorRendimiento::agregarMetrica(r, "bytes_por_trama", static_cast<double>(longitud) / n);
+
+    delete[] texto;
+}
+
+/**
+ * @brief ListaGestion::buscarSensor (índice hash) frente a un recorrido con strcmp
+ */
+void medirBusquedaSensores(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    const int64_t busquedas = 1000000;
+    for (int sensores = 10; sensores <= 10000 && sensores <= opciones.tamanoMaximo; sensores *= 10) {
+        ListaGestion lista;
+        char (*nombres)[16] = new char[sensores][16];
+        for (int i = 0; i < sensores; i++) {
+            snprintf(nombres[i], sizeof(nombres[i]), "T-%06d", i);
+            lista.insertarSensor(SensorBase::crearDeTipo('T', nombres[i]));
+        }
+
+        // Los mismos nombres pseudoaleatorios en todas las repeticiones
+        GeneradorLecturas generador(opciones.semilla);
+        int* orden = new int[busquedas];
+        for (int64_t i = 0; i < busquedas; i++) {
+            orden[i] = static_cast<int>(generador.enRango(static_cast<uint32_t>(sensores)));
+        }
+
+        medidor.medir("ListaGestion", "buscarSensor", sensores, busquedas, [&](Cronometro& c) {
+            int64_t encontrados = 0;
+            c.iniciar();
+            for (int64_t i = 0; i < busquedas; i++) {
+                encontrados += lista.buscarSensor(nombres[orden[i]]) != nullptr ? 1 : 0;
+            }
+            c.detener();
+            MedidorRendimiento::consumir(static_cast<double>(encontrados));
+        });
+
+        int64_t lineales = 10000000 / sensores;
+        medidor.medir("ListaGestion", "recorrido lineal (referencia)", sensores, lineales,
+                      [&](Cronometro& c) {
+            int64_t encontrados = 0;
+            c.iniciar();
+            for (int64_t i = 0; i < lineales; i++) {
+                const char* buscado = nombres[orden[i]];
+                SensorBase* hallado = nullptr;
+                lista.recorrerSensores([buscado, &hallado](SensorBase* sensor) {
+                    if (hallado == nullptr && strcmp(sensor->obtenerNombre(), buscado) == 0) {
+                        hallado = sensor;
+                    }
+                });
+                encontrados += hallado != nullptr ? 1 : 0;
+            }
+            c.detener();
+            MedidorRendimiento::consumir(static_cast<double>(encontrados));
+        });
+
+        delete[] orden;
+        delete[] nombres;
+    }
+}
+
+/**
+ * @brief Captura simulada de extremo a extremo: Arduino → cola → sensores
+ */
+void medirCaptura(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    unsigned long n = static_cast<unsigned long>(
+        opciones.tamanoMaximo < 1000000 ? opciones.tamanoMaximo : 1000000);
+    EstadisticasCanalizacion ultima;
+
+    ResultadoMedicion& r = medidor.medir("Captura", "CanalizacionCaptura simulada", n, n,
+                                         [&](Cronometro& c) {
+        ListaGestion lista;
+        lista.insertarSensor(SensorBase::crearDeTipo('T', "T-001"));
+        lista.insertarSensor(SensorBase::crearDeTipo('P', "P-001"));
+        ArduinoSimulador arduino;
+        srand(static_cast<unsigned int>(opciones.semilla));  // Misma mezcla de tipos siempre
+        arduino.conectar(nullptr);
+
+        CanalizacionCaptura canalizacion(lista, arduino);
+        c.iniciar();
+        canalizacion.iniciar(0.0, n);
+        canalizacion.esperar();
+        c.detener();
+        ultima = canalizacion.obtenerEstadisticas();
+    });
+    MedidorRendimiento::agregarMetrica(r, "registradas", static_cast<double>(ultima.procesadas));
+    MedidorRendimiento::agregarMetrica(r, "sin_destino", static_cast<double>(ultima.sinDestino));
+    MedidorRendimiento::agregarMetrica(r, "descartadas", static_cast<double>(ultima.descartadas));
+    MedidorRendimiento::agregarMetrica(r, "latencia_media_us", ultima.latenciaMediaUs);
+    MedidorRendimiento::agregarMetrica(r, "latencia_maxima_us", ultima.latenciaMaximaUs);
+}
+
+/**
+ * @brief ImportadorCaptura sobre un archivo de tramas temporal
+ */
+void medirImportacion(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    int64_t n = opciones.tamanoMaximo < 2000000 ? opciones.tamanoMaximo : 2000000;
+    size_t longitud = 0;
+    char* texto = generarTramas(n, opciones.semilla, longitud);
+    std::string ruta = opciones.rutaTemporal("iot_benchmarks_captura.txt");
+    {
+        std::ofstream archivo(ruta.c_str(), std::ios::binary);
+        archivo.write(texto, static_cast<std::streamsize>(longitud));
+        if (!archivo) {
+            std::cerr << "⚠ No se pudo escribir " << ruta << "; se omite la importación.\n";
+            delete[] texto;
+            return;
+        }
+    }
+    delete[] texto;
+
+    EstadisticasImportacion ultima;
+    ResultadoMedicion& r = medidor.medir("ImportadorCaptura", "importar", n, n,
+                                         [&](Cronometro& c) {
+        ListaGestion lista;
+        ImportadorCaptura importador(lista);
+        c.iniciar();
+        importador.importar(ruta.c_str());
+        c.detener();
+        ultima = importador.obtenerEstadisticas();
+    });
+    MedidorRendimiento::agregarMetrica(r, "hilos", ultima.hilos);
+    MedidorRendimiento::agregarMetrica(r, "megabytes_por_segundo",
+                                       static_cast<double>(longitud) / (r.nsMediana * n / 1e9) / 1e6);
+    MedidorRendimiento::agregarMetrica(r, "registradas", static_cast<double>(ultima.registradas));
+
+    std::remove(ruta.c_str());
+}
+
+} // namespace
+
+void medirIngesta(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    if (medidor.incluye("AnalizadorTramas")) {
+        medirAnalizador(medidor, opciones);
+    }
+    if (medidor.incluye("ListaGestion")) {
+        medirBusquedaSensores(medidor, opciones);
+    }
+    if (medidor.incluye("Captura")) {
+        medirCaptura(medidor, opciones);
+    }
+    if (medidor.incluye("ImportadorCaptura")) {
+        medirImportacion(medidor, opciones);
+    }
+}
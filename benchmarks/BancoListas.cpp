@@ -0,0 +1,365 @@
+/**
+ * @file BancoListas.cpp
+ * @brief Pruebas de rendimiento de las listas, historiales y núcleos SIMD
+ */
+
+#include "Bancos.h"
+#include "GeneradorLecturas.h"
+#include "HistorialComprimido.h"
+#include "KernelsLecturas.h"
+#include "ListaSensor.h"
+#include "ListaSensorConcurrente.h"
+#include "ListaSensorDesenrollada.h"
+#include <thread>
+
+namespace {
+
+/// Valor que nunca aparece en los datos: buscar() recorre la lista entera
+const float VALOR_AUSENTE = 1000.0f;
+
+/// Trabajo aproximado (nodos visitados) de una repetición de las pruebas O(n)
+const int64_t NODOS_POR_REPETICION = 10000000;
+
+/// Instante de la primera lectura (las siguientes, una por segundo)
+const int64_t INSTANTE_BASE = 1700000000000LL;
+
+/**
+ * @brief Operaciones O(n) por repetición: unas NODOS_POR_REPETICION visitas, entre 1 y 1000
+ */
+int64_t operacionesLineales(int64_t n) {
+    int64_t operaciones = NODOS_POR_REPETICION / n;
+    return operaciones < 1 ? 1 : (operaciones > 1000 ? 1000 : operaciones);
+}
+
+/**
+ * @brief Inserta los valores en una ListaSensor
+ */
+template <typename Lista>
+void llenar(Lista& lista, const float* valores, int64_t n) {
+    for (int64_t i = 0; i < n; i++) {
+        lista.insertarAlFinal(valores[i]);
+    }
+}
+
+/**
+ * @brief Inserta los valores en una ListaSensorDesenrollada, uno por segundo
+ */
+template <typename Lista>
+void llenarConInstantes(Lista& lista, const float* valores, int64_t n) {
+    for (int64_t i = 0; i < n; i++) {
+        lista.insertarAlFinal(valores[i], INSTANTE_BASE + i * 1000);
+    }
+}
+
+/**
+ * @brief Las cuatro operaciones de la matriz de tamaños sobre un tipo de lista
+ * @param grupo Nombre del grupo en los resultados
+ * @param llenarLista Inserta n valores en una lista vacía
+ * @param operacionesMinimo Operaciones de eliminarMinimo() por repetición
+ */
+template <typename Lista, typename Llenar>
+void medirMatriz(MedidorRendimiento& medidor, const char* grupo, const float* valores,
+                 int64_t n, Llenar llenarLista, int64_t operacionesMinimo) {
+    // Inserción: incluye las reservas del asignador, no la destrucción
+    ResultadoMedicion& insercion = medidor.medir(grupo, "insertarAlFinal", n, n,
+                                                 [&](Cronometro& c) {
+        Lista lista;
+        c.iniciar();
+        llenarLista(lista, valores, n);
+        c.detener();
+        MedidorRendimiento::consumir(lista.obtenerTamano());
+    });
+    Lista lista;
+    llenarLista(lista, valores, n);
+    const EstadisticasAsignador& memoria = lista.obtenerEstadisticasMemoria();
+    MedidorRendimiento::agregarMetrica(insercion, "bytes_por_lectura",
+                                       static_cast<double>(memoria.bytesReservados) / n);
+    MedidorRendimiento::agregarMetrica(insercion, "reservas_sistema",
+                                       static_cast<double>(memoria.reservasSistema));
+
+    // Búsqueda de un valor ausente: recorrido completo
+    int64_t busquedas = operacionesLineales(n);
+    medidor.medir(grupo, "buscar (ausente)", n, busquedas, [&](Cronometro& c) {
+        int encontrados = 0;
+        c.iniciar();
+        for (int64_t i = 0; i < busquedas; i++) {
+            encontrados += lista.buscar(VALOR_AUSENTE) ? 1 : 0;
+            MedidorRendimiento::barrera(&lista);
+        }
+        c.detener();
+        MedidorRendimiento::consumir(encontrados);
+    });
+
+    // Promedio: O(1) con los agregados mantenidos al insertar
+    const int64_t promedios = 1000000;
+    medidor.medir(grupo, "calcularPromedio", n, promedios, [&](Cronometro& c) {
+        double suma = 0.0;
+        c.iniciar();
+        for (int64_t i = 0; i < promedios; i++) {
+            suma += lista.calcularPromedio();
+            MedidorRendimiento::barrera(&lista);
+        }
+        c.detener();
+        MedidorRendimiento::consumir(suma);
+    });
+
+    // eliminarMinimo sobre una copia nueva en cada repetición
+    if (operacionesMinimo > n / 2) {
+        operacionesMinimo = n / 2;
+    }
+    medidor.medir(grupo, "eliminarMinimo", n, operacionesMinimo, [&](Cronometro& c) {
+        Lista copia(lista);
+        double suma = 0.0;
+        c.iniciar();
+        for (int64_t i = 0; i < operacionesMinimo; i++) {
+            suma += copia.eliminarMinimo();
+        }
+        c.detener();
+        MedidorRendimiento::consumir(suma);
+    });
+}
+
+/**
+ * @brief ListaSensor y ListaSensorDesenrollada en tamaños 1e2 .. tamanoMaximo
+ */
+void medirMatrizListas(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    GeneradorLecturas generador(opciones.semilla);
+    float* valores = new float[opciones.tamanoMaximo];
+    for (int64_t i = 0; i < opciones.tamanoMaximo; i++) {
+        valores[i] = generador.temperaturaUniforme();
+    }
+
+    for (int64_t n = 100; n <= opciones.tamanoMaximo; n *= 10) {
+        if (medidor.incluye("ListaSensor")) {
+            medirMatriz<ListaSensor<float> >(medidor, "ListaSensor", valores, n,
+                                              llenar<ListaSensor<float> >,
+                                              operacionesLineales(n));
+        }
+        if (medidor.incluye("ListaSensorDesenrollada")) {
+            // eliminarMinimo es O(log n + B): muchas más operaciones por repetición
+            medirMatriz<ListaSensorDesenrollada<float> >(
+                medidor, "ListaSensorDesenrollada", valores, n,
+                llenarConInstantes<ListaSensorDesenrollada<float> >, 10000);
+        }
+    }
+
+    // Un new por nodo frente a la arena de la lista
+    int64_t n = opciones.tamanoMaximo < 1000000 ? opciones.tamanoMaximo : 1000000;
+    if (medidor.incluye("AsignadorNodos")) {
+        typedef ListaSensor<float, AsignadorHeap<Nodo<float> > > ListaHeap;
+        ResultadoMedicion& heap = medidor.medir("AsignadorNodos", "insertarAlFinal (heap)", n, n,
+                                                [&](Cronometro& c) {
+            ListaHeap lista;
+            c.iniciar();
+            llenar(lista, valores, n);
+            c.detener();
+        });
+        ListaHeap listaHeap;
+        llenar(listaHeap, valores, n);
+        MedidorRendimiento::agregarMetrica(heap, "reservas_sistema", static_cast<double>(
+            listaHeap.obtenerEstadisticasMemoria().reservasSistema));
+
+        ResultadoMedicion& arena = medidor.medir("AsignadorNodos", "insertarAlFinal (arena)", n, n,
+                                                 [&](Cronometro& c) {
+            ListaSensor<float> lista;
+            c.iniciar();
+            llenar(lista, valores, n);
+            c.detener();
+        });
+        ListaSensor<float> listaArena;
+        llenar(listaArena, valores, n);
+        MedidorRendimiento::agregarMetrica(arena, "reservas_sistema", static_cast<double>(
+            listaArena.obtenerEstadisticasMemoria().reservasSistema));
+    }
+
+    delete[] valores;
+}
+
+/**
+ * @brief Compresión y recorrido de HistorialComprimido con datos realistas y uniformes
+ */
+template <typename T, typename Generar>
+void medirCompresion(MedidorRendimiento& medidor, const char* prueba, int64_t n, Generar generar) {
+    T* valores = new T[n];
+    for (int64_t i = 0; i < n; i++) {
+        valores[i] = generar();
+    }
+
+    // Referencia sin comprimir: el historial por bloques con los mismos datos
+    ListaSensorDesenrollada<T> plana;
+    for (int64_t i = 0; i < n; i++) {
+        plana.insertarAlFinal(valores[i], INSTANTE_BASE + i * 1000);
+    }
+    double bytesPlana = static_cast<double>(plana.obtenerEstadisticasMemoria().bytesReservados);
+
+    char nombre[48];
+    snprintf(nombre, sizeof(nombre), "insertarAlFinal %s", prueba);
+    ResultadoMedicion& insercion = medidor.medir("HistorialComprimido", nombre, n, n,
+                                                 [&](Cronometro& c) {
+        HistorialComprimido<T> historial;
+        c.iniciar();
+        for (int64_t i = 0; i < n; i++) {
+            historial.insertarAlFinal(valores[i], INSTANTE_BASE + i * 1000);
+        }
+        c.detener();
+        MedidorRendimiento::consumir(historial.obtenerTamano());
+    });
+
+    HistorialComprimido<T> historial;
+    for (int64_t i = 0; i < n; i++) {
+        historial.insertarAlFinal(valores[i], INSTANTE_BASE + i * 1000);
+    }
+    double bytes = static_cast<double>(historial.obtenerBytes());
+    MedidorRendimiento::agregarMetrica(insercion, "bytes_por_lectura", bytes / n);
+    MedidorRendimiento::agregarMetrica(insercion, "bytes_por_lectura_sin_comprimir", bytesPlana / n);
+    MedidorRendimiento::agregarMetrica(insercion, "relacion_compresion", bytesPlana / bytes);
+
+    snprintf(nombre, sizeof(nombre), "recorrer %s", prueba);
+    medidor.medir("HistorialComprimido", nombre, n, n, [&](Cronometro& c) {
+        double suma = 0.0;
+        c.iniciar();
+        historial.recorrer([&suma](T valor) { suma += valor; });
+        c.detener();
+        MedidorRendimiento::consumir(suma);
+    });
+
+    delete[] valores;
+}
+
+/**
+ * @brief Núcleos SIMD en cada nivel disponible frente al recorrido escalar por bloques
+ */
+void medirKernels(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    const int n = opciones.tamanoMaximo < (1 << 20) ? static_cast<int>(opciones.tamanoMaximo)
+                                                    : (1 << 20);
+    GeneradorLecturas generador(opciones.semilla);
+    float* reales = new float[n];
+    int* enteros = new int[n];
+    for (int i = 0; i < n; i++) {
+        reales[i] = generador.temperaturaUniforme();
+        enteros[i] = generador.presionUniforme();
+    }
+
+    const int pasadas = 20;
+    KernelsLecturas::Nivel disponible = KernelsLecturas::nivelDisponible();
+    for (int nivel = KernelsLecturas::ESCALAR; nivel <= disponible; nivel++) {
+        KernelsLecturas::limitarNivel(static_cast<KernelsLecturas::Nivel>(nivel));
+        const char* nombreNivel = KernelsLecturas::nombreNivel(KernelsLecturas::nivelActivo());
+        char prueba[48];
+
+        snprintf(prueba, sizeof(prueba), "sumar float (%s)", nombreNivel);
+        medidor.medir("KernelsLecturas", prueba, n, static_cast<int64_t>(n) * pasadas,
+                      [&](Cronometro& c) {
+            double suma = 0.0;
+            c.iniciar();
+            for (int p = 0; p < pasadas; p++) {
+                suma += KernelsLecturas::sumar(reales, n);
+                MedidorRendimiento::barrera(reales);
+            }
+            c.detener();
+            MedidorRendimiento::consumir(suma);
+        });
+
+        snprintf(prueba, sizeof(prueba), "sumar int (%s)", nombreNivel);
+        medidor.medir("KernelsLecturas", prueba, n, static_cast<int64_t>(n) * pasadas,
+                      [&](Cronometro& c) {
+            int64_t suma = 0;
+            c.iniciar();
+            for (int p = 0; p < pasadas; p++) {
+                suma += KernelsLecturas::sumar(enteros, n);
+                MedidorRendimiento::barrera(enteros);
+            }
+            c.detener();
+            MedidorRendimiento::consumir(static_cast<double>(suma));
+        });
+
+        snprintf(prueba, sizeof(prueba), "indiceMinimo float (%s)", nombreNivel);
+        medidor.medir("KernelsLecturas", prueba, n, static_cast<int64_t>(n) * pasadas,
+                      [&](Cronometro& c) {
+            int64_t suma = 0;
+            c.iniciar();
+            for (int p = 0; p < pasadas; p++) {
+                suma += KernelsLecturas::indiceMinimo(reales, n);
+                MedidorRendimiento::barrera(reales);
+            }
+            c.detener();
+            MedidorRendimiento::consumir(static_cast<double>(suma));
+        });
+    }
+    KernelsLecturas::limitarNivel(disponible);
+
+    // Referencia: recorrido lectura a lectura de los bloques del historial
+    ListaSensorDesenrollada<float> lista;
+    lista.insertarLote(reales, n, INSTANTE_BASE);
+    medidor.medir("KernelsLecturas", "recorrer + suma escalar", n, static_cast<int64_t>(n) * pasadas,
+                  [&](Cronometro& c) {
+        double suma = 0.0;
+        c.iniciar();
+        for (int p = 0; p < pasadas; p++) {
+            lista.recorrer([&suma](float valor) { suma += valor; });
+            MedidorRendimiento::barrera(&lista);
+        }
+        c.detener();
+        MedidorRendimiento::consumir(suma);
+    });
+
+    delete[] reales;
+    delete[] enteros;
+}
+
+/**
+ * @brief Inserciones desde varios productores en ListaSensorConcurrente
+ */
+void medirConcurrente(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    const int64_t total = opciones.tamanoMaximo < 4000000 ? opciones.tamanoMaximo : 4000000;
+    for (int productores = 1; productores <= 4; productores *= 2) {
+        char prueba[48];
+        snprintf(prueba, sizeof(prueba), "insertarAlFinal (%d %s)", productores,
+                 productores == 1 ? "productor" : "productores");
+        medidor.medir("ListaSensorConcurrente", prueba, total, total, [&](Cronometro& c) {
+            ListaSensorConcurrente<float> lista;
+            std::thread* hilos = new std::thread[productores];
+            c.iniciar();
+            for (int p = 0; p < productores; p++) {
+                hilos[p] = std::thread([&lista, p, productores, total]() {
+                    int64_t cuantas = total / productores + (p < total % productores ? 1 : 0);
+                    for (int64_t i = 0; i < cuantas; i++) {
+                        lista.insertarAlFinal(static_cast<float>(i & 1023));
+                    }
+                });
+            }
+            for (int p = 0; p < productores; p++) {
+                hilos[p].join();
+            }
+            c.detener();
+            delete[] hilos;
+            MedidorRendimiento::consumir(lista.obtenerTamano());
+        });
+    }
+}
+
+} // namespace
+
+void medirListas(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    medirMatrizListas(medidor, opciones);
+
+    if (medidor.incluye("HistorialComprimido")) {
+        int64_t n = opciones.tamanoMaximo < 1000000 ? opciones.tamanoMaximo : 1000000;
+        GeneradorLecturas paseo(opciones.semilla);
+        GeneradorLecturas uniforme(opciones.semilla);
+        medirCompresion<float>(medidor, "float paseo", n, [&paseo]() { return paseo.temperaturaPaseo(); });
+        medirCompresion<float>(medidor, "float uniforme", n,
+                               [&uniforme]() { return uniforme.temperaturaUniforme(); });
+        medirCompresion<int>(medidor, "int paseo", n, [&paseo]() { return paseo.presionPaseo(); });
+        medirCompresion<int>(medidor, "int uniforme", n,
+                             [&uniforme]() { return uniforme.presionUniforme(); });
+    }
+
+    if (medidor.incluye("KernelsLecturas")) {
+        medirKernels(medidor, opciones);
+    }
+
+    if (medidor.incluye("ListaSensorConcurrente")) {
+        medirConcurrente(medidor, opciones);
+    }
+}
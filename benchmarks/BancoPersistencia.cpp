@@ -0,0 +1,150 @@
+/**
+ * @file BancoPersistencia.cpp
+ * @brief Pruebas de rendimiento de la instantánea binaria y del diario de lecturas
+ */
+
+#include "Bancos.h"
+#include "DiarioLecturas.h"
+#include "GeneradorLecturas.h"
+#include "InstantaneaGestion.h"
+#include "ListaGestion.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+/// Lecturas por llamada a registrarLote(), como un tramo de captura
+const int LECTURAS_POR_LOTE = 256;
+
+/// Espera máxima antes del fsync del diario (la de main por defecto)
+const int64_t LATENCIA_DIARIO_MS = 10;
+
+/**
+ * @brief Tamaño de un archivo en bytes (0 si no existe)
+ */
+double tamanoArchivo(const std::string& ruta) {
+    std::ifstream archivo(ruta.c_str(), std::ios::binary | std::ios::ate);
+    return archivo ? static_cast<double>(archivo.tellg()) : 0.0;
+}
+
+/**
+ * @brief Guardar y cargar una instantánea con un sensor de cada tipo
+ */
+void medirInstantanea(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    int64_t n = opciones.tamanoMaximo < 2000000 ? opciones.tamanoMaximo : 2000000;
+    std::string ruta = opciones.rutaTemporal("iot_benchmarks.snap");
+
+    GeneradorLecturas generador(opciones.semilla);
+    float* temperaturas = new float[n / 2];
+    int* presiones = new int[n - n / 2];
+    for (int64_t i = 0; i < n / 2; i++) {
+        temperaturas[i] = generador.temperaturaPaseo();
+    }
+    for (int64_t i = 0; i < n - n / 2; i++) {
+        presiones[i] = generador.presionPaseo();
+    }
+
+    ListaGestion lista;
+    SensorTemperatura* temperatura = new SensorTemperatura("T-001");
+    SensorPresion* presion = new SensorPresion("P-001");
+    lista.insertarSensor(temperatura);
+    lista.insertarSensor(presion);
+    temperatura->registrarLote(temperaturas, static_cast<size_t>(n / 2));
+    presion->registrarLote(presiones, static_cast<size_t>(n - n / 2));
+    delete[] temperaturas;
+    delete[] presiones;
+
+    InstantaneaGestion instantanea(lista, ruta.c_str());
+    ResultadoMedicion& guardar = medidor.medir("InstantaneaGestion", "guardar", n, n,
+                                               [&](Cronometro& c) {
+        c.iniciar();
+        bool correcto = instantanea.guardar();
+        c.detener();
+        MedidorRendimiento::consumir(correcto ? 1.0 : 0.0);
+    });
+    MedidorRendimiento::agregarMetrica(guardar, "bytes_archivo", tamanoArchivo(ruta));
+
+    medidor.medir("InstantaneaGestion", "cargar", n, n, [&](Cronometro& c) {
+        ListaGestion destino;
+        InstantaneaGestion carga(destino, ruta.c_str());
+        c.iniciar();
+        int restaurados = carga.cargar();
+        c.detener();
+        MedidorRendimiento::consumir(restaurados);
+    });
+
+    std::remove(ruta.c_str());
+}
+
+/**
+ * @brief Registro por lotes con y sin diario (durabilidad incluida en el tiempo)
+ */
+void medirDiario(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    int64_t n = opciones.tamanoMaximo < 2000000 ? opciones.tamanoMaximo : 2000000;
+    std::string ruta = opciones.rutaTemporal("iot_benchmarks.wal");
+    std::string rutaAnterior = ruta + ".anterior";
+
+    GeneradorLecturas generador(opciones.semilla);
+    float* valores = new float[n];
+    for (int64_t i = 0; i < n; i++) {
+        valores[i] = generador.temperaturaPaseo();
+    }
+
+    for (int conDiario = 0; conDiario <= 1; conDiario++) {
+        uint64_t sincronizaciones = 0;
+        double bytesAnotados = 0.0;
+        ResultadoMedicion& r = medidor.medir("DiarioLecturas",
+                                             conDiario ? "registrarLote (con diario)"
+                                                       : "registrarLote (sin diario)",
+                                             n, n, [&](Cronometro& c) {
+            std::remove(ruta.c_str());
+            std::remove(rutaAnterior.c_str());
+            ListaGestion lista;
+            SensorTemperatura* sensor = new SensorTemperatura("T-001");
+            lista.insertarSensor(sensor);
+            DiarioLecturas diario(ruta.c_str(), LATENCIA_DIARIO_MS);
+            if (conDiario) {
+                diario.abrir();
+                lista.asociarDiario(&diario);
+            }
+
+            c.iniciar();
+            for (int64_t i = 0; i < n; i += LECTURAS_POR_LOTE) {
+                int64_t cantidad = n - i < LECTURAS_POR_LOTE ? n - i : LECTURAS_POR_LOTE;
+                sensor->registrarLote(valores + i, static_cast<size_t>(cantidad));
+            }
+            if (conDiario) {
+                diario.sincronizar();  // Hasta que la última lectura es durable
+            }
+            c.detener();
+
+            if (conDiario) {
+                sincronizaciones = diario.obtenerSincronizaciones();
+                bytesAnotados = static_cast<double>(diario.obtenerBytesAnotados());
+                lista.asociarDiario(nullptr);
+                diario.cerrar();
+            }
+        });
+        if (conDiario) {
+            MedidorRendimiento::agregarMetrica(r, "fsync", static_cast<double>(sincronizaciones));
+            MedidorRendimiento::agregarMetrica(r, "bytes_anotados", bytesAnotados);
+        }
+    }
+
+    std::remove(ruta.c_str());
+    std::remove(rutaAnterior.c_str());
+    delete[] valores;
+}
+
+} // namespace
+
+void medirPersistencia(MedidorRendimiento& medidor, const OpcionesBancos& opciones) {
+    if (medidor.incluye("InstantaneaGestion")) {
+        medirInstantanea(medidor, opciones);
+    }
+    if (medidor.incluye("DiarioLecturas")) {
+        medirDiario(medidor, opciones);
+    }
+}
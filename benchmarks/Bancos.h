@@ -0,0 +1,50 @@
+/**
+ * @file Bancos.h
+ * @brief Grupos de pruebas de rendimiento del sistema de sensores
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef BANCOS_H
+#define BANCOS_H
+
+#include "MedidorRendimiento.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Parámetros comunes a todos los grupos
+ */
+struct OpcionesBancos {
+    int64_t tamanoMaximo;    ///< Mayor tamaño de lista (las series van de 1e2 a este valor)
+    std::string directorio;  ///< Carpeta para los archivos temporales
+    uint64_t semilla;        ///< Semilla de GeneradorLecturas
+
+    OpcionesBancos() : tamanoMaximo(10000000), semilla(20250101) {}
+
+    /**
+     * @brief Ruta de un archivo temporal dentro de directorio
+     */
+    std::string rutaTemporal(const char* nombre) const {
+        return directorio + "/" + nombre;
+    }
+};
+
+/**
+ * @brief ListaSensor, ListaSensorDesenrollada, asignadores, HistorialComprimido,
+ *        KernelsLecturas y ListaSensorConcurrente
+ */
+void medirListas(MedidorRendimiento& medidor, const OpcionesBancos& opciones);
+
+/**
+ * @brief AnalizadorTramas, ListaGestion::buscarSensor, captura simulada
+ *        de extremo a extremo e ImportadorCaptura
+ */
+void medirIngesta(MedidorRendimiento& medidor, const OpcionesBancos& opciones);
+
+/**
+ * @brief InstantaneaGestion (guardar y cargar) y DiarioLecturas (con y sin diario)
+ */
+void medirPersistencia(MedidorRendimiento& medidor, const OpcionesBancos& opciones);
+
+#endif // BANCOS_H
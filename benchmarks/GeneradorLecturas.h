@@ -0,0 +1,87 @@
+/**
+ * @file GeneradorLecturas.h
+ * @brief Lecturas pseudoaleatorias reproducibles para las pruebas de rendimiento
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef GENERADORLECTURAS_H
+#define GENERADORLECTURAS_H
+
+#include <cstdint>
+
+/**
+ * @class GeneradorLecturas
+ * @brief Secuencias deterministas de temperaturas y presiones
+ *
+ * Usa un generador congruencial de 64 bits (constantes de Knuth) en lugar
+ * de rand(), de modo que la misma semilla produce los mismos datos en
+ * cualquier plataforma y biblioteca estándar.
+ *
+ * Dos formas de datos:
+ * - uniformes: cada lectura independiente de la anterior (peor caso para
+ *   la compresión);
+ * - paseo aleatorio: variaciones pequeñas a partir de la anterior, con
+ *   dos decimales, como una sonda real muestreada cada segundo.
+ */
+class GeneradorLecturas {
+private:
+    uint64_t estado;       ///< Estado del generador congruencial
+    int centesimas;        ///< Última temperatura del paseo aleatorio (°C × 100)
+    int presion;           ///< Última presión del paseo aleatorio
+
+public:
+    /**
+     * @brief Constructor
+     * @param semilla Semilla (la misma semilla repite la secuencia)
+     */
+    explicit GeneradorLecturas(uint64_t semilla)
+        : estado(semilla), centesimas(2250), presion(101) {}
+
+    /**
+     * @brief Siguientes 32 bits pseudoaleatorios
+     */
+    uint32_t siguiente() {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(estado >> 32);
+    }
+
+    /**
+     * @brief Entero uniforme en [0, limite)
+     */
+    uint32_t enRango(uint32_t limite) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(siguiente()) * limite) >> 32);
+    }
+
+    /**
+     * @brief Temperatura uniforme entre -20.00 y 60.00 °C
+     */
+    float temperaturaUniforme() {
+        return static_cast<float>(static_cast<int>(enRango(8001)) - 2000) / 100.0f;
+    }
+
+    /**
+     * @brief Presión uniforme entre 80 y 120 kPa
+     */
+    int presionUniforme() {
+        return 80 + static_cast<int>(enRango(41));
+    }
+
+    /**
+     * @brief Temperatura que varía a lo sumo ±0.05 °C respecto de la anterior
+     */
+    float temperaturaPaseo() {
+        centesimas += static_cast<int>(enRango(11)) - 5;
+        return static_cast<float>(centesimas) / 100.0f;
+    }
+
+    /**
+     * @brief Presión que sube, baja o se mantiene en 1 kPa
+     */
+    int presionPaseo() {
+        presion += static_cast<int>(enRango(3)) - 1;
+        return presion;
+    }
+};
+
+#endif // GENERADORLECTURAS_H
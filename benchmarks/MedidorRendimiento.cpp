@@ -0,0 +1,221 @@
+/**
+ * @file MedidorRendimiento.cpp
+ * @brief Implementación del medidor de pruebas de rendimiento
+ */
+
+#include "MedidorRendimiento.h"
+#include "KernelsLecturas.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+/// Destino de consumir(): volatile para que la escritura no se elimine
+volatile double sumidero = 0.0;
+
+/**
+ * @brief Copia un texto en un arreglo de tamaño fijo, truncando si hace falta
+ */
+void copiarTexto(char* destino, size_t capacidad, const char* origen) {
+    strncpy(destino, origen, capacidad - 1);
+    destino[capacidad - 1] = '\0';
+}
+
+/**
+ * @brief Escribe un texto como cadena JSON (entre comillas y escapado)
+ */
+void escribirCadena(std::ostream& salida, const char* texto) {
+    salida << '"';
+    for (const char* c = texto; *c != '\0'; c++) {
+        unsigned char u = static_cast<unsigned char>(*c);
+        if (*c == '"' || *c == '\\') {
+            salida << '\\' << *c;
+        } else if (u < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", u);
+            salida << escape;
+        } else {
+            salida << *c;
+        }
+    }
+    salida << '"';
+}
+
+/**
+ * @brief Escribe un número JSON (los no finitos, que JSON no admite, como null)
+ */
+void escribirNumero(std::ostream& salida, double valor) {
+    if (valor != valor || valor > 1e300 || valor < -1e300) {
+        salida << "null";
+        return;
+    }
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%.6g", valor);
+    salida << texto;
+}
+
+/**
+ * @brief Compilador y versión, según las macros predefinidas
+ */
+const char* describirCompilador() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "desconocido";
+#endif
+}
+
+/**
+ * @brief Máximo de memoria residente del proceso en KB (0 si no se conoce)
+ */
+long memoriaResidenteMaximaKb() {
+#ifndef _WIN32
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) == 0) {
+#ifdef __APPLE__
+        return uso.ru_maxrss / 1024;  // macOS la da en bytes
+#else
+        return uso.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
+MedidorRendimiento::MedidorRendimiento(int repeticiones, const char* filtro)
+    : repeticiones(repeticiones > 0 ? repeticiones : 1), filtro(filtro),
+      resultados(nullptr), numResultados(0), capacidad(0) {
+}
+
+MedidorRendimiento::~MedidorRendimiento() {
+    delete[] resultados;
+}
+
+bool MedidorRendimiento::incluye(const char* grupo) const {
+    return filtro == nullptr || strstr(grupo, filtro) != nullptr;
+}
+
+ResultadoMedicion& MedidorRendimiento::registrar(const char* grupo, const char* prueba, int64_t n,
+                                                 int64_t operaciones, int64_t* tiemposNs,
+                                                 int cantidad) {
+    if (numResultados == capacidad) {
+        int nueva = capacidad == 0 ? 64 : capacidad * 2;
+        ResultadoMedicion* mayor = new ResultadoMedicion[nueva];
+        for (int i = 0; i < numResultados; i++) {
+            mayor[i] = resultados[i];
+        }
+        delete[] resultados;
+        resultados = mayor;
+        capacidad = nueva;
+    }
+
+    std::sort(tiemposNs, tiemposNs + cantidad);
+    double mediana = cantidad % 2 == 1
+        ? static_cast<double>(tiemposNs[cantidad / 2])
+        : (tiemposNs[cantidad / 2 - 1] + tiemposNs[cantidad / 2]) / 2.0;
+    double porOperacion = operaciones > 0 ? 1.0 / operaciones : 1.0;
+
+    ResultadoMedicion& r = resultados[numResultados++];
+    copiarTexto(r.grupo, sizeof(r.grupo), grupo);
+    copiarTexto(r.prueba, sizeof(r.prueba), prueba);
+    r.n = n;
+    r.operaciones = operaciones;
+    r.repeticiones = cantidad;
+    r.nsMediana = mediana * porOperacion;
+    r.nsMinimo = tiemposNs[0] * porOperacion;
+    r.nsMaximo = tiemposNs[cantidad - 1] * porOperacion;
+    r.numMetricas = 0;
+
+    // Progreso legible por stderr; el JSON va a su propio destino
+    char linea[160];
+    snprintf(linea, sizeof(linea), "%-22s %-34s n=%-10lld %12.2f ns/op\n",
+             r.grupo, r.prueba, static_cast<long long>(n), r.nsMediana);
+    std::cerr << linea;
+    return r;
+}
+
+void MedidorRendimiento::agregarMetrica(ResultadoMedicion& resultado, const char* nombre,
+                                        double valor) {
+    if (resultado.numMetricas < ResultadoMedicion::MAX_METRICAS) {
+        int i = resultado.numMetricas++;
+        copiarTexto(resultado.nombresMetricas[i], sizeof(resultado.nombresMetricas[i]), nombre);
+        resultado.metricas[i] = valor;
+    }
+}
+
+void MedidorRendimiento::escribirJson(std::ostream& salida, int64_t tamanoMaximo) const {
+    char fecha[32] = "";
+    std::time_t ahora = std::time(nullptr);
+    std::tm* utc = std::gmtime(&ahora);
+    if (utc != nullptr) {
+        std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%SZ", utc);
+    }
+
+    salida << "{\n";
+    salida << "  \"formato\": 1,\n";
+    salida << "  \"programa\": \"SistemaIoTSensores\",\n";
+    salida << "  \"fecha\": ";
+    escribirCadena(salida, fecha);
+    salida << ",\n  \"compilador\": ";
+    escribirCadena(salida, describirCompilador());
+    salida << ",\n  \"simd\": ";
+    escribirCadena(salida, KernelsLecturas::nombreNivel(KernelsLecturas::nivelDisponible()));
+    salida << ",\n  \"hilos_hardware\": " << std::thread::hardware_concurrency();
+    salida << ",\n  \"repeticiones\": " << repeticiones;
+    salida << ",\n  \"tamano_maximo\": " << tamanoMaximo;
+    salida << ",\n  \"memoria_residente_maxima_kb\": " << memoriaResidenteMaximaKb();
+    salida << ",\n  \"resultados\": [";
+
+    for (int i = 0; i < numResultados; i++) {
+        const ResultadoMedicion& r = resultados[i];
+        salida << (i == 0 ? "\n" : ",\n") << "    {\"grupo\": ";
+        escribirCadena(salida, r.grupo);
+        salida << ", \"prueba\": ";
+        escribirCadena(salida, r.prueba);
+        salida << ", \"n\": " << r.n
+               << ", \"operaciones\": " << r.operaciones
+               << ", \"repeticiones\": " << r.repeticiones
+               << ", \"ns_por_operacion\": ";
+        escribirNumero(salida, r.nsMediana);
+        salida << ", \"ns_minimo\": ";
+        escribirNumero(salida, r.nsMinimo);
+        salida << ", \"ns_maximo\": ";
+        escribirNumero(salida, r.nsMaximo);
+        salida << ", \"operaciones_por_segundo\": ";
+        escribirNumero(salida, r.nsMediana > 0.0 ? 1e9 / r.nsMediana : 0.0);
+        salida << ", \"metricas\": {";
+        for (int m = 0; m < r.numMetricas; m++) {
+            salida << (m == 0 ? "" : ", ");
+            escribirCadena(salida, r.nombresMetricas[m]);
+            salida << ": ";
+            escribirNumero(salida, r.metricas[m]);
+        }
+        salida << "}}";
+    }
+    salida << "\n  ]\n}\n";
+}
+
+void MedidorRendimiento::consumir(double valor) {
+    sumidero = sumidero + valor;
+}
+
+void MedidorRendimiento::barrera(const void* objeto) {
+    // La definición está aquí, fuera de la vista de las pruebas
+    if (objeto == nullptr) {
+        sumidero = sumidero + 1.0;
+    }
+}
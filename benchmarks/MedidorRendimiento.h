@@ -0,0 +1,162 @@
+/**
+ * @file MedidorRendimiento.h
+ * @brief Cronometraje repetido de pruebas de rendimiento y salida en JSON
+ * @author Sistema IoT
+ * @date 2025
+ */
+
+#ifndef MEDIDORRENDIMIENTO_H
+#define MEDIDORRENDIMIENTO_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class Cronometro
+ * @brief Marca la parte medida de una repetición
+ *
+ * Lo que la prueba hace antes de iniciar() o después de detener()
+ * (preparar datos, destruir listas) no cuenta en el tiempo.
+ */
+class Cronometro {
+private:
+    typedef std::chrono::steady_clock Reloj;
+    Reloj::time_point inicio;   ///< Instante de iniciar()
+    int64_t acumuladoNs;        ///< Tiempo medido hasta ahora
+
+public:
+    Cronometro() : acumuladoNs(0) {}
+
+    void iniciar() { inicio = Reloj::now(); }
+
+    void detener() {
+        acumuladoNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Reloj::now() - inicio).count();
+    }
+
+    int64_t obtenerNs() const { return acumuladoNs; }
+};
+
+/**
+ * @brief Resultado de una prueba: tiempos por operación y métricas propias
+ */
+struct ResultadoMedicion {
+    static const int MAX_METRICAS = 6;
+
+    char grupo[32];           ///< Componente medido ("ListaSensor", "Captura", ...)
+    char prueba[48];          ///< Operación ("insertarAlFinal", ...)
+    int64_t n;                ///< Tamaño del problema (lecturas, sensores, ...)
+    int64_t operaciones;      ///< Operaciones por repetición
+    int repeticiones;         ///< Repeticiones medidas
+    double nsMediana;         ///< Mediana del tiempo por operación (ns)
+    double nsMinimo;          ///< Mejor repetición (ns por operación)
+    double nsMaximo;          ///< Peor repetición (ns por operación)
+    char nombresMetricas[MAX_METRICAS][32];  ///< Métricas adicionales
+    double metricas[MAX_METRICAS];
+    int numMetricas;
+};
+
+/**
+ * @class MedidorRendimiento
+ * @brief Ejecuta cada prueba varias veces y reúne los resultados
+ *
+ *     medidor.medir("ListaSensor", "insertarAlFinal", n, n, [&](Cronometro& c) {
+ *         ListaSensor<float> lista;
+ *         c.iniciar();
+ *         for (...) lista.insertarAlFinal(v[i]);
+ *         c.detener();
+ *     });
+ *
+ * Cada prueba se ejecuta una vez sin medir (calienta cachés y el
+ * asignador) y después el número de repeticiones configurado; se informa
+ * la mediana, que es estable frente a interrupciones puntuales del
+ * sistema, junto al mínimo y al máximo. escribirJson() vuelca todos los
+ * resultados en un documento con los datos de la máquina, para comparar
+ * entre versiones.
+ */
+class MedidorRendimiento {
+private:
+    int repeticiones;              ///< Repeticiones medidas por prueba
+    const char* filtro;            ///< Solo grupos que contienen este texto (nullptr = todos)
+    ResultadoMedicion* resultados; ///< Resultados en orden de ejecución
+    int numResultados;
+    int capacidad;
+
+    /**
+     * @brief Guarda un resultado calculado a partir de los tiempos medidos
+     */
+    ResultadoMedicion& registrar(const char* grupo, const char* prueba, int64_t n,
+                                 int64_t operaciones, int64_t* tiemposNs, int cantidad);
+
+public:
+    /**
+     * @brief Constructor
+     * @param repeticiones Repeticiones medidas por prueba (>= 1)
+     * @param filtro Texto que debe contener el grupo para ejecutarse (nullptr = todos)
+     */
+    MedidorRendimiento(int repeticiones, const char* filtro);
+
+    ~MedidorRendimiento();
+
+    /**
+     * @brief Indica si las pruebas de un grupo pasan el filtro
+     */
+    bool incluye(const char* grupo) const;
+
+    /**
+     * @brief Mide una prueba
+     * @param grupo Componente medido
+     * @param prueba Operación medida
+     * @param n Tamaño del problema
+     * @param operaciones Operaciones que hace cada repetición (para ns/operación)
+     * @param cuerpo Invocable con un Cronometro&; marca la parte medida
+     * @return Resultado, para añadir métricas con agregarMetrica()
+     */
+    template <typename Funcion>
+    ResultadoMedicion& medir(const char* grupo, const char* prueba, int64_t n,
+                             int64_t operaciones, Funcion cuerpo) {
+        Cronometro calentamiento;
+        cuerpo(calentamiento);
+
+        int64_t* tiempos = new int64_t[repeticiones];
+        for (int r = 0; r < repeticiones; r++) {
+            Cronometro cronometro;
+            cuerpo(cronometro);
+            tiempos[r] = cronometro.obtenerNs();
+        }
+        ResultadoMedicion& resultado = registrar(grupo, prueba, n, operaciones, tiempos, repeticiones);
+        delete[] tiempos;
+        return resultado;
+    }
+
+    /**
+     * @brief Añade una métrica propia a un resultado (bytes por lectura, ...)
+     */
+    static void agregarMetrica(ResultadoMedicion& resultado, const char* nombre, double valor);
+
+    /**
+     * @brief Escribe todos los resultados como un documento JSON
+     * @param salida Flujo destino
+     * @param tamanoMaximo Mayor tamaño de lista usado en la ejecución
+     */
+    void escribirJson(std::ostream& salida, int64_t tamanoMaximo) const;
+
+    /**
+     * @brief Impide que el compilador descarte un cálculo cuyo resultado no se usa
+     */
+    static void consumir(double valor);
+
+    /**
+     * @brief Impide que el compilador dé por constante el objeto apuntado
+     *
+     * Definida en otra unidad de traducción: el compilador debe suponer
+     * que la llamada lee y modifica el objeto.
+     */
+    static void barrera(const void* objeto);
+
+    MedidorRendimiento(const MedidorRendimiento&) = delete;
+    MedidorRendimiento& operator=(const MedidorRendimiento&) = delete;
+};
+
+#endif // MEDIDORRENDIMIENTO_H
@@ -0,0 +1,145 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Programa de pruebas de rendimiento del Sistema IoT de Sensores
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * Mide las estructuras y los caminos de datos del sistema con entradas
+ * reproducibles (GeneradorLecturas con semilla fija) y escribe los
+ * resultados en JSON para compararlos entre versiones. El progreso
+ * legible va a stderr.
+ */
+
+#include "Bancos.h"
+#include "Log.h"
+#include "MedidorRendimiento.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Búfer que descarta todo lo escrito
+ *
+ * Los sensores y el simulador informan por cout; durante las mediciones
+ * ese texto solo añadiría ruido (y tiempo de terminal) a los resultados.
+ */
+class BufferNulo : public streambuf {
+protected:
+    int overflow(int c) override {
+        return traits_type::not_eof(c);
+    }
+
+    streamsize xsputn(const char*, streamsize n) override {
+        return n;
+    }
+};
+
+/**
+ * @brief Carpeta de archivos temporales del sistema
+ */
+string directorioTemporal() {
+#ifdef _WIN32
+    const char* variable = getenv("TEMP");
+    return variable != nullptr ? variable : ".";
+#else
+    const char* variable = getenv("TMPDIR");
+    return variable != nullptr && variable[0] != '\0' ? variable : "/tmp";
+#endif
+}
+
+/**
+ * @brief Lee un entero positivo de un argumento
+ * @return false si el texto no es un número mayor que cero
+ */
+bool leerPositivo(const char* texto, long long& valor) {
+    char* fin = nullptr;
+    valor = strtoll(texto, &fin, 10);
+    if (fin != nullptr && (*fin == 'e' || *fin == 'E')) {
+        valor = static_cast<long long>(strtod(texto, &fin));  // Admite 1e7
+    }
+    return fin != texto && *fin == '\0' && valor > 0;
+}
+
+} // namespace
+
+/**
+ * @brief Función principal de las pruebas de rendimiento
+ *
+ * Opciones de línea de comandos:
+ * - --salida RUTA: escribe el JSON en RUTA (por defecto, en stdout)
+ * - --repeticiones N: mediciones por prueba; se publica la mediana (5)
+ * - --filtro TEXTO: solo los grupos cuyo nombre contiene TEXTO
+ * - --tamano-maximo N: mayor tamaño de lista, de 1e2 a N (1e7)
+ * - --directorio RUTA: carpeta de los archivos temporales (TMPDIR o /tmp)
+ * - --semilla N: semilla de las lecturas generadas
+ */
+int main(int argc, char* argv[]) {
+    OpcionesBancos opciones;
+    opciones.directorio = directorioTemporal();
+    const char* rutaSalida = nullptr;
+    const char* filtro = nullptr;
+    long long repeticiones = 5;
+
+    bool opcionesValidas = true;
+    for (int i = 1; i < argc && opcionesValidas; i++) {
+        if (i + 1 >= argc) {
+            opcionesValidas = false;
+            break;
+        }
+        const char* valor = argv[++i];
+        long long numero = 0;
+        if (strcmp(argv[i - 1], "--salida") == 0) {
+            rutaSalida = valor;
+        } else if (strcmp(argv[i - 1], "--filtro") == 0) {
+            filtro = valor;
+        } else if (strcmp(argv[i - 1], "--directorio") == 0) {
+            opciones.directorio = valor;
+        } else if (strcmp(argv[i - 1], "--repeticiones") == 0 && leerPositivo(valor, numero)) {
+            repeticiones = numero;
+        } else if (strcmp(argv[i - 1], "--tamano-maximo") == 0 && leerPositivo(valor, numero)
+                   && numero >= 100) {
+            opciones.tamanoMaximo = numero;
+        } else if (strcmp(argv[i - 1], "--semilla") == 0 && leerPositivo(valor, numero)) {
+            opciones.semilla = static_cast<uint64_t>(numero);
+        } else {
+            opcionesValidas = false;
+        }
+    }
+    if (!opcionesValidas) {
+        cerr << "Uso: " << argv[0] << " [--salida RUTA] [--repeticiones N] [--filtro TEXTO]"
+             << " [--tamano-maximo N] [--directorio RUTA] [--semilla N]\n";
+        return 1;
+    }
+
+    // El registro va a stderr y solo con errores; cout se silencia
+    Log::establecerDestino(stderr);
+    Log::establecerNivel(Log::ERROR);
+    BufferNulo nulo;
+    streambuf* salidaEstandar = cout.rdbuf(&nulo);
+
+    MedidorRendimiento medidor(static_cast<int>(repeticiones), filtro);
+    medirListas(medidor, opciones);
+    medirIngesta(medidor, opciones);
+    medirPersistencia(medidor, opciones);
+
+    cout.rdbuf(salidaEstandar);
+    if (rutaSalida == nullptr) {
+        medidor.escribirJson(cout, opciones.tamanoMaximo);
+        return 0;
+    }
+    ofstream archivo(rutaSalida);
+    medidor.escribirJson(archivo, opciones.tamanoMaximo);
+    if (!archivo) {
+        cerr << "✗ No se pudo escribir " << rutaSalida << "\n";
+        return 1;
+    }
+    cerr << "✓ Resultados guardados en " << rutaSalida << "\n";
+    return 0;
+}
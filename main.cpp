@@ -13,53 +13,196 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <string>
 #include <cstdlib>
 #include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 #include "SensorBase.h"
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
 #include "ListaGestion.h"
 #include "ArduinoSimulador.h"
+#include "CanalizacionCaptura.h"
+#include "RitmoCaptura.h"
+#include "InstantaneaGestion.h"
+#include "DiarioLecturas.h"
+#include "ImportadorCaptura.h"
+#include "ServicioSensores.h"
 
 using namespace std;
 
+/**
+ * @brief Opciones de arranque, de la línea de comandos o de un archivo
+ */
+struct OpcionesPrograma {
+    string rutaInstantanea;          ///< --instantanea
+    int segundosGuardado;            ///< --guardar-cada
+    string rutaDiario;               ///< --diario
+    int latenciaDiario;              ///< --latencia-diario
+    string rutaImportar;             ///< --importar
+    bool servicio;                   ///< --servicio
+    ConfiguracionServicio configuracion;  ///< Opciones del modo servicio (y --hilos)
+
+    OpcionesPrograma() : segundosGuardado(0), latenciaDiario(10), servicio(false) {}
+};
+
 // ========== PROTOTIPOS DE FUNCIONES ==========
+bool aplicarOpcion(OpcionesPrograma& opciones, const string& nombre, const string& valor);
+bool leerArchivoOpciones(OpcionesPrograma& opciones, const char* ruta);
 void mostrarMenu();
 void crearSensor(ListaGestion& lista);
 void registrarLectura(ListaGestion& lista, ArduinoSimulador& arduino);
 void procesarSensores(ListaGestion& lista);
 void mostrarSensores(ListaGestion& lista);
 void capturarDesdeArduino(ListaGestion& lista, ArduinoSimulador& arduino);
+void capturarEnCanalizacion(ListaGestion& lista, ArduinoSimulador& arduino);
+bool importarCaptura(ListaGestion& lista, const char* ruta, int hilos);
 void limpiarPantalla();
 void pausar();
 
 /**
  * @brief Función principal del sistema
+ *
+ * Opciones de línea de comandos:
+ * - --instantanea RUTA: restaura los sensores de RUTA al arrancar y los
+ *   guarda allí al salir
+ * - --guardar-cada SEG: además, guarda la instantánea cada SEG segundos
+ * - --diario RUTA: anota cada lectura en el diario RUTA y, al arrancar,
+ *   recupera las que no llegaron a la instantánea
+ * - --latencia-diario MS: espera máxima de una lectura antes de su fsync
+ * - --importar RUTA: carga las tramas del archivo RUTA, muestra el
+ *   rendimiento y termina sin abrir el menú
+ * - --hilos N: hilos de análisis de --importar y del procesamiento del
+ *   modo servicio (0 = todos los núcleos)
+ * - --servicio: modo desatendido (ServicioSensores), sin menú ni lecturas
+ *   de stdin; lo ajustan --sensores LISTA, --puerto RUTA, --frecuencia N,
+ *   --procesar-cada SEG, --duracion SEG y --salida RUTA
+ * - --config RUTA: lee opciones de un archivo, una por línea
+ *   ("clave = valor", sin los guiones; '#' inicia un comentario)
  */
-int main() {
+int main(int argc, char* argv[]) {
+    OpcionesPrograma opciones;
+    bool opcionesValidas = true;
+    for (int i = 1; i < argc && opcionesValidas; i++) {
+        if (strcmp(argv[i], "--servicio") == 0) {
+            opciones.servicio = true;
+        } else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            opcionesValidas = leerArchivoOpciones(opciones, argv[++i]);
+        } else if (i + 1 < argc) {
+            opcionesValidas = aplicarOpcion(opciones, argv[i], argv[i + 1]);
+            i++;
+        } else {
+            opcionesValidas = false;
+        }
+    }
+    if (!opcionesValidas) {
+        cerr << "Uso: " << argv[0] << " [--config RUTA]"
+             << " [--instantanea RUTA [--guardar-cada SEG]]"
+             << " [--diario RUTA [--latencia-diario MS]]"
+             << " [--importar RUTA] [--hilos N]"
+             << " [--servicio [--sensores T-001,P-001] [--puerto RUTA] [--frecuencia N]"
+             << " [--procesar-cada SEG] [--duracion SEG] [--salida RUTA]]\n";
+        return 1;
+    }
+
+    const char* rutaInstantanea =
+        opciones.rutaInstantanea.empty() ? nullptr : opciones.rutaInstantanea.c_str();
+    const char* rutaDiario = opciones.rutaDiario.empty() ? nullptr : opciones.rutaDiario.c_str();
+    const char* rutaImportar =
+        opciones.rutaImportar.empty() ? nullptr : opciones.rutaImportar.c_str();
+    int segundosGuardado = opciones.segundosGuardado;
+    int latenciaDiario = opciones.latenciaDiario;
+    bool interactivo = rutaImportar == nullptr && !opciones.servicio;
+
     // Objeto de gestión polimórfica (almacena SensorBase*)
     ListaGestion sistemaGestion;
     
     // Simulador de Arduino para captura de datos
     ArduinoSimulador arduino;
+
+    // Persistencia opcional (se destruye antes que la lista)
+    InstantaneaGestion* instantanea = nullptr;
+    DiarioLecturas* diario = nullptr;
     
     int opcion;
     bool salir = false;
+    int codigoSalida = 0;
     
-    // Pantalla de bienvenida
-    limpiarPantalla();
-    cout << "╔═══════════════════════════════════════════════════════╗\n";
-    cout << "║   SISTEMA IoT DE GESTIÓN POLIMÓRFICA DE SENSORES     ║\n";
-    cout << "║              Caso de Estudio - C++                    ║\n";
-    cout << "╚═══════════════════════════════════════════════════════╝\n\n";
-    
-    cout << "Demostrando:\n";
-    cout << "  ✓ Herencia y Polimorfismo\n";
-    cout << "  ✓ Listas Enlazadas Genéricas (Templates)\n";
-    cout << "  ✓ Gestión Manual de Memoria\n";
-    cout << "  ✓ Simulación de Arduino Serial\n\n";
+    // Pantalla de bienvenida (la importación y el servicio no son interactivos)
+    if (interactivo) {
+        limpiarPantalla();
+        cout << "╔═══════════════════════════════════════════════════════╗\n";
+        cout << "║   SISTEMA IoT DE GESTIÓN POLIMÓRFICA DE SENSORES     ║\n";
+        cout << "║              Caso de Estudio - C++                    ║\n";
+        cout << "╚═══════════════════════════════════════════════════════╝\n\n";
+        
+        cout << "Demostrando:\n";
+        cout << "  ✓ Herencia y Polimorfismo\n";
+        cout << "  ✓ Listas Enlazadas Genéricas (Templates)\n";
+        cout << "  ✓ Gestión Manual de Memoria\n";
+        cout << "  ✓ Simulación de Arduino Serial\n\n";
+    }
+
+    if (rutaInstantanea != nullptr) {
+        instantanea = new InstantaneaGestion(sistemaGestion, rutaInstantanea);
+        int restaurados = instantanea->cargar();
+        if (restaurados < 0) {
+            cout << "⚠ La instantánea " << rutaInstantanea << " está dañada; se ignora.\n\n";
+        } else if (restaurados > 0) {
+            cout << "✓ " << restaurados << " sensores restaurados de " << rutaInstantanea << ".\n\n";
+        }
+    }
+
+    if (rutaDiario != nullptr) {
+        // Tras la instantánea: solo se reaplican las lecturas posteriores
+        diario = new DiarioLecturas(rutaDiario, latenciaDiario);
+        int64_t recuperadas = diario->reproducir(sistemaGestion);
+        if (recuperadas < 0) {
+            cout << "⚠ El diario " << rutaDiario << " no es válido; no se usa.\n\n";
+            delete diario;
+            diario = nullptr;
+        } else {
+            if (recuperadas > 0) {
+                cout << "✓ " << recuperadas << " lecturas recuperadas del diario.\n\n";
+            }
+            if (diario->abrir()) {
+                sistemaGestion.asociarDiario(diario);
+            } else {
+                cout << "⚠ No se pudo abrir el diario " << rutaDiario << ".\n\n";
+                delete diario;
+                diario = nullptr;
+            }
+        }
+    }
+
+    if (instantanea != nullptr) {
+        instantanea->asociarDiario(diario);
+        if (segundosGuardado > 0) {
+            instantanea->iniciarGuardadoPeriodico(static_cast<int64_t>(segundosGuardado) * 1000);
+        }
+    }
     
-    pausar();
+    if (rutaImportar != nullptr) {
+        if (!importarCaptura(sistemaGestion, rutaImportar, opciones.configuracion.hilos)) {
+            codigoSalida = 1;
+        }
+    }
+    if (opciones.servicio && codigoSalida == 0) {
+        ServicioSensores servicio(sistemaGestion, arduino, opciones.configuracion);
+        if (!servicio.ejecutar()) {
+            codigoSalida = 1;
+        }
+    }
+    if (interactivo) {
+        pausar();
+    } else {
+        salir = true;
+    }
     
     // Bucle principal del menú
     while (!salir) {
@@ -111,12 +254,117 @@ int main() {
         }
     }
     
+    if (instantanea != nullptr) {
+        instantanea->detenerGuardadoPeriodico();
+        if (instantanea->guardar()) {
+            cout << "✓ Instantánea guardada en " << rutaInstantanea << ".\n";
+        } else {
+            cout << "❌ No se pudo guardar la instantánea.\n";
+        }
+    }
+    delete instantanea;
+    if (diario != nullptr) {
+        sistemaGestion.asociarDiario(nullptr);
+        delete diario;  // Vuelca y sincroniza lo pendiente
+    }
+
     // Al salir del programa, el destructor de ListaGestion
     // se ejecuta automáticamente, liberando toda la memoria
     
     cout << "\n✓ Sistema finalizado correctamente.\n\n";
     
-    return 0;
+    return codigoSalida;
+}
+
+/**
+ * @brief Aplica una opción de arranque
+ * @param opciones Opciones a completar
+ * @param nombre Nombre con guiones ("--diario")
+ * @param valor Valor de la opción
+ * @return false si la opción no existe
+ */
+bool aplicarOpcion(OpcionesPrograma& opciones, const string& nombre, const string& valor) {
+    ConfiguracionServicio& servicio = opciones.configuracion;
+    if (nombre == "--instantanea") {
+        opciones.rutaInstantanea = valor;
+    } else if (nombre == "--guardar-cada") {
+        opciones.segundosGuardado = atoi(valor.c_str());
+    } else if (nombre == "--diario") {
+        opciones.rutaDiario = valor;
+    } else if (nombre == "--latencia-diario") {
+        opciones.latenciaDiario = atoi(valor.c_str());
+    } else if (nombre == "--importar") {
+        opciones.rutaImportar = valor;
+    } else if (nombre == "--hilos") {
+        servicio.hilos = atoi(valor.c_str());
+    } else if (nombre == "--servicio") {
+        opciones.servicio = valor.empty() || valor == "1" || valor == "si" || valor == "sí";
+    } else if (nombre == "--sensores") {
+        servicio.sensores = valor;
+    } else if (nombre == "--puerto") {
+        servicio.puerto = valor;
+    } else if (nombre == "--frecuencia") {
+        servicio.lecturasPorSegundo = atof(valor.c_str());
+    } else if (nombre == "--procesar-cada") {
+        servicio.procesarCadaSeg = atoi(valor.c_str());
+    } else if (nombre == "--duracion") {
+        servicio.duracionSeg = atoi(valor.c_str());
+    } else if (nombre == "--salida") {
+        servicio.salida = valor;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee opciones de arranque de un archivo de configuración
+ * @param opciones Opciones a completar
+ * @param ruta Archivo con una opción por línea: "clave = valor" o "clave valor"
+ * @return false si no se pudo leer o tiene una opción desconocida
+ *
+ * Las claves son los nombres de las opciones sin "--". Se ignoran las
+ * líneas vacías y lo que sigue a '#'. Las opciones posteriores de la
+ * línea de comandos prevalecen sobre las del archivo.
+ */
+bool leerArchivoOpciones(OpcionesPrograma& opciones, const char* ruta) {
+    ifstream archivo(ruta);
+    if (!archivo) {
+        cerr << "❌ No se pudo leer el archivo de configuración " << ruta << ".\n";
+        return false;
+    }
+
+    const char* blancos = " \t\r";
+    string linea;
+    int numero = 0;
+    while (getline(archivo, linea)) {
+        numero++;
+        size_t comentario = linea.find('#');
+        if (comentario != string::npos) {
+            linea.erase(comentario);
+        }
+        size_t inicio = linea.find_first_not_of(blancos);
+        if (inicio == string::npos) {
+            continue;
+        }
+        linea = linea.substr(inicio, linea.find_last_not_of(blancos) - inicio + 1);
+
+        // La clave termina en el primer '=' o blanco
+        size_t finClave = linea.find_first_of(" \t=");
+        string clave = linea.substr(0, finClave);
+        string valor;
+        if (finClave != string::npos) {
+            size_t inicioValor = linea.find_first_not_of(" \t=", finClave);
+            if (inicioValor != string::npos) {
+                valor = linea.substr(inicioValor);
+            }
+        }
+        if (!aplicarOpcion(opciones, "--" + clave, valor)) {
+            cerr << "❌ " << ruta << ":" << numero << ": opción desconocida '" << clave << "'.\n";
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
@@ -176,6 +424,28 @@ void crearSensor(ListaGestion& lista) {
             return;
     }
     
+    // Historial acotado: memoria fija por sensor y promedio de ventana
+    int maxLecturas;
+    cout << "\nRetención del historial (máximo de lecturas, 0 = sin límite): ";
+    cin >> maxLecturas;
+    cin.ignore(1000, '\n');
+    if (maxLecturas > 0) {
+        double segundos;
+        cout << "Antigüedad máxima en segundos (0 = sin límite): ";
+        cin >> segundos;
+        cin.ignore(1000, '\n');
+        nuevoSensor->configurarRetencion(maxLecturas, static_cast<int64_t>(segundos * 1000.0));
+    } else {
+        // Historial sin límite: opcionalmente comprimido
+        char respuesta;
+        cout << "¿Comprimir el historial? (s/n): ";
+        cin >> respuesta;
+        cin.ignore(1000, '\n');
+        if (respuesta == 's' || respuesta == 'S') {
+            nuevoSensor->configurarCompresion(true);
+        }
+    }
+
     // Inserta el sensor en la lista de gestión polimórfica
     lista.insertarSensor(nuevoSensor);
     cout << "\n✓ Sensor creado e insertado exitosamente.\n";
@@ -236,7 +506,19 @@ void procesarSensores(ListaGestion& lista) {
     // procesarTodosSensores() itera sobre la lista y llama a procesarLectura()
     // de cada sensor. Aunque todos son SensorBase*, cada uno ejecuta
     // su implementación específica (temperatura elimina mínimo, presión calcula promedio)
-    lista.procesarTodosSensores();
+    int modo;
+    cout << "\nModo de procesamiento:\n";
+    cout << "  1. Secuencial\n";
+    cout << "  2. Paralelo (un hilo por núcleo, mismo informe)\n";
+    cout << "Opción: ";
+    cin >> modo;
+    cin.ignore(1000, '\n');
+
+    if (modo == 2) {
+        lista.procesarTodosSensoresParalelo();
+    } else {
+        lista.procesarTodosSensores();
+    }
 }
 
 /**
@@ -279,6 +561,20 @@ void capturarDesdeArduino(ListaGestion& lista, ArduinoSimulador& arduino) {
     
     cout << "Sensores disponibles:\n";
     lista.imprimirTodosSensores();
+
+    int modo;
+    cout << "\nModo de captura:\n";
+    cout << "  1. Ritmo real (lecturas por segundo fijas)\n";
+    cout << "  2. Máximo rendimiento (sin pausas)\n";
+    cout << "  3. Canalización en segundo plano (todos los sensores)\n";
+    cout << "Opción: ";
+    cin >> modo;
+    cin.ignore(1000, '\n');
+
+    if (modo == 3) {
+        capturarEnCanalizacion(lista, arduino);
+        return;
+    }
     
     char nombre[50];
     cout << "\nIngrese el nombre del sensor para capturar datos: ";
@@ -295,38 +591,131 @@ void capturarDesdeArduino(ListaGestion& lista, ArduinoSimulador& arduino) {
     cout << "¿Cuántas lecturas desea capturar? ";
     cin >> numLecturas;
     cin.ignore(1000, '\n');
+
+    double frecuencia = 0.0;
+    if (modo == 1) {
+        cout << "Lecturas por segundo (ej: 10): ";
+        cin >> frecuencia;
+        cin.ignore(1000, '\n');
+        if (frecuencia <= 0.0) {
+            frecuencia = 10.0;
+        }
+    }
     
     cout << "\n📡 Capturando " << numLecturas << " lecturas desde Arduino...\n\n";
+
+    // Marca el paso con el reloj monotónico en lugar de una espera activa
+    RitmoCaptura ritmo(frecuencia);
+    ritmo.iniciar();
     
     for (int i = 0; i < numLecturas; i++) {
-        char buffer[100];
-        char tipo = nombre[0];  // Usa la primera letra del nombre como tipo
+        char tipo = sensor->obtenerTipo();  // Las tramas que entiende su clase
         
-        if (arduino.recibirPaquete(buffer, tipo)) {
-            // Extrae el valor del paquete (formato "TIPO:VALOR")
-            char* valorStr = strchr(buffer, ':');
-            if (valorStr != nullptr) {
-                valorStr++;  // Salta el ':'
-                sensor->registrarLecturaDesdeString(valorStr);
-            }
+        // La lectura llega ya convertida: sin formatear ni reinterpretar texto
+        LecturaTrama lectura;
+        if (arduino.recibirLectura(tipo, lectura)) {
+            sensor->registrarLecturaTrama(lectura);
+            ritmo.contarLectura();
         }
         
-        // Pequeña pausa para simular tiempo entre lecturas
-        for (volatile int j = 0; j < 10000000; j++);
+        if (i + 1 < numLecturas) {
+            ritmo.esperarSiguiente();
+        }
     }
+    ritmo.detener();
     
-    cout << "\n✓ Captura completada. " << numLecturas << " lecturas registradas.\n";
+    cout << "\n✓ Captura completada. " << ritmo.obtenerLecturas() << " lecturas registradas"
+         << " en " << ritmo.obtenerSegundos() << " s ("
+         << ritmo.obtenerLecturasPorSegundo() << " lecturas/s).\n";
+}
+
+/**
+ * @brief Captura con un hilo lector y un hilo de proceso
+ *
+ * Cada trama va al primer sensor de su tipo (temperatura o presión).
+ * Este hilo solo espera: no toca los sensores mientras los hilos corren.
+ */
+void capturarEnCanalizacion(ListaGestion& lista, ArduinoSimulador& arduino) {
+    unsigned long numLecturas;
+    cout << "¿Cuántas lecturas desea capturar? ";
+    cin >> numLecturas;
+    cin.ignore(1000, '\n');
+
+    double frecuencia;
+    cout << "Lecturas por segundo (0 = máximo rendimiento): ";
+    cin >> frecuencia;
+    cin.ignore(1000, '\n');
+
+    cout << "\n📡 Capturando " << numLecturas << " lecturas en segundo plano...\n\n";
+
+    CanalizacionCaptura canalizacion(lista, arduino);
+    RitmoCaptura reloj(0.0);
+    reloj.iniciar();
+    canalizacion.iniciar(frecuencia, numLecturas);
+    canalizacion.esperar();
+    reloj.detener();
+
+    EstadisticasCanalizacion e = canalizacion.obtenerEstadisticas();
+    double segundos = reloj.obtenerSegundos();
+    cout << "\n✓ Captura completada en " << segundos << " s ("
+         << (segundos > 0.0 ? e.procesadas / segundos : 0.0) << " lecturas/s).\n";
+    cout << "  Recibidas:            " << e.recibidas << "\n";
+    cout << "  Registradas:          " << e.procesadas << "\n";
+    cout << "  Sin sensor asociado:  " << e.sinDestino << "\n";
+    cout << "  Descartadas (cola):   " << e.descartadas << "\n";
+    cout << "  Profundidad máxima:   " << e.profundidadMaxima
+         << " de " << CanalizacionCaptura::CAPACIDAD_COLA << "\n";
+    cout << "  Latencia media:       " << e.latenciaMediaUs << " µs\n";
+    cout << "  Latencia máxima:      " << e.latenciaMaximaUs << " µs\n";
+}
+
+/**
+ * @brief Importa un archivo de tramas y muestra el rendimiento
+ * @param lista Lista de sensores destino
+ * @param ruta Archivo de captura ("T:25.40", "P:101", ...)
+ * @param hilos Hilos de análisis (0 = todos los núcleos)
+ * @return false si no se pudo leer el archivo
+ */
+bool importarCaptura(ListaGestion& lista, const char* ruta, int hilos) {
+    cout << "📂 Importando " << ruta << "...\n";
+
+    ImportadorCaptura importador(lista, hilos);
+    if (!importador.importar(ruta)) {
+        cout << "❌ No se pudo leer " << ruta << ".\n";
+        return false;
+    }
+
+    EstadisticasImportacion e = importador.obtenerEstadisticas();
+    cout << "\n✓ Importación completada en " << e.segundos << " s con "
+         << e.hilos << " hilos.\n";
+    cout << "  Bytes leídos:         " << e.bytes << "\n";
+    cout << "  Tramas válidas:       " << e.tramas << "\n";
+    cout << "  Registradas:          " << e.registradas << "\n";
+    cout << "  Sin sensor asociado:  " << e.sinDestino << "\n";
+    cout << "  Líneas ignoradas:     " << e.ignoradas << "\n";
+    cout << "  Líneas descartadas:   " << e.descartadas << "\n";
+    cout << "  Sensores creados:     " << e.sensoresCreados << "\n";
+    cout << "  Rendimiento:          " << e.tramasPorSegundo() << " lecturas/s, "
+         << e.megabytesPorSegundo() << " MB/s\n";
+    return true;
 }
 
 /**
  * @brief Limpia la pantalla de la consola
+ *
+ * Usa la secuencia ANSI de borrado en lugar de system("clear"/"cls"): no
+ * lanza un intérprete de órdenes por pantalla, y no escribe nada si la
+ * salida está redirigida a un archivo o a otro programa.
  */
 void limpiarPantalla() {
     #ifdef _WIN32
-        system("cls");
+        bool terminal = _isatty(_fileno(stdout)) != 0;
     #else
-        system("clear");
+        bool terminal = isatty(fileno(stdout)) != 0;
     #endif
+    if (terminal) {
+        cout << "\033[2J\033[H" << flush;
+    }
 }
 
 /**
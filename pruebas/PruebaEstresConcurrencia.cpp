@@ -0,0 +1,199 @@
+/**
+ * @file PruebaEstresConcurrencia.cpp
+ * @brief Prueba de estrés del modo concurrente de ListaGestion
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * Hace trabajar a la vez a todos los hilos que admite ListaGestion:
+ * - dos productores que registran lecturas (por lotes y de una en una),
+ * - un hilo que da de alta sensores y hace crecer el índice por nombre,
+ * - dos hilos de búsqueda (buscarSensor, buscarPorTipo, recorrerSensores),
+ * - un hilo que imprime todos los sensores,
+ * - un hilo que ejecuta procesarTodosSensoresParalelo().
+ *
+ * Se compila con -fsanitize=thread: ThreadSanitizer hace fallar la prueba
+ * (código de salida 66) si detecta una carrera. Además comprueba que no
+ * se pierden lecturas ni sensores. Devuelve 0 si todo pasa (ctest).
+ */
+
+#include "ListaGestion.h"
+#include "Log.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const int LECTURAS_POR_PRODUCTOR = 20000;  ///< Lecturas de cada productor
+const int LECTURAS_POR_LOTE = 100;         ///< Lecturas por registrarLote()
+const int SENSORES_NUEVOS = 300;           ///< Altas durante la prueba (el índice crece varias veces)
+const int HILOS_PROCESO = 2;               ///< Hilos de procesarTodosSensoresParalelo()
+const int VUELTAS_MINIMAS = 20;            ///< Vueltas de los hilos que repiten hasta el final
+
+int fallos = 0;
+
+/**
+ * @brief Informa de una comprobación y cuenta los fallos
+ */
+void comprobar(bool correcto, const char* descripcion) {
+    cerr << (correcto ? "✓ " : "✗ ") << descripcion << "\n";
+    if (!correcto) {
+        fallos++;
+    }
+}
+
+/**
+ * @brief Búfer que descarta todo lo escrito (el informe no interesa aquí)
+ */
+class BufferNulo : public streambuf {
+protected:
+    int overflow(int c) override {
+        return traits_type::not_eof(c);
+    }
+
+    streamsize xsputn(const char*, streamsize n) override {
+        return n;
+    }
+};
+
+/**
+ * @brief Nombre del i-ésimo sensor dado de alta durante la prueba
+ */
+void nombreNuevo(int i, char* nombre, size_t capacidad) {
+    snprintf(nombre, capacidad, "%c-%04d", i % 2 == 0 ? 'T' : 'P', 100 + i);
+}
+
+} // namespace
+
+int main() {
+    Log::establecerDestino(stderr);
+    Log::establecerNivel(Log::ERROR);
+
+    // Solo el hilo de impresión escribe en cout
+    BufferNulo nulo;
+    streambuf* salidaEstandar = cout.rdbuf(&nulo);
+
+    ListaGestion lista;
+    SensorTemperatura* temperatura = new SensorTemperatura("T-001");
+    SensorPresion* presion = new SensorPresion("P-001");
+    lista.insertarSensor(temperatura);
+    lista.insertarSensor(presion);
+
+    atomic<bool> terminado(false);
+    atomic<int> busquedasFallidas(0);
+    atomic<int> procesamientos(0);
+    atomic<int> impresiones(0);
+
+    // Productor 1: lotes de temperatura
+    thread productorLotes([temperatura]() {
+        float valores[LECTURAS_POR_LOTE];
+        for (int i = 0; i < LECTURAS_POR_PRODUCTOR; i += LECTURAS_POR_LOTE) {
+            for (int j = 0; j < LECTURAS_POR_LOTE; j++) {
+                valores[j] = 20.0f + static_cast<float>((i + j) % 100) / 10.0f;
+            }
+            temperatura->registrarLote(valores, LECTURAS_POR_LOTE);
+        }
+    });
+
+    // Productor 2: presión de una en una
+    thread productorUnitario([presion]() {
+        for (int i = 0; i < LECTURAS_POR_PRODUCTOR; i++) {
+            presion->registrarLectura(95 + i % 11);
+        }
+    });
+
+    // Altas mientras los demás buscan y recorren
+    thread registro([&lista]() {
+        char nombre[16];
+        for (int i = 0; i < SENSORES_NUEVOS; i++) {
+            nombreNuevo(i, nombre, sizeof(nombre));
+            lista.insertarSensor(SensorBase::crearDeTipo(nombre[0], nombre));
+            this_thread::yield();  // Repartir las altas a lo largo de la prueba
+        }
+    });
+
+    // Búsquedas: los sensores iniciales deben encontrarse siempre
+    auto buscar = [&lista, &terminado, &busquedasFallidas](int desplazamiento) {
+        char nombre[16];
+        int i = desplazamiento;
+        int vueltas = 0;
+        do {
+            if (lista.buscarSensor("T-001") == nullptr || lista.buscarSensor("P-001") == nullptr ||
+                lista.buscarPorTipo('T') == nullptr || lista.buscarPorTipo('P') == nullptr) {
+                busquedasFallidas++;
+            }
+            nombreNuevo(i % SENSORES_NUEVOS, nombre, sizeof(nombre));
+            SensorBase* nuevo = lista.buscarSensor(nombre);
+            if (nuevo != nullptr && nuevo->obtenerTipo() != nombre[0]) {
+                busquedasFallidas++;
+            }
+            int vistos = 0;
+            lista.recorrerSensores([&vistos](SensorBase*) { vistos++; });
+            if (vistos < 2) {
+                busquedasFallidas++;
+            }
+            i++;
+        } while (++vueltas < VUELTAS_MINIMAS * 100 || !terminado.load());
+    };
+    thread buscador1(buscar, 0);
+    thread buscador2(buscar, SENSORES_NUEVOS / 2);
+
+    thread impresora([&lista, &terminado, &impresiones]() {
+        do {
+            lista.imprimirTodosSensores();
+        } while (++impresiones < VUELTAS_MINIMAS || !terminado.load());
+    });
+
+    thread procesador([&lista, &terminado, &procesamientos]() {
+        BufferNulo descarte;
+        ostream informe(&descarte);
+        do {
+            lista.procesarTodosSensoresParalelo(HILOS_PROCESO, informe);
+        } while (++procesamientos < VUELTAS_MINIMAS || !terminado.load());
+    });
+
+    productorLotes.join();
+    productorUnitario.join();
+    registro.join();
+    terminado = true;
+    buscador1.join();
+    buscador2.join();
+    impresora.join();
+    procesador.join();
+
+    cout.rdbuf(salidaEstandar);
+
+    comprobar(temperatura->obtenerSecuencia() == static_cast<uint64_t>(LECTURAS_POR_PRODUCTOR),
+              "T-001 aceptó todas las lecturas de su productor");
+    comprobar(presion->obtenerSecuencia() == static_cast<uint64_t>(LECTURAS_POR_PRODUCTOR),
+              "P-001 aceptó todas las lecturas de su productor");
+    comprobar(lista.obtenerTamano() == 2 + SENSORES_NUEVOS,
+              "la lista contiene todos los sensores dados de alta");
+
+    int encontrados = 0;
+    char nombre[16];
+    for (int i = 0; i < SENSORES_NUEVOS; i++) {
+        nombreNuevo(i, nombre, sizeof(nombre));
+        SensorBase* sensor = lista.buscarSensor(nombre);
+        if (sensor != nullptr && sensor->obtenerTipo() == nombre[0]) {
+            encontrados++;
+        }
+    }
+    comprobar(encontrados == SENSORES_NUEVOS,
+              "buscarSensor() encuentra cada alta tras crecer el índice");
+    comprobar(busquedasFallidas.load() == 0,
+              "ninguna búsqueda concurrente perdió un sensor existente");
+    comprobar(impresiones.load() > 0 && procesamientos.load() > 0,
+              "la impresión y el procesamiento corrieron durante la prueba");
+
+    cerr << (fallos == 0 ? "✓ Todas las comprobaciones pasaron\n"
+                         : "✗ Hubo comprobaciones fallidas\n");
+    return fallos == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file PruebaKernelsLecturas.cpp
+ * @brief Prueba de los núcleos de KernelsLecturas en cada nivel de la CPU
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * Ejecuta minimo(), maximo() e indiceMinimo() con cada nivel que admite
+ * la máquina (limitarNivel) y compara el resultado con un bucle de
+ * referencia. Los arreglos incluyen NaN en cualquier carril, infinitos y
+ * longitudes que dejan cola escalar. Devuelve 0 si todo pasa (ctest).
+ */
+
+#include "HistorialCircular.h"
+#include "KernelsLecturas.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const int LONGITUD_MAXIMA = 70;  ///< Cubre varios vectores AVX2 y todas las colas
+const int REPETICIONES = 40;     ///< Arreglos aleatorios por longitud
+
+int fallos = 0;
+
+/**
+ * @brief Informa de una comprobación y cuenta los fallos
+ */
+void comprobar(bool correcto, const char* descripcion) {
+    cerr << (correcto ? "✓ " : "✗ ") << descripcion << "\n";
+    if (!correcto) {
+        fallos++;
+    }
+}
+
+/**
+ * @brief Generador xorshift: los mismos arreglos en cada ejecución
+ */
+uint32_t siguiente(uint32_t& estado) {
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+/**
+ * @brief Posición del menor valor que no es NaN (-1 si todos lo son)
+ */
+int indiceReferencia(const float* d, int n) {
+    int indice = -1;
+    for (int i = 0; i < n; i++) {
+        if (!std::isnan(d[i]) && (indice < 0 || d[i] < d[indice])) {
+            indice = i;
+        }
+    }
+    return indice;
+}
+
+/**
+ * @brief Mayor valor que no es NaN (NaN si todos lo son)
+ */
+float maximoReferencia(const float* d, int n) {
+    float mayor = numeric_limits<float>::quiet_NaN();
+    for (int i = 0; i < n; i++) {
+        if (!std::isnan(d[i]) && (std::isnan(mayor) || mayor < d[i])) {
+            mayor = d[i];
+        }
+    }
+    return mayor;
+}
+
+bool mismoReal(float a, float b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+/**
+ * @brief Compara los núcleos de float con la referencia en un arreglo
+ */
+bool coincideReal(const float* d, int n) {
+    int esperado = indiceReferencia(d, n);
+    int indice = KernelsLecturas::indiceMinimo(d, n);
+    if (indice < 0 || indice >= n) {
+        return false;
+    }
+    if (esperado < 0) {
+        // Todo NaN: cualquier posición válida, y el mínimo es NaN
+        return std::isnan(KernelsLecturas::minimo(d, n)) && std::isnan(KernelsLecturas::maximo(d, n));
+    }
+    return indice == esperado && KernelsLecturas::minimo(d, n) == d[esperado] &&
+           mismoReal(KernelsLecturas::maximo(d, n), maximoReferencia(d, n));
+}
+
+/**
+ * @brief Compara los núcleos de int con la referencia en un arreglo
+ */
+bool coincideEntero(const int* d, int n) {
+    int indice = 0;
+    int mayor = d[0];
+    for (int i = 1; i < n; i++) {
+        if (d[i] < d[indice]) {
+            indice = i;
+        }
+        if (mayor < d[i]) {
+            mayor = d[i];
+        }
+    }
+    return KernelsLecturas::indiceMinimo(d, n) == indice &&
+           KernelsLecturas::minimo(d, n) == d[indice] && KernelsLecturas::maximo(d, n) == mayor;
+}
+
+/**
+ * @brief Pasa todos los casos con el nivel activo
+ * @return Arreglos en los que algún núcleo no coincide
+ */
+int probarNivelActivo() {
+    const float nan = numeric_limits<float>::quiet_NaN();
+    const float infinito = numeric_limits<float>::infinity();
+    int distintos = 0;
+
+    // El caso de la revisión: el NaN del segundo vector tapaba el 1.0 del primero
+    float revision[24];
+    for (int i = 0; i < 24; i++) {
+        revision[i] = 50.0f + static_cast<float>(i);
+    }
+    revision[0] = 1.0f;
+    revision[8] = nan;
+    if (KernelsLecturas::indiceMinimo(revision, 24) != 0 || !coincideReal(revision, 24)) {
+        distintos++;
+    }
+
+    float reales[LONGITUD_MAXIMA];
+    int enteros[LONGITUD_MAXIMA];
+    uint32_t estado = 2463534242u;
+    for (int n = 1; n <= LONGITUD_MAXIMA; n++) {
+        for (int r = 0; r < REPETICIONES; r++) {
+            // Cada repetición usa otra proporción de NaN: ninguno, algunos o todos
+            uint32_t proporcionNan = static_cast<uint32_t>(r % 5) * 25;
+            for (int i = 0; i < n; i++) {
+                uint32_t azar = siguiente(estado);
+                int valor = static_cast<int>(azar % 2001) - 1000;
+                enteros[i] = valor;
+                if (azar % 100 < proporcionNan) {
+                    reales[i] = nan;
+                } else if (azar % 97 == 0) {
+                    reales[i] = (azar & 1u) ? infinito : -infinito;
+                } else {
+                    reales[i] = static_cast<float>(valor) + 0.25f;  // Sin ceros con signo
+                }
+            }
+            if (!coincideReal(reales, n)) {
+                distintos++;
+            }
+            if (!coincideEntero(enteros, n)) {
+                distintos++;
+            }
+        }
+    }
+    return distintos;
+}
+
+} // namespace
+
+int main() {
+    KernelsLecturas::Nivel disponible = KernelsLecturas::nivelDisponible();
+    const KernelsLecturas::Nivel niveles[] = {
+        KernelsLecturas::ESCALAR, KernelsLecturas::SSE41, KernelsLecturas::AVX2
+    };
+
+    for (KernelsLecturas::Nivel nivel : niveles) {
+        if (nivel > disponible) {
+            cerr << "- " << KernelsLecturas::nombreNivel(nivel) << ": no disponible en esta CPU\n";
+            continue;
+        }
+        KernelsLecturas::limitarNivel(nivel);
+        string descripcion = string(KernelsLecturas::nombreNivel(KernelsLecturas::nivelActivo())) +
+                             ": minimo, maximo e indiceMinimo coinciden con la referencia (con NaN)";
+        comprobar(KernelsLecturas::nivelActivo() == nivel && probarNivelActivo() == 0,
+                  descripcion.c_str());
+
+        // eliminarMinimo() se apoya en indiceMinimo(): debe quitar la lectura correcta
+        HistorialCircular<float> historial(32);
+        const float valores[] = { numeric_limits<float>::quiet_NaN(), 3.0f, 1.0f, 2.0f, 5.0f };
+        for (float valor : valores) {
+            historial.insertarAlFinal(valor, 0);
+        }
+        comprobar(historial.eliminarMinimo() == 1.0f && historial.obtenerTamano() == 4,
+                  "HistorialCircular::eliminarMinimo() quita 1.0 y no el NaN");
+    }
+    KernelsLecturas::limitarNivel(disponible);
+
+    cerr << (fallos == 0 ? "✓ Todas las comprobaciones pasaron\n"
+                         : "✗ Hubo comprobaciones fallidas\n");
+    return fallos == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file PruebaPuertoSerial.cpp
+ * @brief Prueba del modo real de ArduinoSimulador sobre un pseudo-terminal
+ * @author Sistema IoT
+ * @date 2025
+ *
+ * Crea un par maestro/esclavo con openpty(), conecta ArduinoSimulador al
+ * esclavo (ptsname) y escribe en el maestro lo mismo que enviaría
+ * arduino_sensor_example.ino: encabezado, respuestas "OK:"/"ERROR:" y
+ * tramas, una de ellas partida en dos escrituras. Devuelve 0 si todas
+ * las comprobaciones pasan (se ejecuta con ctest).
+ */
+
+#include "ArduinoSimulador.h"
+#include "Log.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+int fallos = 0;
+
+/**
+ * @brief Informa de una comprobación y cuenta los fallos
+ */
+void comprobar(bool correcto, const char* descripcion) {
+    cerr << (correcto ? "✓ " : "✗ ") << descripcion << "\n";
+    if (!correcto) {
+        fallos++;
+    }
+}
+
+/**
+ * @brief Escribe un texto completo en el maestro, como lo haría el sketch
+ */
+void enviar(int maestro, const char* texto) {
+    size_t longitud = strlen(texto);
+    while (longitud > 0) {
+        ssize_t escritos = write(maestro, texto, longitud);
+        if (escritos <= 0) {
+            cerr << "✗ No se pudo escribir en el pseudo-terminal\n";
+            exit(1);
+        }
+        texto += escritos;
+        longitud -= static_cast<size_t>(escritos);
+    }
+}
+
+} // namespace
+
+int main() {
+    Log::establecerDestino(stderr);
+    Log::establecerNivel(Log::AVISO);
+
+    int maestro = -1;
+    int esclavo = -1;
+    if (openpty(&maestro, &esclavo, nullptr, nullptr, nullptr) != 0) {
+        perror("openpty");
+        return 1;
+    }
+    // El esclavo sigue abierto aquí para que el maestro no vea un cuelgue
+    // entre la apertura del par y la de ArduinoSimulador
+    const char* ruta = ptsname(maestro);
+    if (ruta == nullptr) {
+        perror("ptsname");
+        return 1;
+    }
+    char rutaEsclavo[64];
+    snprintf(rutaEsclavo, sizeof(rutaEsclavo), "%s", ruta);
+
+    ArduinoSimulador arduino;
+
+    comprobar(!arduino.conectar(rutaEsclavo, 12345) && !arduino.estaConectado(),
+              "conectar() rechaza una velocidad no soportada");
+    comprobar(arduino.conectar(rutaEsclavo, 115200) && arduino.esModoReal(),
+              "conectar() abre el esclavo del pseudo-terminal en modo real");
+
+    // Encabezado del sketch y respuestas a comandos: no son tramas
+    enviar(maestro, "Arduino Sensor IoT - Inicializado\r\n"
+                    "Formato de paquetes: TIPO:VALOR\r\n"
+                    "========================================\r\n"
+                    "OK:Sistema funcionando correctamente\r\n"
+                    "ERROR:Comando no reconocido\r\n"
+                    "T:25.40\r\n"
+                    "P:101\r\n");
+
+    char paquete[ArduinoSimulador::TAMANO_PAQUETE];
+    comprobar(arduino.recibirPaquete(paquete, 'T') && strcmp(paquete, "T:25.40") == 0,
+              "recibirPaquete('T') salta encabezado, OK: y ERROR: y entrega T:25.40");
+    comprobar(arduino.leerPresion() == 101, "leerPresion() entrega 101");
+
+    // Una trama partida en dos escrituras, con una pausa entre ellas
+    enviar(maestro, "T:2");
+    usleep(50000);
+    comprobar(!arduino.hayDatosDisponibles(),
+              "media trama no cuenta como dato disponible");
+    enviar(maestro, "1.75\r\n");
+    comprobar(arduino.leerTemperatura() == 21.75f,
+              "leerTemperatura() une la trama partida: 21.75");
+
+    // Las tramas de otro tipo se saltan al pedir uno concreto
+    enviar(maestro, "V:42\r\nP:99\r\nT:30.50\r\n");
+    comprobar(arduino.leerTemperatura() == 30.5f,
+              "leerTemperatura() salta V:42 y P:99 y entrega 30.50");
+
+    // Sin datos, la espera termina sin lectura y sin desconectar
+    comprobar(!arduino.hayDatosDisponibles() && arduino.estaConectado(),
+              "sin tramas no hay datos disponibles y la conexión sigue");
+
+    // Si el otro extremo se cierra, el simulador se da por desconectado
+    close(maestro);
+    LecturaTrama lectura;
+    comprobar(!arduino.recibirLectura('T', lectura) && !arduino.estaConectado(),
+              "al cerrarse el maestro, recibirLectura() falla y desconecta");
+
+    close(esclavo);
+
+    cerr << (fallos == 0 ? "✓ Todas las comprobaciones pasaron\n"
+                         : "✗ Hubo comprobaciones fallidas\n");
+    return fallos == 0 ? 0 : 1;
+}